@@ -30,6 +30,14 @@
 #include "Common/FileUtil.h"
 #endif
 
+#if defined(HAVE_IO_URING)
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "Common/IOUring.h"
+#endif
+
 #include "Common/Assert.h"
 
 namespace File
@@ -363,4 +371,50 @@ bool Delete(DirectIOFile& file, const std::string& filename)
 #endif
 }
 
+#if defined(HAVE_IO_URING)
+static Common::IOUring* GetThreadIOUring()
+{
+  // Enough to keep the storage busy without locking much memory for every thread.
+  constexpr u32 IO_URING_QUEUE_DEPTH = 64;
+
+  // If io_uring can't be set up, e.g. because a container has it disabled, it won't work on any
+  // other thread either.
+  static std::atomic<bool> s_unavailable = false;
+
+  // An io_uring instance can't be used by several threads at once.
+  thread_local std::unique_ptr<Common::IOUring> ring;
+  if (!ring && !s_unavailable.load(std::memory_order_relaxed))
+  {
+    ring = Common::IOUring::Create(IO_URING_QUEUE_DEPTH);
+    if (!ring)
+      s_unavailable.store(true, std::memory_order_relaxed);
+  }
+  return ring.get();
+}
+#endif
+
+bool OffsetReadBatch(std::span<const BatchRead> reads)
+{
+#if defined(HAVE_IO_URING)
+  if (reads.size() > 1)
+  {
+    if (Common::IOUring* ring = GetThreadIOUring())
+    {
+      std::vector<Common::IOUring::Read> ring_reads;
+      ring_reads.reserve(reads.size());
+      for (const BatchRead& read : reads)
+        ring_reads.push_back({read.file->GetHandle(), read.offset, read.out_ptr, read.size});
+      return ring->ReadAll(ring_reads);
+    }
+  }
+#endif
+
+  for (const BatchRead& read : reads)
+  {
+    if (!read.file->OffsetRead(read.offset, read.out_ptr, read.size))
+      return false;
+  }
+  return true;
+}
+
 }  // namespace File
@@ -147,4 +147,18 @@ bool Rename(DirectIOFile& file, const std::string& source_path,
 // Note: Ditto, only Windows actually uses the file handle. Provide both.
 bool Delete(DirectIOFile& file, const std::string& filename);
 
+struct BatchRead
+{
+  DirectIOFile* file;
+  u64 offset;
+  u8* out_ptr;
+  u64 size;
+};
+
+// Performs all the reads like OffsetRead does. Where io_uring is available, they are issued all at
+// once, which lets storage with a high latency (network shares, USB drives) work on several of
+// them at the same time. Elsewhere they happen one after another.
+// Returns false if any of the reads failed.
+bool OffsetReadBatch(std::span<const BatchRead> reads);
+
 }  // namespace File
@@ -0,0 +1,266 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/IOUring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "Common/CommonFuncs.h"
+#include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
+
+// Older C libraries don't know about these yet. The numbers are the same on all architectures.
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+
+namespace Common
+{
+static int IOUringSetup(u32 entries, io_uring_params* params)
+{
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int IOUringEnter(int fd, u32 to_submit, u32 min_complete, u32 flags)
+{
+  return static_cast<int>(
+      syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+template <typename T>
+static T* RingPointer(void* ring, u32 offset)
+{
+  return reinterpret_cast<T*>(static_cast<u8*>(ring) + offset);
+}
+
+std::unique_ptr<IOUring> IOUring::Create(u32 queue_depth)
+{
+  std::unique_ptr<IOUring> ring(new IOUring);
+  if (!ring->Initialize(queue_depth))
+    return nullptr;
+  return ring;
+}
+
+bool IOUring::Initialize(u32 queue_depth)
+{
+  io_uring_params params{};
+  m_fd = IOUringSetup(queue_depth, &params);
+  if (m_fd < 0)
+  {
+    INFO_LOG_FMT(COMMON, "io_uring_setup: {}", LastStrerrorString());
+    return false;
+  }
+
+  m_sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+  m_cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+  // Since Linux 5.4, both rings can be mapped together.
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap)
+    m_sq_ring_size = m_cq_ring_size = std::max(m_sq_ring_size, m_cq_ring_size);
+
+  m_sq_ring = mmap(nullptr, m_sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                   m_fd, IORING_OFF_SQ_RING);
+  if (m_sq_ring == MAP_FAILED)
+  {
+    m_sq_ring = nullptr;
+    return false;
+  }
+
+  if (single_mmap)
+  {
+    m_cq_ring = m_sq_ring;
+  }
+  else
+  {
+    m_cq_ring = mmap(nullptr, m_cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     m_fd, IORING_OFF_CQ_RING);
+    if (m_cq_ring == MAP_FAILED)
+    {
+      m_cq_ring = nullptr;
+      return false;
+    }
+  }
+
+  m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+  m_sqes = mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+                IORING_OFF_SQES);
+  if (m_sqes == MAP_FAILED)
+  {
+    m_sqes = nullptr;
+    return false;
+  }
+
+  m_sq_entries = params.sq_entries;
+  m_sq_tail = RingPointer<u32>(m_sq_ring, params.sq_off.tail);
+  m_sq_mask = *RingPointer<u32>(m_sq_ring, params.sq_off.ring_mask);
+  m_sq_array = RingPointer<u32>(m_sq_ring, params.sq_off.array);
+
+  m_cq_head = RingPointer<u32>(m_cq_ring, params.cq_off.head);
+  m_cq_tail = RingPointer<u32>(m_cq_ring, params.cq_off.tail);
+  m_cq_mask = *RingPointer<u32>(m_cq_ring, params.cq_off.ring_mask);
+  m_cqes = RingPointer<void>(m_cq_ring, params.cq_off.cqes);
+
+  return true;
+}
+
+IOUring::~IOUring()
+{
+  if (m_sqes)
+    munmap(m_sqes, m_sqes_size);
+  if (m_cq_ring && m_cq_ring != m_sq_ring)
+    munmap(m_cq_ring, m_cq_ring_size);
+  if (m_sq_ring)
+    munmap(m_sq_ring, m_sq_ring_size);
+  if (m_fd >= 0)
+    close(m_fd);
+}
+
+bool IOUring::Submit(u32 to_submit, u32 min_complete)
+{
+  while (to_submit != 0 || min_complete != 0)
+  {
+    const int result = IOUringEnter(m_fd, to_submit, min_complete, IORING_ENTER_GETEVENTS);
+    if (result < 0)
+    {
+      if (errno == EINTR)
+        continue;
+
+      ERROR_LOG_FMT(COMMON, "io_uring_enter: {}", LastStrerrorString());
+      return false;
+    }
+
+    to_submit -= std::min<u32>(to_submit, result);
+    // Waiting only happens after everything has been submitted.
+    if (to_submit == 0)
+      break;
+  }
+  return true;
+}
+
+bool IOUring::ReadAll(std::span<const Read> reads)
+{
+  struct State
+  {
+    int fd;
+    u64 offset;
+    u8* out_ptr;
+    u64 remaining;
+    iovec iov;
+  };
+
+  std::vector<State> states;
+  states.reserve(reads.size());
+  for (const Read& read : reads)
+    states.push_back({read.fd, read.offset, read.out_ptr, read.size, {}});
+
+  // Reads which were interrupted or only partially done get queued again.
+  std::vector<size_t> retries;
+  size_t next_read = 0;
+  u32 in_flight = 0;
+  bool success = true;
+
+  auto* const sqes = static_cast<io_uring_sqe*>(m_sqes);
+  auto* const cqes = static_cast<io_uring_cqe*>(m_cqes);
+
+  while (true)
+  {
+    u32 queued = 0;
+    u32 sq_tail = *m_sq_tail;
+    while (success && in_flight + queued < m_sq_entries &&
+           (!retries.empty() || next_read < states.size()))
+    {
+      size_t index;
+      if (!retries.empty())
+      {
+        index = retries.back();
+        retries.pop_back();
+      }
+      else
+      {
+        index = next_read++;
+      }
+
+      State& state = states[index];
+      if (state.remaining == 0)
+        continue;
+      state.iov.iov_base = state.out_ptr;
+      state.iov.iov_len = state.remaining;
+
+      // IORING_OP_READV is used rather than IORING_OP_READ since it works on every kernel that
+      // has io_uring at all.
+      const u32 sqe_index = sq_tail & m_sq_mask;
+      io_uring_sqe& sqe = sqes[sqe_index];
+      std::memset(&sqe, 0, sizeof(sqe));
+      sqe.opcode = IORING_OP_READV;
+      sqe.fd = state.fd;
+      sqe.off = state.offset;
+      sqe.addr = reinterpret_cast<u64>(&state.iov);
+      sqe.len = 1;
+      sqe.user_data = index;
+      m_sq_array[sqe_index] = sqe_index;
+
+      ++sq_tail;
+      ++queued;
+    }
+
+    if (in_flight + queued == 0)
+      break;
+
+    std::atomic_ref(*m_sq_tail).store(sq_tail, std::memory_order_release);
+    if (!Submit(queued, 1))
+    {
+      // Reads that are still in flight would write into buffers that the caller is about to
+      // free, and there is no way to wait for them, so there is nothing better to do than this.
+      PanicAlertFmt("Lost track of io_uring reads");
+      return false;
+    }
+    in_flight += queued;
+
+    u32 cq_head = *m_cq_head;
+    const u32 cq_tail = std::atomic_ref(*m_cq_tail).load(std::memory_order_acquire);
+    for (; cq_head != cq_tail; ++cq_head)
+    {
+      const io_uring_cqe& cqe = cqes[cq_head & m_cq_mask];
+      State& state = states[cqe.user_data];
+      --in_flight;
+
+      if (cqe.res == -EINTR || cqe.res == -EAGAIN)
+      {
+        retries.push_back(cqe.user_data);
+      }
+      else if (cqe.res <= 0)
+      {
+        // Zero means that the end of the file was reached.
+        if (cqe.res < 0)
+          ERROR_LOG_FMT(COMMON, "io_uring read: {}", StrerrorString(-cqe.res));
+        success = false;
+      }
+      else
+      {
+        state.offset += cqe.res;
+        state.out_ptr += cqe.res;
+        state.remaining -= cqe.res;
+        if (state.remaining != 0)
+          retries.push_back(cqe.user_data);
+      }
+    }
+    std::atomic_ref(*m_cq_head).store(cq_head, std::memory_order_release);
+  }
+
+  return success;
+}
+}  // namespace Common
@@ -0,0 +1,67 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <span>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// A minimal io_uring instance for reading from files, using the system calls directly so that
+// liburing isn't needed. Only one thread may use an instance at a time.
+class IOUring final
+{
+public:
+  struct Read
+  {
+    int fd;
+    u64 offset;
+    u8* out_ptr;
+    u64 size;
+  };
+
+  // Returns nullptr if io_uring can't be used, e.g. because the kernel is too old or because
+  // io_uring has been disabled.
+  static std::unique_ptr<IOUring> Create(u32 queue_depth);
+
+  IOUring(const IOUring&) = delete;
+  IOUring(IOUring&&) = delete;
+  IOUring& operator=(const IOUring&) = delete;
+  IOUring& operator=(IOUring&&) = delete;
+  ~IOUring();
+
+  u32 GetQueueDepth() const { return m_sq_entries; }
+
+  // Performs all the reads, keeping up to the queue depth of them in flight at once. Returns false
+  // if any of them failed, including by reaching the end of the file.
+  bool ReadAll(std::span<const Read> reads);
+
+private:
+  IOUring() = default;
+
+  bool Initialize(u32 queue_depth);
+  bool Submit(u32 to_submit, u32 min_complete);
+
+  int m_fd = -1;
+
+  void* m_sq_ring = nullptr;
+  size_t m_sq_ring_size = 0;
+  void* m_cq_ring = nullptr;
+  size_t m_cq_ring_size = 0;
+  void* m_sqes = nullptr;
+  size_t m_sqes_size = 0;
+
+  u32 m_sq_entries = 0;
+  u32* m_sq_tail = nullptr;
+  u32 m_sq_mask = 0;
+  u32* m_sq_array = nullptr;
+
+  u32* m_cq_head = nullptr;
+  u32* m_cq_tail = nullptr;
+  u32 m_cq_mask = 0;
+  void* m_cqes = nullptr;
+};
+}  // namespace Common
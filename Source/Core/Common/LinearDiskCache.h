@@ -34,10 +34,17 @@ class LinearDiskCacheReader
 {
 public:
   virtual void Read(const K& key, const V* value, u32 value_size) = 0;
+
+  // Like Read, but also gets the offset of the value in the file, which can be passed to
+  // LinearDiskCache::ReadValue to read it again later on.
+  virtual void ReadAt(const K& key, const V* value, u32 value_size, u64 value_offset)
+  {
+    Read(key, value, value_size);
+  }
 };
 
 // Dead simple unsorted key-value store with append functionality.
-// No random read functionality, all reading is done in OpenAndRead.
+// Entries are read in OpenAndRead, after which single values can be read again by their offset.
 // Keys and values can contain any characters, including \0.
 //
 // Suitable for caching generated shader bytecode between executions.
@@ -88,11 +95,14 @@ public:
         value = std::make_unique_for_overwrite<V[]>(value_size);
 
         // read key/value and pass to reader
-        if (m_file.ReadArray(&key, 1) && m_file.ReadArray(value.get(), value_size) &&
-            m_file.ReadArray(&entry_number, 1) && entry_number == m_num_entries + 1)
+        if (!m_file.ReadArray(&key, 1))
+          break;
+        const u64 value_offset = m_file.Tell();
+        if (m_file.ReadArray(value.get(), value_size) && m_file.ReadArray(&entry_number, 1) &&
+            entry_number == m_num_entries + 1)
         {
           last_valid_value_start = m_file.Tell();
-          reader.Read(key, value.get(), value_size);
+          reader.ReadAt(key, value.get(), value_size, value_offset);
         }
         else
         {
@@ -115,6 +125,18 @@ public:
     return 0;
   }
 
+  // Reads a value at an offset that was passed to LinearDiskCacheReader::ReadAt. Appending
+  // continues at the end of the file afterwards.
+  bool ReadValue(u64 value_offset, V* value, u32 value_size)
+  {
+    const u64 append_offset = m_file.Tell();
+    const bool success = m_file.Seek(static_cast<s64>(value_offset), File::SeekOrigin::Begin) &&
+                         m_file.ReadArray(value, value_size);
+    m_file.ClearError();
+    m_file.Seek(static_cast<s64>(append_offset), File::SeekOrigin::Begin);
+    return success;
+  }
+
   void Sync() { m_file.Flush(); }
   void Close()
   {
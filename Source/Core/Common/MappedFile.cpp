@@ -0,0 +1,147 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "Common/CommonFuncs.h"
+#include "Common/DirectIOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace File
+{
+static u64 GetPageSize()
+{
+#if defined(_WIN32)
+  static const u64 page_size = [] {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return u64(info.dwPageSize);
+  }();
+#else
+  static const u64 page_size = u64(sysconf(_SC_PAGESIZE));
+#endif
+  return page_size;
+}
+
+MappedFile::MappedFile() = default;
+
+MappedFile::~MappedFile()
+{
+  Unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other)
+{
+  Swap(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other)
+{
+  Unmap();
+  Swap(other);
+  return *this;
+}
+
+void MappedFile::Swap(MappedFile& other)
+{
+  std::swap(m_data, other.m_data);
+  std::swap(m_size, other.m_size);
+}
+
+bool MappedFile::Map(const DirectIOFile& file)
+{
+  Unmap();
+
+  const u64 size = file.GetSize();
+  if (size == 0 || size > std::numeric_limits<size_t>::max())
+    return false;
+
+#if defined(_WIN32)
+  const HANDLE mapping =
+      CreateFileMappingW(file.GetHandle(), nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr)
+  {
+    WARN_LOG_FMT(COMMON, "CreateFileMapping: {}", Common::GetLastErrorString());
+    return false;
+  }
+
+  // The view keeps the mapping object alive by itself.
+  void* const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (data == nullptr)
+  {
+    WARN_LOG_FMT(COMMON, "MapViewOfFile: {}", Common::GetLastErrorString());
+    return false;
+  }
+#else
+  void* const data = mmap(nullptr, size, PROT_READ, MAP_SHARED, file.GetHandle(), 0);
+  if (data == MAP_FAILED)
+  {
+    WARN_LOG_FMT(COMMON, "mmap: {}", Common::LastStrerrorString());
+    return false;
+  }
+#endif
+
+  m_data = static_cast<const u8*>(data);
+  m_size = size;
+  return true;
+}
+
+void MappedFile::Unmap()
+{
+  if (!IsMapped())
+    return;
+
+#if defined(_WIN32)
+  UnmapViewOfFile(m_data);
+#else
+  munmap(const_cast<u8*>(m_data), m_size);
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+
+void MappedFile::WillNeed(u64 offset, u64 size) const
+{
+  if (offset >= m_size)
+    return;
+  size = std::min(size, m_size - offset);
+
+  // madvise requires the address to be aligned to a page.
+  const u64 start = offset - offset % GetPageSize();
+  const u64 length = offset + size - start;
+
+#if defined(_WIN32)
+  WIN32_MEMORY_RANGE_ENTRY range{const_cast<u8*>(m_data + start), static_cast<SIZE_T>(length)};
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+  madvise(const_cast<u8*>(m_data + start), length, MADV_WILLNEED);
+#endif
+}
+
+void MappedFile::Prefault(u64 offset, u64 size) const
+{
+  if (offset >= m_size)
+    return;
+  const u64 end = offset + std::min(size, m_size - offset);
+
+  const u64 page_size = GetPageSize();
+  u8 sum = 0;
+  for (u64 position = offset - offset % page_size; position < end; position += page_size)
+    sum += *static_cast<const volatile u8*>(m_data + position);
+  (void)sum;
+}
+
+}  // namespace File
@@ -0,0 +1,52 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+class DirectIOFile;
+
+// A read-only mapping of a whole file into the address space of the process.
+//
+// Reading from the mapping crashes the process if the file gets truncated by someone else or the
+// storage it is on goes away, so this is only suitable for files which are expected to stay
+// untouched while they are mapped.
+class MappedFile final
+{
+public:
+  MappedFile();
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&&);
+  MappedFile& operator=(MappedFile&&);
+
+  // The mapping stays valid after the file has been closed.
+  bool Map(const DirectIOFile& file);
+  void Unmap();
+
+  bool IsMapped() const { return m_data != nullptr; }
+  u64 GetSize() const { return m_size; }
+  std::span<const u8> GetSpan() const { return {m_data, static_cast<size_t>(m_size)}; }
+
+  // Starts reading the given range into memory in the background. This is only a hint to the OS.
+  void WillNeed(u64 offset, u64 size) const;
+
+  // Reads the given range into memory if it isn't already, so that accessing it afterwards
+  // doesn't stall. Like any other access, this crashes if the file has shrunk.
+  void Prefault(u64 offset, u64 size) const;
+
+private:
+  void Swap(MappedFile& other);
+
+  const u8* m_data = nullptr;
+  u64 m_size = 0;
+};
+
+}  // namespace File
@@ -0,0 +1,252 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/ThreadPool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+static thread_local const ThreadPool* s_current_pool = nullptr;
+static thread_local u32 s_current_worker_index = 0;
+
+ThreadPool::ThreadPool(std::string name, u32 thread_count)
+{
+  thread_count = std::max(thread_count, 1u);
+
+  m_workers.reserve(thread_count);
+  for (u32 i = 0; i < thread_count; ++i)
+    m_workers.emplace_back(std::make_unique<Worker>());
+
+  for (u32 i = 0; i < thread_count; ++i)
+  {
+    m_workers[i]->thread = std::thread([this, i, thread_name = fmt::format("{} {}", name, i)] {
+      SetCurrentThreadName(thread_name.c_str());
+      WorkerLoop(i);
+    });
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard lk(m_sleep_lock);
+    m_shutting_down = true;
+  }
+  m_sleep_cv.notify_all();
+
+  for (const std::unique_ptr<Worker>& worker : m_workers)
+    worker->thread.join();
+}
+
+ThreadPool& ThreadPool::GetShared()
+{
+  static ThreadPool pool("Pool Worker", std::thread::hardware_concurrency());
+  return pool;
+}
+
+void ThreadPool::Submit(std::function<void()> function)
+{
+  // Workers put tasks on their own queue, where they are likely to be picked up by the same
+  // worker while the data they use is still in its cache. Other threads spread them out.
+  const u32 index = s_current_pool == this ?
+                        s_current_worker_index :
+                        m_next_worker.fetch_add(1, std::memory_order_relaxed) % GetThreadCount();
+
+  {
+    Worker& worker = *m_workers[index];
+    std::lock_guard lk(worker.lock);
+    worker.tasks.push_back({std::move(function), Clock::now()});
+  }
+  m_queued_tasks.fetch_add(1);
+
+  {
+    // Prevents the notification from getting lost between a worker checking m_queued_tasks and
+    // starting to wait.
+    std::lock_guard lk(m_sleep_lock);
+  }
+  m_sleep_cv.notify_one();
+}
+
+bool ThreadPool::RunPendingTask()
+{
+  return TryRunTask(s_current_pool == this ? s_current_worker_index : GetThreadCount());
+}
+
+bool ThreadPool::TryRunTask(u32 own_index)
+{
+  const u32 thread_count = GetThreadCount();
+  const bool is_worker = own_index < thread_count;
+
+  Task task;
+  bool found = false;
+  bool stolen = false;
+
+  // The newest task of our own queue is the one most likely to have its data in our cache.
+  if (is_worker)
+  {
+    Worker& worker = *m_workers[own_index];
+    std::lock_guard lk(worker.lock);
+    if (!worker.tasks.empty())
+    {
+      task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+      found = true;
+    }
+  }
+
+  // Otherwise take the oldest task of another queue.
+  const u32 first_index =
+      is_worker ? own_index + 1 : m_next_worker.load(std::memory_order_relaxed);
+  for (u32 i = 0; !found && i < thread_count; ++i)
+  {
+    const u32 index = (first_index + i) % thread_count;
+    if (index == own_index)
+      continue;
+
+    Worker& worker = *m_workers[index];
+    std::lock_guard lk(worker.lock);
+    if (!worker.tasks.empty())
+    {
+      task = std::move(worker.tasks.front());
+      worker.tasks.pop_front();
+      found = true;
+      stolen = is_worker;
+    }
+  }
+
+  if (!found)
+    return false;
+
+  m_queued_tasks.fetch_sub(1);
+
+  const TimePoint start_time = Clock::now();
+  const DT::rep queue_latency = (start_time - task.submit_time).count();
+  m_total_queue_latency.fetch_add(queue_latency, std::memory_order_relaxed);
+  DT::rep max_queue_latency = m_max_queue_latency.load(std::memory_order_relaxed);
+  while (queue_latency > max_queue_latency &&
+         !m_max_queue_latency.compare_exchange_weak(max_queue_latency, queue_latency,
+                                                    std::memory_order_relaxed))
+  {
+  }
+
+  task.function();
+
+  m_total_run_time.fetch_add((Clock::now() - start_time).count(), std::memory_order_relaxed);
+  m_tasks_completed.fetch_add(1, std::memory_order_relaxed);
+  if (stolen)
+    m_tasks_stolen.fetch_add(1, std::memory_order_relaxed);
+
+  return true;
+}
+
+void ThreadPool::WorkerLoop(u32 index)
+{
+  s_current_pool = this;
+  s_current_worker_index = index;
+
+  while (true)
+  {
+    if (TryRunTask(index))
+      continue;
+
+    std::unique_lock lk(m_sleep_lock);
+    m_sleep_cv.wait(lk, [this] { return m_queued_tasks.load() != 0 || m_shutting_down; });
+    if (m_shutting_down && m_queued_tasks.load() == 0)
+      return;
+  }
+}
+
+ThreadPool::Stats ThreadPool::GetStats() const
+{
+  Stats stats;
+  stats.tasks_completed = m_tasks_completed.load(std::memory_order_relaxed);
+  stats.tasks_stolen = m_tasks_stolen.load(std::memory_order_relaxed);
+  stats.total_queue_latency = DT(m_total_queue_latency.load(std::memory_order_relaxed));
+  stats.max_queue_latency = DT(m_max_queue_latency.load(std::memory_order_relaxed));
+  stats.total_run_time = DT(m_total_run_time.load(std::memory_order_relaxed));
+  return stats;
+}
+
+void ThreadPool::ResetStats()
+{
+  m_tasks_completed.store(0, std::memory_order_relaxed);
+  m_tasks_stolen.store(0, std::memory_order_relaxed);
+  m_total_queue_latency.store(0, std::memory_order_relaxed);
+  m_max_queue_latency.store(0, std::memory_order_relaxed);
+  m_total_run_time.store(0, std::memory_order_relaxed);
+}
+
+TaskGroup::TaskGroup(ThreadPool& pool) : m_pool(pool)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+  Wait();
+}
+
+void TaskGroup::Run(std::function<void()> function)
+{
+  {
+    std::lock_guard lk(m_lock);
+    ++m_pending_tasks;
+  }
+
+  m_pool.Submit([this, function = std::move(function)] {
+    function();
+
+    // The group may be destroyed as soon as the count reaches zero, so the notification has to
+    // happen while the lock is held.
+    std::lock_guard lk(m_lock);
+    if (--m_pending_tasks == 0)
+      m_done_cv.notify_all();
+  });
+}
+
+void TaskGroup::Wait()
+{
+  std::unique_lock lk(m_lock);
+  while (m_pending_tasks != 0)
+  {
+    lk.unlock();
+    const bool ran_task = m_pool.RunPendingTask();
+    lk.lock();
+
+    // If nothing was queued, the remaining tasks of this group are all running already.
+    if (!ran_task)
+      m_done_cv.wait(lk, [this] { return m_pending_tasks == 0; });
+  }
+}
+
+void TaskSequence::Run(TaskGroup& group, std::function<void()> function)
+{
+  std::lock_guard lk(m_lock);
+  m_queue.push_back(std::move(function));
+  if (m_running)
+    return;
+
+  m_running = true;
+  group.Run([this] { RunQueuedFunctions(); });
+}
+
+void TaskSequence::RunQueuedFunctions()
+{
+  std::unique_lock lk(m_lock);
+  while (!m_queue.empty())
+  {
+    std::function<void()> function = std::move(m_queue.front());
+    m_queue.pop_front();
+
+    lk.unlock();
+    function();
+    lk.lock();
+  }
+  m_running = false;
+}
+}  // namespace Common
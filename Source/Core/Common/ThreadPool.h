@@ -0,0 +1,147 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// A fixed set of worker threads for short, CPU-bound tasks. Every worker has its own queue, and
+// workers which run out of work take tasks from the queues of the others. Threads which wait for
+// tasks to finish using TaskGroup run queued tasks in the meantime, so a task can wait for tasks
+// it has submitted without tying up a worker.
+//
+// Tasks must not block on anything other than a TaskGroup, since all workers may be busy.
+class ThreadPool final
+{
+public:
+  struct Stats
+  {
+    u64 tasks_completed = 0;
+    // Tasks which were run by a worker other than the one they were queued on.
+    u64 tasks_stolen = 0;
+    // Time from submitting a task until a thread started running it.
+    DT total_queue_latency{};
+    DT max_queue_latency{};
+    DT total_run_time{};
+  };
+
+  ThreadPool(std::string name, u32 thread_count);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+  // Runs all tasks which are still queued before returning.
+  ~ThreadPool();
+
+  // The pool used by everything that doesn't need one of its own, with one thread per CPU core.
+  static ThreadPool& GetShared();
+
+  u32 GetThreadCount() const { return static_cast<u32>(m_workers.size()); }
+
+  void Submit(std::function<void()> function);
+
+  // Runs one queued task on the calling thread. Returns false if no task was queued.
+  bool RunPendingTask();
+
+  Stats GetStats() const;
+  void ResetStats();
+
+private:
+  struct Task
+  {
+    std::function<void()> function;
+    TimePoint submit_time;
+  };
+
+  struct Worker
+  {
+    std::mutex lock;
+    std::deque<Task> tasks;
+    std::thread thread;
+  };
+
+  void WorkerLoop(u32 index);
+  bool TryRunTask(u32 own_index);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::atomic<u32> m_next_worker = 0;
+
+  // Tasks which are in a queue and haven't been taken by a thread yet.
+  std::atomic<size_t> m_queued_tasks = 0;
+  std::mutex m_sleep_lock;
+  std::condition_variable m_sleep_cv;
+  bool m_shutting_down = false;
+
+  std::atomic<u64> m_tasks_completed = 0;
+  std::atomic<u64> m_tasks_stolen = 0;
+  std::atomic<DT::rep> m_total_queue_latency = 0;
+  std::atomic<DT::rep> m_max_queue_latency = 0;
+  std::atomic<DT::rep> m_total_run_time = 0;
+};
+
+// A set of tasks submitted to a ThreadPool which can be waited for together.
+class TaskGroup final
+{
+public:
+  explicit TaskGroup(ThreadPool& pool = ThreadPool::GetShared());
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup(TaskGroup&&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+  TaskGroup& operator=(TaskGroup&&) = delete;
+  ~TaskGroup();
+
+  // For splitting work into as many tasks as the pool can run at once.
+  u32 GetThreadCount() const { return m_pool.GetThreadCount(); }
+
+  void Run(std::function<void()> function);
+
+  // Blocks until all tasks of the group have finished, running queued tasks of the pool (which
+  // may belong to other groups) on the calling thread in the meantime.
+  void Wait();
+
+private:
+  ThreadPool& m_pool;
+
+  std::mutex m_lock;
+  std::condition_variable m_done_cv;
+  size_t m_pending_tasks = 0;
+};
+
+// Runs functions one at a time, in the order they were added, for work like feeding data into a
+// hash that can't be split up. The functions run on a task of one of the TaskGroups they were
+// added with, which keeps going for as long as more functions are queued behind it.
+//
+// A function is guaranteed to have run once the TaskGroup it was added with and the TaskGroups of
+// all functions added before it have been waited for.
+class TaskSequence final
+{
+public:
+  TaskSequence() = default;
+  TaskSequence(const TaskSequence&) = delete;
+  TaskSequence(TaskSequence&&) = delete;
+  TaskSequence& operator=(const TaskSequence&) = delete;
+  TaskSequence& operator=(TaskSequence&&) = delete;
+
+  void Run(TaskGroup& group, std::function<void()> function);
+
+private:
+  void RunQueuedFunctions();
+
+  std::mutex m_lock;
+  std::deque<std::function<void()>> m_queue;
+  bool m_running = false;
+};
+}  // namespace Common
@@ -4,24 +4,45 @@
 #include "Core/FifoPlayer/FifoDataFile.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstring>
+#include <filesystem>
+#include <list>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include <xxhash.h>
+#include <zstd.h>
+
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
+#include "Common/ScopeGuard.h"
+#include "Common/StringUtil.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
 constexpr u32 FILE_ID = 0x0d01f1f0;
-constexpr u32 VERSION_NUMBER = 6;
-constexpr u32 MIN_LOADER_VERSION = 1;
-// This value is only used if the DFF file was created with overridden RAM sizes.
-// If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
-constexpr u32 MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5;
+constexpr u32 VERSION_NUMBER = 7;
+// Version 7 replaced the frame list and memory updates with compressed chunks.
+constexpr u32 MIN_LOADER_VERSION = 7;
+constexpr u32 FIRST_COMPRESSED_VERSION = 7;
+
+constexpr int COMPRESSION_LEVEL = 5;
+// Decoded frames and memory update data kept around by the streaming reader
+constexpr size_t MAX_CACHED_FRAMES = 4;
+constexpr size_t MAX_CACHED_BLOB_BYTES = 64 * 1024 * 1024;
 
 #pragma pack(push, 1)
 
@@ -48,7 +69,10 @@ struct FileHeader
   u32 mem1_size;
   u32 mem2_size;
   char gameid[8];
-  u8 reserved[24];
+  // Deduplicated memory update data, used by compressed files only
+  u64 blobListOffset;
+  u32 blobCount;
+  u8 reserved[12];
 };
 static_assert(sizeof(FileHeader) == 128, "FileHeader should be 128 bytes");
 static_assert(DEFAULT_GAME_ID.size() == sizeof(FileHeader::gameid), "Default game id size changed");
@@ -76,8 +100,385 @@ struct FileMemoryUpdate
 };
 static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 bytes");
 
+// Compressed files store each frame as a single chunk holding the FIFO data followed by the
+// frame's memory updates. The data of memory updates is stored separately as blobs, each of which
+// is only written once no matter how many times it's uploaded. Chunks and blobs are compressed
+// with zstd, unless that doesn't make them any smaller, in which case they are stored as-is.
+
+struct FileFrameChunk
+{
+  u64 chunkOffset;
+  u32 chunkSize;
+  u32 fifoDataSize;
+  u32 fifoStart;
+  u32 fifoEnd;
+  u32 numMemoryUpdates;
+  u8 reserved[4];
+};
+static_assert(sizeof(FileFrameChunk) == 32, "FileFrameChunk should be 32 bytes");
+
+struct FileChunkMemoryUpdate
+{
+  u32 fifoPosition;
+  u32 address;
+  u32 blobIndex;
+  u8 type;
+  u8 reserved[3];
+};
+static_assert(sizeof(FileChunkMemoryUpdate) == 16, "FileChunkMemoryUpdate should be 16 bytes");
+
+struct FileBlob
+{
+  u64 dataOffset;
+  u32 storedSize;
+  u32 dataSize;
+};
+static_assert(sizeof(FileBlob) == 16, "FileBlob should be 16 bytes");
+
 #pragma pack(pop)
 
+namespace
+{
+class ChunkWriter
+{
+public:
+  ChunkWriter() : m_compression_context(ZSTD_createCCtx()) {}
+  ~ChunkWriter() { ZSTD_freeCCtx(m_compression_context); }
+
+  ChunkWriter(const ChunkWriter&) = delete;
+  ChunkWriter& operator=(const ChunkWriter&) = delete;
+
+  // Appends data to the end of the file and returns the number of bytes it was stored in.
+  std::optional<u32> Write(std::span<const u8> data, File::IOFile& file)
+  {
+    m_buffer.resize(ZSTD_compressBound(data.size()));
+    const size_t compressed_size =
+        ZSTD_compressCCtx(m_compression_context, m_buffer.data(), m_buffer.size(), data.data(),
+                          data.size(), COMPRESSION_LEVEL);
+    if (!ZSTD_isError(compressed_size) && compressed_size < data.size())
+      data = std::span(m_buffer.data(), compressed_size);
+
+    if (!file.WriteBytes(data.data(), data.size()))
+      return std::nullopt;
+    return static_cast<u32>(data.size());
+  }
+
+  // Returns the index of the blob holding the given data. The data is only appended to the file if
+  // it hasn't been written before, which is what keeps textures that are uploaded every frame from
+  // bloating the file.
+  std::optional<u32> WriteBlob(std::span<const u8> data, File::IOFile& file)
+  {
+    const XXH128_hash_t hash = XXH3_128bits(data.data(), data.size());
+    const BlobKey key{hash.low64, hash.high64, static_cast<u32>(data.size())};
+    if (const auto it = m_blob_indices.find(key); it != m_blob_indices.end())
+      return it->second;
+
+    FileBlob blob{};
+    blob.dataOffset = file.Tell();
+    blob.dataSize = static_cast<u32>(data.size());
+    const std::optional<u32> stored_size = Write(data, file);
+    if (!stored_size)
+      return std::nullopt;
+    blob.storedSize = *stored_size;
+
+    const u32 index = static_cast<u32>(m_blobs.size());
+    m_blobs.push_back(blob);
+    m_blob_indices.emplace(key, index);
+    return index;
+  }
+
+  const std::vector<FileBlob>& GetBlobs() const { return m_blobs; }
+
+private:
+  // 128-bit content hash and size
+  using BlobKey = std::tuple<u64, u64, u32>;
+
+  ZSTD_CCtx* const m_compression_context;
+  std::vector<u8> m_buffer;
+
+  std::vector<FileBlob> m_blobs;
+  std::map<BlobKey, u32> m_blob_indices;
+};
+}  // namespace
+
+// Decodes the frames of a compressed file on demand, keeping only the last few frames and the most
+// recently used memory update data in memory, so that memory usage doesn't grow with the length of
+// the recording. Frames can be decoded ahead of time on a background thread.
+class FifoDataFile::FrameStream
+{
+public:
+  FrameStream(File::IOFile file, std::vector<FileFrameChunk> frames, std::vector<FileBlob> blobs);
+  ~FrameStream();
+
+  FrameStream(const FrameStream&) = delete;
+  FrameStream& operator=(const FrameStream&) = delete;
+
+  u32 GetFrameCount() const { return static_cast<u32>(m_frames.size()); }
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame);
+  void Prefetch(u32 frame);
+
+private:
+  struct CachedFrame
+  {
+    u32 frame;
+    // Null while the frame is being decoded by the prefetch thread
+    std::shared_ptr<const FifoFrameInfo> data;
+  };
+
+  struct CachedBlob
+  {
+    std::shared_ptr<const std::vector<u8>> data;
+    std::list<u32>::iterator lru_position;
+  };
+
+  std::shared_ptr<const FifoFrameInfo> DecodeFrame(u32 frame);
+  std::shared_ptr<const std::vector<u8>> GetBlob(u32 index);
+  bool ReadChunk(u64 offset, u32 stored_size, std::span<u8> data);
+
+  // m_frame_mutex must be held
+  void AddToFrameCache(u32 frame, std::shared_ptr<const FifoFrameInfo> data);
+
+  const std::vector<FileFrameChunk> m_frames;
+  const std::vector<FileBlob> m_blobs;
+
+  std::mutex m_file_mutex;
+  File::IOFile m_file;
+  const u64 m_file_size;
+  ZSTD_DCtx* const m_decompression_context;
+  std::vector<u8> m_read_buffer;
+
+  std::mutex m_blob_mutex;
+  // Most recently used first
+  std::list<u32> m_blob_lru;
+  std::unordered_map<u32, CachedBlob> m_blob_cache;
+  size_t m_cached_blob_bytes = 0;
+
+  std::mutex m_frame_mutex;
+  std::condition_variable m_frame_decoded;
+  // Most recently used first
+  std::list<CachedFrame> m_frame_cache;
+
+  Common::WorkQueueThread<u32> m_prefetch_thread;
+};
+
+FifoDataFile::FrameStream::FrameStream(File::IOFile file, std::vector<FileFrameChunk> frames,
+                                       std::vector<FileBlob> blobs)
+    : m_frames(std::move(frames)), m_blobs(std::move(blobs)), m_file(std::move(file)),
+      m_file_size(m_file.GetSize()), m_decompression_context(ZSTD_createDCtx())
+{
+  m_prefetch_thread.Reset("FIFO Frame Decoder", [this](u32 frame) {
+    std::shared_ptr<const FifoFrameInfo> data = DecodeFrame(frame);
+
+    std::lock_guard lock(m_frame_mutex);
+    AddToFrameCache(frame, std::move(data));
+  });
+}
+
+FifoDataFile::FrameStream::~FrameStream()
+{
+  m_prefetch_thread.StopAndCancel();
+  ZSTD_freeDCtx(m_decompression_context);
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::FrameStream::GetFrame(u32 frame)
+{
+  {
+    std::unique_lock lock(m_frame_mutex);
+    while (true)
+    {
+      const auto it = std::ranges::find(m_frame_cache, frame, &CachedFrame::frame);
+      if (it == m_frame_cache.end())
+        break;
+
+      if (it->data)
+      {
+        m_frame_cache.splice(m_frame_cache.begin(), m_frame_cache, it);
+        return it->data;
+      }
+
+      // The prefetch thread is already decoding this frame
+      m_frame_decoded.wait(lock);
+    }
+  }
+
+  std::shared_ptr<const FifoFrameInfo> data = DecodeFrame(frame);
+
+  std::lock_guard lock(m_frame_mutex);
+  AddToFrameCache(frame, data);
+  return data;
+}
+
+void FifoDataFile::FrameStream::Prefetch(u32 frame)
+{
+  {
+    std::lock_guard lock(m_frame_mutex);
+    if (std::ranges::find(m_frame_cache, frame, &CachedFrame::frame) != m_frame_cache.end())
+      return;
+
+    m_frame_cache.push_front({frame, nullptr});
+  }
+
+  m_prefetch_thread.Push(frame);
+}
+
+void FifoDataFile::FrameStream::AddToFrameCache(u32 frame,
+                                                std::shared_ptr<const FifoFrameInfo> data)
+{
+  const auto it = std::ranges::find(m_frame_cache, frame, &CachedFrame::frame);
+  if (it != m_frame_cache.end())
+  {
+    it->data = std::move(data);
+    m_frame_cache.splice(m_frame_cache.begin(), m_frame_cache, it);
+  }
+  else
+  {
+    m_frame_cache.push_front({frame, std::move(data)});
+  }
+  m_frame_decoded.notify_all();
+
+  // Evict the least recently used frames, but never ones that are still being decoded
+  auto evict = m_frame_cache.end();
+  while (m_frame_cache.size() > MAX_CACHED_FRAMES && evict != m_frame_cache.begin())
+  {
+    --evict;
+    if (evict->data)
+      evict = m_frame_cache.erase(evict);
+  }
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::FrameStream::DecodeFrame(u32 frame)
+{
+  const FileFrameChunk& src_frame = m_frames[frame];
+
+  auto dst_frame = std::make_shared<FifoFrameInfo>();
+  dst_frame->fifoStart = src_frame.fifoStart;
+  dst_frame->fifoEnd = src_frame.fifoEnd;
+
+  const size_t fifo_data_size = src_frame.fifoDataSize;
+  std::vector<u8> chunk(fifo_data_size +
+                        size_t{src_frame.numMemoryUpdates} * sizeof(FileChunkMemoryUpdate));
+  if (!ReadChunk(src_frame.chunkOffset, src_frame.chunkSize, chunk))
+  {
+    PanicAlertFmtT("Failed to read frame {0} of the DFF file.", frame);
+    return dst_frame;
+  }
+
+  std::vector<MemoryUpdate> memory_updates(src_frame.numMemoryUpdates);
+  for (u32 i = 0; i < src_frame.numMemoryUpdates; ++i)
+  {
+    FileChunkMemoryUpdate src_update;
+    std::memcpy(&src_update, chunk.data() + fifo_data_size + i * sizeof(FileChunkMemoryUpdate),
+                sizeof(FileChunkMemoryUpdate));
+
+    const std::shared_ptr<const std::vector<u8>> blob = GetBlob(src_update.blobIndex);
+    if (!blob)
+    {
+      PanicAlertFmtT("Failed to read frame {0} of the DFF file.", frame);
+      return dst_frame;
+    }
+
+    MemoryUpdate& dst_update = memory_updates[i];
+    dst_update.fifoPosition = src_update.fifoPosition;
+    dst_update.address = src_update.address;
+    dst_update.data = *blob;
+    dst_update.type = static_cast<MemoryUpdate::Type>(src_update.type);
+  }
+
+  chunk.resize(fifo_data_size);
+  dst_frame->fifoData = std::move(chunk);
+  dst_frame->memoryUpdates = std::move(memory_updates);
+  return dst_frame;
+}
+
+std::shared_ptr<const std::vector<u8>> FifoDataFile::FrameStream::GetBlob(u32 index)
+{
+  if (index >= m_blobs.size())
+    return nullptr;
+
+  {
+    std::lock_guard lock(m_blob_mutex);
+    if (const auto it = m_blob_cache.find(index); it != m_blob_cache.end())
+    {
+      m_blob_lru.splice(m_blob_lru.begin(), m_blob_lru, it->second.lru_position);
+      return it->second.data;
+    }
+  }
+
+  const FileBlob& blob = m_blobs[index];
+  auto data = std::make_shared<std::vector<u8>>(blob.dataSize);
+  if (!ReadChunk(blob.dataOffset, blob.storedSize, *data))
+    return nullptr;
+
+  std::lock_guard lock(m_blob_mutex);
+  if (m_blob_cache.contains(index))
+    return data;
+
+  m_blob_lru.push_front(index);
+  m_blob_cache.emplace(index, CachedBlob{data, m_blob_lru.begin()});
+  m_cached_blob_bytes += data->size();
+
+  while (m_cached_blob_bytes > MAX_CACHED_BLOB_BYTES && m_blob_lru.size() > 1)
+  {
+    const auto it = m_blob_cache.find(m_blob_lru.back());
+    m_cached_blob_bytes -= it->second.data->size();
+    m_blob_cache.erase(it);
+    m_blob_lru.pop_back();
+  }
+
+  return data;
+}
+
+bool FifoDataFile::FrameStream::ReadChunk(u64 offset, u32 stored_size, std::span<u8> data)
+{
+  std::lock_guard lock(m_file_mutex);
+
+  if (offset > m_file_size || stored_size > m_file_size - offset)
+    return false;
+
+  m_file.ClearError();
+  if (!m_file.Seek(offset, File::SeekOrigin::Begin))
+    return false;
+
+  // Chunks that didn't get any smaller from being compressed are stored as-is
+  if (stored_size == data.size())
+    return m_file.ReadBytes(data.data(), data.size());
+
+  m_read_buffer.resize(stored_size);
+  if (!m_file.ReadBytes(m_read_buffer.data(), stored_size))
+    return false;
+
+  const size_t size = ZSTD_decompressDCtx(m_decompression_context, data.data(), data.size(),
+                                          m_read_buffer.data(), stored_size);
+  return !ZSTD_isError(size) && size == data.size();
+}
+
+// Reads the frame and blob lists of a compressed file. Fails if the header claims more entries
+// than the file has room for, rather than allocating whatever a damaged header asks for.
+static bool ReadFrameAndBlobLists(File::IOFile& file, const FileHeader& header,
+                                  std::vector<FileFrameChunk>* frames,
+                                  std::vector<FileBlob>* blobs)
+{
+  const u64 file_size = file.GetSize();
+  const auto fits_in_file = [file_size](u64 offset, u64 count, u64 entry_size) {
+    return offset <= file_size && count <= (file_size - offset) / entry_size;
+  };
+  if (!fits_in_file(header.frameListOffset, header.frameCount, sizeof(FileFrameChunk)) ||
+      !fits_in_file(header.blobListOffset, header.blobCount, sizeof(FileBlob)))
+  {
+    return false;
+  }
+
+  frames->resize(header.frameCount);
+  file.Seek(header.frameListOffset, File::SeekOrigin::Begin);
+  file.ReadArray(frames->data(), frames->size());
+
+  blobs->resize(header.blobCount);
+  file.Seek(header.blobListOffset, File::SeekOrigin::Begin);
+  file.ReadArray(blobs->data(), blobs->size());
+
+  return file.IsGood();
+}
+
 FifoDataFile::FifoDataFile() = default;
 
 FifoDataFile::~FifoDataFile() = default;
@@ -102,24 +503,77 @@ bool FifoDataFile::GetIsWii() const
   return GetFlag(FLAG_IS_WII);
 }
 
-void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
+void FifoDataFile::AddFrame(FifoFrameInfo frameInfo)
+{
+  m_Frames.push_back(std::move(frameInfo));
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  if (m_frame_stream)
+    return m_frame_stream->GetFrame(frame);
+
+  // Frames kept in memory live as long as the file does, so the pointer doesn't need to own them
+  return std::shared_ptr<const FifoFrameInfo>(std::shared_ptr<const FifoFrameInfo>(),
+                                              &m_Frames[frame]);
+}
+
+void FifoDataFile::PrefetchFrame(u32 frame) const
+{
+  if (m_frame_stream && frame < m_frame_stream->GetFrameCount())
+    m_frame_stream->Prefetch(frame);
+}
+
+u32 FifoDataFile::GetFrameCount() const
+{
+  if (m_frame_stream)
+    return m_frame_stream->GetFrameCount();
+
+  return static_cast<u32>(m_Frames.size());
+}
+
+bool FifoDataFile::StreamsFrom(const std::string& filename) const
+{
+  std::error_code error;
+  return m_frame_stream &&
+         std::filesystem::equivalent(StringToPath(m_stream_filename), StringToPath(filename),
+                                     error);
+}
+
+bool FifoDataFile::OpenFrameStream(const std::string& filename)
 {
-  m_Frames.push_back(frameInfo);
+  File::IOFile file(filename, "rb");
+  FileHeader header;
+  std::vector<FileFrameChunk> frameList;
+  std::vector<FileBlob> blobList;
+  if (!file.ReadBytes(&header, sizeof(header)) || header.fileId != FILE_ID ||
+      header.file_version < FIRST_COMPRESSED_VERSION ||
+      !ReadFrameAndBlobLists(file, header, &frameList, &blobList))
+  {
+    return false;
+  }
+
+  m_frame_stream =
+      std::make_unique<FrameStream>(std::move(file), std::move(frameList), std::move(blobList));
+  m_stream_filename = filename;
+  return true;
 }
 
 bool FifoDataFile::Save(const std::string& filename)
 {
+  // The frames of a compressed file are streamed from the file it was loaded from, which may be
+  // the one that is being saved over. So write a new file and only replace the old one at the end.
+  const std::string temp_filename = filename + ".tmp";
+  Common::ScopeGuard temp_file_guard{
+      [&] { File::Delete(temp_filename, File::IfAbsentBehavior::NoConsoleWarning); }};
+
   File::IOFile file;
-  if (!file.Open(filename, "wb"))
+  if (!file.Open(temp_filename, "wb"))
     return false;
 
   // Add space for header
   PadFile(sizeof(FileHeader), file);
 
-  // Add space for frame list
-  u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
-
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem);
 
@@ -135,15 +589,59 @@ bool FifoDataFile::Save(const std::string& filename)
   u64 texMemOffset = file.Tell();
   file.WriteArray(m_TexMem);
 
+  // Write frame chunks
+  ChunkWriter writer;
+  const u32 frameCount = GetFrameCount();
+  std::vector<FileFrameChunk> frameList(frameCount);
+  std::vector<u8> chunk;
+  for (u32 i = 0; i < frameCount; ++i)
+  {
+    const auto srcFrame = GetFrame(i);
+
+    // Memory update data goes into the blob store, so that data which is uploaded again
+    // unchanged (which happens all the time for textures) is only stored once.
+    chunk.assign(srcFrame->fifoData.begin(), srcFrame->fifoData.end());
+    for (const MemoryUpdate& srcUpdate : srcFrame->memoryUpdates)
+    {
+      const std::optional<u32> blobIndex = writer.WriteBlob(srcUpdate.data, file);
+      if (!blobIndex)
+        return false;
+
+      FileChunkMemoryUpdate dstUpdate{};
+      dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+      dstUpdate.address = srcUpdate.address;
+      dstUpdate.blobIndex = *blobIndex;
+      dstUpdate.type = static_cast<u8>(srcUpdate.type);
+
+      const size_t updateOffset = chunk.size();
+      chunk.resize(updateOffset + sizeof(FileChunkMemoryUpdate));
+      std::memcpy(chunk.data() + updateOffset, &dstUpdate, sizeof(FileChunkMemoryUpdate));
+    }
+
+    FileFrameChunk& dstFrame = frameList[i];
+    dstFrame.chunkOffset = file.Tell();
+    const std::optional<u32> chunkSize = writer.Write(chunk, file);
+    if (!chunkSize)
+      return false;
+    dstFrame.chunkSize = *chunkSize;
+    dstFrame.fifoDataSize = static_cast<u32>(srcFrame->fifoData.size());
+    dstFrame.fifoStart = srcFrame->fifoStart;
+    dstFrame.fifoEnd = srcFrame->fifoEnd;
+    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame->memoryUpdates.size());
+  }
+
+  u64 frameListOffset = file.Tell();
+  file.WriteArray(frameList.data(), frameList.size());
+
+  const std::vector<FileBlob>& blobList = writer.GetBlobs();
+  u64 blobListOffset = file.Tell();
+  file.WriteArray(blobList.data(), blobList.size());
+
   // Write header
-  FileHeader header;
+  FileHeader header{};
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  // Maintain backwards compatibility so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
-    header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
-  else
-    header.min_loader_version = MIN_LOADER_VERSION;
+  header.min_loader_version = MIN_LOADER_VERSION;
 
   header.bpMemOffset = bpMemOffset;
   header.bpMemSize = BP_MEM_SIZE;
@@ -161,7 +659,10 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = frameCount;
+
+  header.blobListOffset = blobListOffset;
+  header.blobCount = static_cast<u32>(blobList.size());
 
   header.flags = m_Flags;
 
@@ -184,35 +685,25 @@ bool FifoDataFile::Save(const std::string& filename)
   file.Seek(0, File::SeekOrigin::Begin);
   file.WriteBytes(&header, sizeof(FileHeader));
 
-  // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
-  {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
-
-    // Write FIFO data
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
-
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
+  if (!file.Close())
+    return false;
 
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
-    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
+  // On Windows, a file can't be replaced while it is open. The new file holds the same frames as
+  // the one they are streamed from, so the stream is reopened on whichever file ends up there.
+  const bool reopen_stream = StreamsFrom(filename);
+  if (reopen_stream)
+    m_frame_stream.reset();
 
-    // Write frame info
-    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
+  const bool renamed = File::Rename(temp_filename, filename);
+  if (reopen_stream && !OpenFrameStream(filename))
+  {
+    CriticalAlertFmtT("Failed to read DFF file.");
+    return false;
   }
-
-  if (!file.Close())
+  if (!renamed)
     return false;
 
+  temp_file_guard.Dismiss();
   return true;
 }
 
@@ -340,6 +831,21 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
+  if (header.file_version >= FIRST_COMPRESSED_VERSION)
+  {
+    // Only the frame and blob lists are read up front. The frames themselves are decoded as the
+    // player gets to them, so that long recordings don't have to fit in memory.
+    std::vector<FileFrameChunk> frameList;
+    std::vector<FileBlob> blobList;
+    if (!ReadFrameAndBlobLists(file, header, &frameList, &blobList))
+      return panic_failed_to_read();
+
+    dataFile->m_frame_stream =
+        std::make_unique<FrameStream>(std::move(file), std::move(frameList), std::move(blobList));
+    dataFile->m_stream_filename = filename;
+    return dataFile;
+  }
+
   // Read frames
   for (u32 i = 0; i < header.frameCount; ++i)
   {
@@ -363,7 +869,7 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     if (!file.IsGood())
       return panic_failed_to_read();
 
-    dataFile->AddFrame(dstFrame);
+    dataFile->AddFrame(std::move(dstFrame));
   }
 
   return dataFile;
@@ -388,37 +894,6 @@ bool FifoDataFile::GetFlag(u32 flag) const
   return !!(m_Flags & flag);
 }
 
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
-{
-  // Add space for memory update list
-  u64 updateListOffset = file.Tell();
-  PadFile(memUpdates.size() * sizeof(FileMemoryUpdate), file);
-
-  for (unsigned int i = 0; i < memUpdates.size(); ++i)
-  {
-    const MemoryUpdate& srcUpdate = memUpdates[i];
-
-    // Write memory
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
-
-    FileMemoryUpdate dstUpdate;
-    dstUpdate.address = srcUpdate.address;
-    dstUpdate.dataOffset = dataOffset;
-    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
-    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.type = static_cast<u8>(srcUpdate.type);
-
-    u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
-  }
-
-  return updateListOffset;
-}
-
 void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                      std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
 {
@@ -74,14 +74,23 @@ public:
   u32 GetExRamSizeReal() { return m_exram_size_real; }
   const std::string& GetGameId() const { return m_game_id; }
 
-  void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  void AddFrame(FifoFrameInfo frameInfo);
+  // Frames of compressed files are decoded on demand and only a few of them are kept in memory,
+  // so hold on to the returned pointer for as long as the frame is used. Thread-safe.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  // Starts decoding a frame on a background thread, so that a later GetFrame() won't have to.
+  void PrefetchFrame(u32 frame) const;
+  u32 GetFrameCount() const;
+  // Whether the frames are streamed from the given file, which then can't be replaced by another
+  // FifoDataFile on all platforms.
+  bool StreamsFrom(const std::string& filename) const;
   bool Save(const std::string& filename);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
 
 private:
+  class FrameStream;
+
   enum
   {
     FLAG_IS_WII = 1
@@ -92,9 +101,9 @@ private:
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
   static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                 std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  bool OpenFrameStream(const std::string& filename);
 
   std::array<u32, BP_MEM_SIZE> m_BPMem{};
   std::array<u32, CP_MEM_SIZE> m_CPMem{};
@@ -109,5 +118,9 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
+  // Frames of recordings and of uncompressed files, which are kept in memory
   std::vector<FifoFrameInfo> m_Frames;
+  // Reads the frames of compressed files
+  std::unique_ptr<FrameStream> m_frame_stream;
+  std::string m_stream_filename;
 };
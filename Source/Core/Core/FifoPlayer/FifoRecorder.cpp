@@ -5,6 +5,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <optional>
+#include <utility>
 
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
@@ -19,6 +21,34 @@
 #include "VideoCommon/VideoEvents.h"
 #include "VideoCommon/XFMemory.h"
 
+// Emulated memory is compared against the copy that was last recorded in blocks of this size,
+// and only the blocks that changed are recorded again.
+constexpr u32 CAPTURE_BLOCK_SIZE = 0x1000;
+
+// Measures the time the video thread spends in the recorder. Only the outermost timer counts,
+// since UseMemory is also called while WriteGPCommand analyzes a command.
+class FifoRecorder::OverheadTimer
+{
+public:
+  explicit OverheadTimer(FifoRecorder& owner) : m_owner(owner)
+  {
+    if (m_owner.m_overhead_timer_depth++ == 0)
+      m_start = Clock::now();
+  }
+  ~OverheadTimer()
+  {
+    if (--m_owner.m_overhead_timer_depth == 0)
+      m_owner.m_frame_overhead += Clock::now() - m_start;
+  }
+
+  OverheadTimer(const OverheadTimer&) = delete;
+  OverheadTimer& operator=(const OverheadTimer&) = delete;
+
+private:
+  FifoRecorder& m_owner;
+  TimePoint m_start;
+};
+
 class FifoRecorder::FifoRecordAnalyzer : public OpcodeDecoder::Callback
 {
 public:
@@ -216,6 +246,7 @@ void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
   std::lock_guard lk(m_mutex);
 
   m_File = std::make_unique<FifoDataFile>();
+  m_stats = {};
 
   // TODO: This, ideally, would be deallocated when done recording.
   //       However, care needs to be taken since global state
@@ -235,6 +266,8 @@ void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
 
   std::ranges::fill(m_Ram, 0);
   std::ranges::fill(m_ExRam, 0);
+  m_RamBlocksSeen.assign(m_Ram.size() / CAPTURE_BLOCK_SIZE, false);
+  m_ExRamBlocksSeen.assign(m_ExRam.size() / CAPTURE_BLOCK_SIZE, false);
 
   m_File->SetIsWii(m_system.IsWii());
 
@@ -302,8 +335,16 @@ FifoDataFile* FifoRecorder::GetRecordedFile() const
   return m_File.get();
 }
 
+FifoRecorder::Stats FifoRecorder::GetStats() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_stats;
+}
+
 void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
 {
+  OverheadTimer timer(*this);
+
   if (!m_SkipNextData)
   {
     // Assumes data contains all information for the command
@@ -325,21 +366,33 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
 
   if (m_FrameEnded && !m_FifoData.empty())
   {
-    m_CurrentFrame.fifoData = m_FifoData;
+    const size_t fifo_size = m_FifoData.size();
+    m_CurrentFrame.fifoData = std::move(m_FifoData);
 
     {
       std::lock_guard lk(m_mutex);
 
-      // Copy frame to file
-      // The file will be responsible for freeing the memory allocated for each frame's fifoData
-      m_File->AddFrame(m_CurrentFrame);
+      ++m_stats.frames;
+      m_stats.last_frame_overhead = m_frame_overhead;
+      m_stats.max_frame_overhead = std::max(m_stats.max_frame_overhead, m_frame_overhead);
+      m_stats.total_overhead += m_frame_overhead;
+      m_stats.bytes_scanned += m_frame_bytes_scanned;
+      m_stats.bytes_captured += m_frame_bytes_captured;
+
+      // The frame is moved into the file, which is responsible for freeing it from now on
+      m_File->AddFrame(std::move(m_CurrentFrame));
 
       if (m_FinishedCb && m_RequestedRecordingEnd)
         m_FinishedCb();
     }
 
-    m_CurrentFrame.memoryUpdates.clear();
-    m_FifoData.clear();
+    m_frame_overhead = {};
+    m_frame_bytes_scanned = 0;
+    m_frame_bytes_captured = 0;
+
+    m_CurrentFrame = {};
+    m_FifoData = {};
+    m_FifoData.reserve(fifo_size);
     m_FrameEnded = false;
   }
 
@@ -348,41 +401,87 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
 
 void FifoRecorder::UseMemory(u32 address, u32 size, MemoryUpdate::Type type, bool dynamicUpdate)
 {
+  OverheadTimer timer(*this);
+
   auto& memory = m_system.GetMemory();
 
-  u8* curData;
-  u8* newData;
-  if (address & 0x10000000)
-  {
-    curData = &m_ExRam[address & memory.GetExRamMask()];
-    newData = &memory.GetEXRAM()[address & memory.GetExRamMask()];
-  }
-  else
+  const bool is_exram = (address & 0x10000000) != 0;
+  const u32 mask = is_exram ? memory.GetExRamMask() : memory.GetRamMask();
+  u8* const recorded = is_exram ? m_ExRam.data() : m_Ram.data();
+  const u8* const current = is_exram ? memory.GetEXRAM() : memory.GetRAM();
+  const u32 offset = address & mask;
+
+  if (dynamicUpdate)
   {
-    curData = &m_Ram[address & memory.GetRamMask()];
-    newData = &memory.GetRAM()[address & memory.GetRamMask()];
+    // Shadow the data so it won't be recorded as changed by a future UseMemory
+    memcpy(recorded + offset, current + offset, size);
+    return;
   }
 
-  if (!dynamicUpdate && memcmp(curData, newData, size) != 0)
-  {
-    // Update current memory
-    memcpy(curData, newData, size);
+  CaptureChangedMemory(address & ~mask, recorded, current,
+                       is_exram ? m_ExRamBlocksSeen : m_RamBlocksSeen, offset, size, type);
+}
 
-    // Record memory update
+void FifoRecorder::CaptureChangedMemory(u32 base_address, u8* recorded, const u8* current,
+                                        std::vector<bool>& blocks_seen, u32 offset, u32 size,
+                                        MemoryUpdate::Type type)
+{
+  m_frame_bytes_scanned += size;
+
+  // Adjacent changed blocks are merged into a single memory update
+  std::optional<u32> changed_start;
+  u32 changed_end = 0;
+  auto record_update = [&] {
     MemoryUpdate memUpdate;
-    memUpdate.address = address;
-    memUpdate.fifoPosition = (u32)(m_FifoData.size());
+    memUpdate.address = base_address + *changed_start;
+    memUpdate.fifoPosition = static_cast<u32>(m_FifoData.size());
     memUpdate.type = type;
-    memUpdate.data.resize(size);
-    std::copy_n(newData, size, memUpdate.data.begin());
+    memUpdate.data.assign(recorded + *changed_start, recorded + changed_end);
 
     m_CurrentFrame.memoryUpdates.push_back(std::move(memUpdate));
-  }
-  else if (dynamicUpdate)
+    m_frame_bytes_captured += changed_end - *changed_start;
+    changed_start.reset();
+  };
+  auto add_changed_range = [&](u32 start, u32 end) {
+    if (changed_start && changed_end != start)
+      record_update();
+    if (!changed_start)
+      changed_start = start;
+    changed_end = end;
+  };
+
+  const u32 end = offset + size;
+  u32 position = offset;
+  while (position < end)
   {
-    // Shadow the data so it won't be recorded as changed by a future UseMemory
-    memcpy(curData, newData, size);
+    const u32 block_index = position / CAPTURE_BLOCK_SIZE;
+    const u32 block_start = block_index * CAPTURE_BLOCK_SIZE;
+    const u32 block_end = std::min(block_start + CAPTURE_BLOCK_SIZE, end);
+
+    if (!blocks_seen[block_index])
+    {
+      // Nothing is known about what the player has in a block that was never recorded, not even
+      // that it's zero like the recorded copy. The whole block is recorded the first time it's
+      // used, so that it can be compared against from then on.
+      blocks_seen[block_index] = true;
+      memcpy(recorded + block_start, current + block_start, CAPTURE_BLOCK_SIZE);
+      add_changed_range(block_start, block_start + CAPTURE_BLOCK_SIZE);
+    }
+    else if (memcmp(recorded + position, current + position, block_end - position) != 0)
+    {
+      memcpy(recorded + position, current + position, block_end - position);
+      add_changed_range(position, block_end);
+    }
+    else if (changed_start)
+    {
+      record_update();
+    }
+
+    position = block_end;
   }
+
+  if (changed_start)
+    record_update();
 }
 
 void FifoRecorder::EndFrame(u32 fifoStart, u32 fifoEnd)
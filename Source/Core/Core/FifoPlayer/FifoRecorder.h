@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "Common/Assert.h"
+#include "Common/CommonTypes.h"
 #include "Common/HookableEvent.h"
 #include "Core/FifoPlayer/FifoDataFile.h"
 
@@ -22,6 +23,20 @@ class FifoRecorder
 public:
   using CallbackFunc = std::function<void()>;
 
+  // The cost of recording, as seen by the video thread
+  struct Stats
+  {
+    u32 frames = 0;
+    // Time spent analyzing commands and capturing memory
+    DT last_frame_overhead{};
+    DT max_frame_overhead{};
+    DT total_overhead{};
+    // Bytes of emulated memory compared against what was last recorded, and how many of them
+    // had changed and were recorded again
+    u64 bytes_scanned = 0;
+    u64 bytes_captured = 0;
+  };
+
   explicit FifoRecorder(Core::System& system);
   FifoRecorder(const FifoRecorder&) = delete;
   FifoRecorder(FifoRecorder&&) = delete;
@@ -35,6 +50,7 @@ public:
   bool IsRecordingDone() const;
 
   FifoDataFile* GetRecordedFile() const;
+  Stats GetStats() const;
   // Called from video thread
 
   // Must write one full GP command at a time
@@ -59,12 +75,16 @@ public:
 
 private:
   class FifoRecordAnalyzer;
+  class OverheadTimer;
 
   void RecordInitialVideoMemory();
+  void CaptureChangedMemory(u32 base_address, u8* recorded, const u8* current,
+                            std::vector<bool>& blocks_seen, u32 offset, u32 size,
+                            MemoryUpdate::Type type);
 
   // Accessed from both GUI and video threads
 
-  std::recursive_mutex m_mutex;
+  mutable std::recursive_mutex m_mutex;
   // True if video thread should send data
   bool m_IsRecording = false;
   // True if m_IsRecording was true during last frame
@@ -73,6 +93,7 @@ private:
   s32 m_RecordFramesRemaining = 0;
   CallbackFunc m_FinishedCb;
   std::unique_ptr<FifoDataFile> m_File;
+  Stats m_stats;
 
   // Accessed only from video thread
 
@@ -84,6 +105,13 @@ private:
   std::vector<u8> m_FifoData;
   std::vector<u8> m_Ram;
   std::vector<u8> m_ExRam;
+  // Blocks of m_Ram and m_ExRam that have been recorded at least once
+  std::vector<bool> m_RamBlocksSeen;
+  std::vector<bool> m_ExRamBlocksSeen;
+  u32 m_overhead_timer_depth = 0;
+  DT m_frame_overhead{};
+  u64 m_frame_bytes_scanned = 0;
+  u64 m_frame_bytes_captured = 0;
 
   Common::EventHook m_end_of_frame_event;
 
@@ -0,0 +1,222 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DVD/DVDPrefetcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <tuple>
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Core/Config/MainSettings.h"
+
+#include "DiscIO/Blob.h"
+#include "DiscIO/Filesystem.h"
+#include "DiscIO/Volume.h"
+
+namespace DVD
+{
+constexpr u32 HISTORY_FILE_MAGIC = 0x48445644;  // DVDH
+constexpr u32 HISTORY_FILE_VERSION = 1;
+
+// Files are read in pieces of this size, so that large files don't need a large buffer.
+constexpr u64 PREFETCH_BLOCK_SIZE = 1024 * 1024;
+
+bool DVDPrefetcher::FileAccess::operator<(const FileAccess& other) const
+{
+  return std::tie(partition_offset, file_offset) <
+         std::tie(other.partition_offset, other.file_offset);
+}
+
+bool DVDPrefetcher::FileAccess::operator==(const FileAccess& other) const
+{
+  return std::tie(partition_offset, file_offset) ==
+         std::tie(other.partition_offset, other.file_offset);
+}
+
+DVDPrefetcher::DVDPrefetcher() = default;
+
+DVDPrefetcher::~DVDPrefetcher()
+{
+  m_prefetch_thread.Cancel();
+  m_prefetch_thread.Shutdown();
+}
+
+void DVDPrefetcher::SetDisc(const DiscIO::Volume* disc)
+{
+  m_prefetch_thread.Cancel();
+  m_prefetch_thread.Shutdown();
+
+  if (m_enabled)
+  {
+    SaveHistory();
+
+    const Stats stats = GetStats();
+    INFO_LOG_FMT(DVDINTERFACE,
+                 "DVD prefetch: {} of {} prefetched files ({} KiB) were read by the game, "
+                 "avoiding {} ms of host I/O on the DVD thread",
+                 stats.prefetch_hits, stats.files_prefetched, stats.bytes_prefetched / 1024,
+                 std::chrono::duration_cast<std::chrono::milliseconds>(stats.io_time_avoided)
+                     .count());
+  }
+
+  m_enabled = false;
+  m_history.clear();
+  m_history_index.clear();
+  m_recording.clear();
+  m_recorded_files.clear();
+  m_queued_files.clear();
+  m_previous_file = {};
+  m_prefetch_disc.reset();
+  {
+    std::lock_guard lk(m_prefetched_lock);
+    m_prefetched_files.clear();
+    m_stats = {};
+  }
+
+  if (!disc || !Config::Get(Config::MAIN_DVD_PREFETCH))
+    return;
+
+  const std::string game_id = disc->GetGameID();
+  if (game_id.empty())
+    return;
+
+  m_prefetch_disc = DiscIO::CreateVolume(disc->GetBlobReader().CopyReader());
+  if (!m_prefetch_disc)
+    return;
+
+  m_history_path = File::GetUserPath(D_CACHE_IDX) +
+                   fmt::format("{}_{}.dvdhistory", game_id, disc->GetDiscNumber().value_or(0));
+  LoadHistory();
+
+  m_prefetch_thread.Reset("DVD Prefetch", std::bind_front(&DVDPrefetcher::PrefetchFile, this));
+  m_enabled = true;
+}
+
+void DVDPrefetcher::OnRead(const DiscIO::Volume& disc, const DiscIO::Partition& partition,
+                           u64 offset)
+{
+  if (!m_enabled)
+    return;
+
+  const DiscIO::FileSystem* file_system = disc.GetFileSystem(partition);
+  if (!file_system)
+    return;
+
+  const std::unique_ptr<DiscIO::FileInfo> file_info = file_system->FindFileInfo(offset);
+  if (!file_info)
+    return;
+
+  const FileAccess file{partition.offset, file_info->GetOffset(), file_info->GetSize()};
+  if (file == m_previous_file)
+    return;
+  m_previous_file = file;
+
+  // Only the first read of each file is recorded and used for predictions.
+  if (!m_recorded_files.insert(file).second)
+    return;
+  m_recording.push_back(file);
+
+  {
+    std::lock_guard lk(m_prefetched_lock);
+    const auto it = m_prefetched_files.find(file);
+    if (it != m_prefetched_files.end() && !it->second.hit)
+    {
+      it->second.hit = true;
+      ++m_stats.prefetch_hits;
+      m_stats.io_time_avoided += it->second.read_time;
+    }
+  }
+
+  const auto it = m_history_index.find(file);
+  if (it == m_history_index.end())
+    return;
+
+  const size_t end = std::min<size_t>(m_history.size(), it->second + 1 + PREFETCH_DISTANCE);
+  for (size_t i = it->second + 1; i < end; ++i)
+  {
+    const FileAccess& next_file = m_history[i];
+    if (m_recorded_files.contains(next_file) || !m_queued_files.insert(next_file).second)
+      continue;
+
+    m_prefetch_thread.Push(next_file);
+  }
+}
+
+DVDPrefetcher::Stats DVDPrefetcher::GetStats() const
+{
+  std::lock_guard lk(m_prefetched_lock);
+  return m_stats;
+}
+
+void DVDPrefetcher::LoadHistory()
+{
+  File::IOFile file(m_history_path, "rb");
+  u32 magic;
+  u32 version;
+  if (!file.ReadArray(&magic, 1) || !file.ReadArray(&version, 1) || magic != HISTORY_FILE_MAGIC ||
+      version != HISTORY_FILE_VERSION)
+  {
+    return;
+  }
+
+  FileAccess entry;
+  while (file.ReadArray(&entry, 1))
+  {
+    if (m_history_index.try_emplace(entry, m_history.size()).second)
+      m_history.push_back(entry);
+  }
+
+  INFO_LOG_FMT(DVDINTERFACE, "Loaded DVD access history of {} files from {}", m_history.size(),
+               m_history_path);
+}
+
+void DVDPrefetcher::SaveHistory()
+{
+  if (m_recording.empty())
+    return;
+
+  // Files which weren't read this time, e.g. because the session was short, are kept after the
+  // ones that were.
+  std::vector<FileAccess> history = m_recording;
+  for (const FileAccess& entry : m_history)
+  {
+    if (!m_recorded_files.contains(entry))
+      history.push_back(entry);
+  }
+
+  File::IOFile file(m_history_path, "wb");
+  if (!file.WriteArray(&HISTORY_FILE_MAGIC, 1) || !file.WriteArray(&HISTORY_FILE_VERSION, 1) ||
+      !file.WriteArray(history.data(), history.size()))
+  {
+    WARN_LOG_FMT(DVDINTERFACE, "Failed to write DVD access history to {}", m_history_path);
+  }
+}
+
+void DVDPrefetcher::PrefetchFile(FileAccess file)
+{
+  const TimePoint start_time = Clock::now();
+
+  const DiscIO::Partition partition(file.partition_offset);
+  const u64 size = std::min(file.file_size, MAX_PREFETCH_SIZE);
+  std::vector<u8> buffer(std::min(size, PREFETCH_BLOCK_SIZE));
+  for (u64 position = 0; position < size; position += buffer.size())
+  {
+    const u64 read_size = std::min<u64>(buffer.size(), size - position);
+    if (!m_prefetch_disc->Read(file.file_offset + position, read_size, buffer.data(), partition))
+      return;
+  }
+
+  std::lock_guard lk(m_prefetched_lock);
+  m_prefetched_files[file].read_time = Clock::now() - start_time;
+  ++m_stats.files_prefetched;
+  m_stats.bytes_prefetched += size;
+}
+}  // namespace DVD
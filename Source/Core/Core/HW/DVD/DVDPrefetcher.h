@@ -0,0 +1,103 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
+
+namespace DiscIO
+{
+struct Partition;
+class Volume;
+}  // namespace DiscIO
+
+namespace DVD
+{
+// Records the order in which a game reads files from the disc, and on later boots reads the files
+// that followed the file the game is reading now ahead of time on a separate thread. This only
+// warms host-side caches (the OS file cache, CachedBlobReader) so that the DVD thread spends less
+// time waiting for the host. Emulated DVD timing is unaffected.
+class DVDPrefetcher
+{
+public:
+  struct Stats
+  {
+    u64 files_prefetched = 0;
+    u64 bytes_prefetched = 0;
+    // Prefetched files which the game read after they had been prefetched.
+    u64 prefetch_hits = 0;
+    // Host time spent reading those files on the prefetch thread instead of the DVD thread.
+    DT io_time_avoided{};
+  };
+
+  DVDPrefetcher();
+  DVDPrefetcher(const DVDPrefetcher&) = delete;
+  DVDPrefetcher(DVDPrefetcher&&) = delete;
+  DVDPrefetcher& operator=(const DVDPrefetcher&) = delete;
+  DVDPrefetcher& operator=(DVDPrefetcher&&) = delete;
+  ~DVDPrefetcher();
+
+  // Saves the access history of the previous disc, and starts prefetching for the new one if
+  // prefetching is enabled. Must not be called while the DVD thread is reading.
+  void SetDisc(const DiscIO::Volume* disc);
+
+  // Called on the DVD thread for every read that the game makes.
+  void OnRead(const DiscIO::Volume& disc, const DiscIO::Partition& partition, u64 offset);
+
+  Stats GetStats() const;
+
+private:
+  struct FileAccess
+  {
+    u64 partition_offset;
+    u64 file_offset;
+    u64 file_size;
+
+    bool operator<(const FileAccess& other) const;
+    bool operator==(const FileAccess& other) const;
+  };
+
+  void LoadHistory();
+  void SaveHistory();
+  void PrefetchFile(FileAccess file);
+
+  static constexpr u32 PREFETCH_DISTANCE = 4;
+  static constexpr u64 MAX_PREFETCH_SIZE = 32 * 1024 * 1024;
+
+  bool m_enabled = false;
+  std::string m_history_path;
+
+  // The files read in the previous session, in the order they were first read, and the position
+  // of each file in that order.
+  std::vector<FileAccess> m_history;
+  std::map<FileAccess, size_t> m_history_index;
+
+  // Only accessed on the DVD thread while a disc is set.
+  std::vector<FileAccess> m_recording;
+  std::set<FileAccess> m_recorded_files;
+  std::set<FileAccess> m_queued_files;
+  FileAccess m_previous_file{};
+
+  // Reads through its own copy of the disc, so the DVD thread never has to wait for it.
+  std::unique_ptr<DiscIO::Volume> m_prefetch_disc;
+  Common::WorkQueueThreadSP<FileAccess> m_prefetch_thread;
+
+  // Prefetched files and how long it took to read them, and whether the game has read them since.
+  struct PrefetchedFile
+  {
+    DT read_time{};
+    bool hit = false;
+  };
+  mutable std::mutex m_prefetched_lock;
+  std::map<FileAccess, PrefetchedFile> m_prefetched_files;
+  Stats m_stats;
+};
+}  // namespace DVD
@@ -6,6 +6,7 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -20,6 +21,7 @@
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/DVD/DVDInterface.h"
+#include "Core/HW/DVD/DVDPrefetcher.h"
 #include "Core/HW/DVD/FileMonitor.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
@@ -56,6 +58,7 @@ void DVDThread::Stop()
   m_result_queue.Clear();
   m_result_map.clear();
 
+  m_prefetcher.SetDisc(nullptr);
   m_disc.reset();
 }
 
@@ -69,9 +72,27 @@ void DVDThread::DoState(PointerWrap& p)
   // This won't affect the behavior of FinishRead.
   ReadResult result;
   while (m_result_queue.Pop(result))
-    m_result_map.emplace(result.first.id, std::move(result));
+    m_result_map.emplace(result.request.id, std::move(result));
+
+  // Views into the disc image can't be savestated, so their data is copied into buffers. Results
+  // are stored as pairs of request and buffer, like they were before views existed.
+  std::map<u64, std::pair<ReadRequest, std::vector<u8>>> saved_results;
+  for (auto& [id, saved_result] : m_result_map)
+  {
+    if (saved_result.view)
+    {
+      const u8* data = saved_result.view.get();
+      saved_result.buffer.assign(data, data + saved_result.request.length);
+    }
+    saved_results.emplace(id, std::pair(saved_result.request, std::move(saved_result.buffer)));
+  }
+
+  p.Do(saved_results);
+
+  m_result_map.clear();
+  for (auto& [id, saved_result] : saved_results)
+    m_result_map.emplace(id, ReadResult{saved_result.first, std::move(saved_result.second), {}});
 
-  p.Do(m_result_map);
   p.Do(m_next_id);
 
   // m_disc isn't savestated (because it points to files on the
@@ -86,7 +107,7 @@ void DVDThread::DoState(PointerWrap& p)
     if (had_disc)
       PanicAlertFmtT("An inserted disc was expected but not found.");
     else
-      m_disc.reset();
+      SetDisc(nullptr);
   }
 
   // TODO: Savestates can be smaller if the buffers of results aren't saved,
@@ -103,6 +124,7 @@ void DVDThread::DoState(PointerWrap& p)
 void DVDThread::SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
+  m_prefetcher.SetDisc(disc.get());
   m_disc = std::move(disc);
 }
 
@@ -248,16 +270,17 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
     {
       m_result_queue.WaitForData();
       m_result_queue.Pop(result);
-      if (result.first.id == id)
+      if (result.request.id == id)
         break;
 
-      m_result_map.emplace(result.first.id, std::move(result));
+      m_result_map.emplace(result.request.id, std::move(result));
     }
   }
   // We have now obtained the right ReadResult.
 
-  const ReadRequest& request = result.first;
-  const std::vector<u8>& buffer = result.second;
+  const ReadRequest& request = result.request;
+  const std::span<const u8> data =
+      result.view ? std::span<const u8>(result.view.get(), request.length) : result.buffer;
 
   DEBUG_LOG_FMT(DVDINTERFACE,
                 "Disc has been read. Real time: {} us. "
@@ -270,7 +293,7 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
 
   auto& dvd_interface = m_system.GetDVDInterface();
   DVD::DIInterruptType interrupt;
-  if (buffer.size() != request.length)
+  if (data.size() != request.length)
   {
     PanicAlertFmtT("The disc could not be read (at {0:#x} - {1:#x}).", request.dvd_offset,
                    request.dvd_offset + request.length);
@@ -283,26 +306,38 @@ void DVDThread::FinishRead(u64 id, s64 cycles_late)
     if (request.copy_to_ram)
     {
       auto& memory = m_system.GetMemory();
-      memory.CopyToEmu(request.output_address, buffer.data(), request.length);
+      memory.CopyToEmu(request.output_address, data.data(), request.length);
     }
 
     interrupt = DVD::DIInterruptType::TCINT;
   }
 
   // Notify the emulated software that the command has been executed
-  dvd_interface.FinishExecutingCommand(request.reply_type, interrupt, cycles_late, buffer);
+  dvd_interface.FinishExecutingCommand(request.reply_type, interrupt, cycles_late, data);
 }
 
 void DVDThread::ProcessReadRequest(ReadRequest&& request)
 {
   m_file_logger.Log(*m_disc, request.partition, request.dvd_offset);
+  m_prefetcher.OnRead(*m_disc, request.partition, request.dvd_offset);
+
+  ReadResult result;
 
-  std::vector<u8> buffer(request.length);
-  if (!m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-    buffer.resize(0);
+  // Data that goes straight into emulated RAM can be copied there from the disc image, saving a
+  // copy through an intermediate buffer.
+  if (request.copy_to_ram)
+    result.view = m_disc->ReadView(request.dvd_offset, request.length, request.partition);
+
+  if (!result.view)
+  {
+    result.buffer.resize(request.length);
+    if (!m_disc->Read(request.dvd_offset, request.length, result.buffer.data(), request.partition))
+      result.buffer.resize(0);
+  }
 
   request.realtime_done_us = Common::Timer::NowUs();
+  result.request = std::move(request);
 
-  m_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
+  m_result_queue.Push(std::move(result));
 }
 }  // namespace DVD
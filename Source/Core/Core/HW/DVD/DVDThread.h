@@ -14,6 +14,7 @@
 
 #include "Common/WorkQueueThread.h"
 #include "Core/HW/DVD/DVDInterface.h"
+#include "Core/HW/DVD/DVDPrefetcher.h"
 #include "Core/HW/DVD/FileMonitor.h"
 
 #include "DiscIO/Volume.h"
@@ -120,7 +121,13 @@ private:
 
   void ProcessReadRequest(ReadRequest&& read_request);
 
-  using ReadResult = std::pair<ReadRequest, std::vector<u8>>;
+  struct ReadResult
+  {
+    ReadRequest request;
+    // Holds the data, unless the disc could hand it out without copying it (see view).
+    std::vector<u8> buffer;
+    std::shared_ptr<const u8> view;
+  };
 
   CoreTiming::EventType* m_finish_read = nullptr;
 
@@ -134,6 +141,7 @@ private:
   std::unique_ptr<DiscIO::Volume> m_disc;
 
   FileMonitor::FileLogger m_file_logger;
+  DVDPrefetcher m_prefetcher;
 
   Core::System& m_system;
 };
@@ -14,6 +14,7 @@
 #include "Common/MsgHandler.h"
 
 #include "DiscIO/CISOBlob.h"
+#include "DiscIO/ChunkStoreBlob.h"
 #include "DiscIO/CompressedBlob.h"
 #include "DiscIO/DirectoryBlob.h"
 #include "DiscIO/FileBlob.h"
@@ -55,6 +56,8 @@ std::string GetName(BlobType blob_type, bool translate)
     return "NFS";
   case BlobType::SPLIT_PLAIN:
     return translate_str("Multi-part ISO");
+  case BlobType::CHUNK_STORE:
+    return translate_str("Chunk Store");
   default:
     return "";
   }
@@ -241,6 +244,8 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
     return RVZFileReader::Create(std::move(file), filename);
   case NFS_MAGIC:
     return NFSFileReader::Create(std::move(file), filename);
+  case CHUNK_STORE_IMAGE_MAGIC:
+    return ChunkStoreFileReader::Create(std::move(file), filename);
   default:
     if (auto directory_blob = DirectoryBlobReader::Create(filename))
       return std::move(directory_blob);
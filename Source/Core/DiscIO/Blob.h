@@ -42,6 +42,7 @@ enum class BlobType
   MOD_DESCRIPTOR,
   NFS,
   SPLIT_PLAIN,
+  CHUNK_STORE,
 };
 
 // If you convert an ISO file to another format and then call GetDataSize on it, what is the result?
@@ -87,6 +88,11 @@ public:
     return Common::FromBigEndian(temp);
   }
 
+  // Returns the requested data without copying it, or nullptr if this reader can't do that, in
+  // which case Read has to be used instead. The returned pointer keeps the data alive.
+  // NOT thread-safe - can't call this from multiple threads.
+  virtual std::shared_ptr<const u8> ReadView(u64 offset, u64 size) { return nullptr; }
+
   virtual bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const
   {
     return false;
@@ -5,8 +5,14 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
 #include <thread>
+#include <utility>
+#include <vector>
 
+#include "Common/Align.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
@@ -20,7 +26,10 @@ class CacheFiller final
 {
 public:
   explicit CacheFiller(std::unique_ptr<BlobReader> reader, bool attempt_to_scrub)
-      : m_thread{&CacheFiller::ThreadFunc, this, std::move(reader), attempt_to_scrub}
+      : m_cluster_count{Common::AlignUp(reader->GetDataSize(), DiscScrubber::CLUSTER_SIZE) /
+                        DiscScrubber::CLUSTER_SIZE},
+        m_cluster_filled(m_cluster_count),
+        m_thread{&CacheFiller::ThreadFunc, this, std::move(reader), attempt_to_scrub}
   {
   }
 
@@ -28,6 +37,15 @@ public:
   {
     m_stop_thread.store(true, std::memory_order_relaxed);
     m_thread.join();
+
+    const u64 waited_reads = m_waited_reads.load(std::memory_order_relaxed);
+    INFO_LOG_FMT(DISCIO,
+                 "CachedBlobReader: {} reads were cached, {} waited for a total of {} ms "
+                 "(max {} ms), {} were not cached.",
+                 m_cached_reads.load(std::memory_order_relaxed), waited_reads,
+                 ToMilliseconds(m_total_wait.load(std::memory_order_relaxed)),
+                 ToMilliseconds(m_max_wait.load(std::memory_order_relaxed)),
+                 m_uncached_reads.load(std::memory_order_relaxed));
   }
 
   bool Read(u64 offset, u64 size, u8* out_ptr)
@@ -35,53 +53,130 @@ public:
     if (size == 0)
     {
       // Just return early to safely handle a read of zero if that were to happen.
-      // This avoids a m_memory_region_data initialization race.
       return true;
     }
 
-    switch (GetCacheState(offset, size))
+    // Reads are passed on to the underlying reader until the filler thread has set up the memory
+    // region and the scrubber.
+    if (!m_ready.load(std::memory_order_acquire))
     {
-    case CacheState::Cached:
-      std::memcpy(out_ptr, m_memory_region_data + offset, size);
-      return true;
+      m_uncached_reads.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
 
-    case CacheState::Scrubbed:
-      WARN_LOG_FMT(DISCIO,
-                   "CachedBlobReader: Read({}, {}) hits a scrubbed cluster which is not cached.",
-                   offset, size);
+    const u64 first_cluster = offset / DiscScrubber::CLUSTER_SIZE;
+    const u64 end_cluster = (offset + size - 1) / DiscScrubber::CLUSTER_SIZE + 1;
+    if (end_cluster > m_cluster_count)
       return false;
 
-    default:
+    for (u64 i = first_cluster; i < end_cluster; ++i)
+    {
+      if (m_scrubber.CanBlockBeScrubbed(i * DiscScrubber::CLUSTER_SIZE))
+      {
+        WARN_LOG_FMT(DISCIO,
+                     "CachedBlobReader: Read({}, {}) hits a scrubbed cluster which is not cached.",
+                     offset, size);
+        m_uncached_reads.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    }
+
+    if (IsFilled(first_cluster, end_cluster))
+    {
+      m_cached_reads.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (!WaitForClusters(first_cluster, end_cluster))
+    {
+      m_uncached_reads.fetch_add(1, std::memory_order_relaxed);
       return false;
     }
+
+    std::memcpy(out_ptr, m_memory_region_data + offset, size);
+    return true;
   }
 
 private:
-  enum class CacheState
+  static double ToMilliseconds(DT::rep ticks) { return DT_ms{DT{ticks}}.count(); }
+
+  bool IsFilled(u64 first_cluster, u64 end_cluster) const
   {
-    Cached,
-    NotCached,
-    Scrubbed,
-  };
+    for (u64 i = first_cluster; i < end_cluster; ++i)
+    {
+      if (!m_cluster_filled[i].load(std::memory_order_acquire))
+        return false;
+    }
+    return true;
+  }
 
-  CacheState GetCacheState(u64 offset, u64 size)
+  // Makes the filler thread continue from the first cluster of the read that isn't filled yet,
+  // and waits until the whole read is filled. Returns false if the filler thread stopped first.
+  bool WaitForClusters(u64 first_cluster, u64 end_cluster)
   {
-    const auto cache_pos = m_cache_filled_pos.load(std::memory_order_acquire);
+    const TimePoint wait_start = Clock::now();
 
-    const auto end_pos = offset + size;
-    if (end_pos > cache_pos)
-      return CacheState::NotCached;
+    u64 requested_cluster = first_cluster;
+    while (requested_cluster + 1 < end_cluster &&
+           m_cluster_filled[requested_cluster].load(std::memory_order_acquire))
+    {
+      ++requested_cluster;
+    }
 
-    for (u64 i = offset; i < end_pos; i += DiscScrubber::CLUSTER_SIZE)
+    bool filled;
     {
-      if (m_scrubber.CanBlockBeScrubbed(i))
-        return CacheState::Scrubbed;
+      std::unique_lock lock{m_fill_mutex};
+      m_requested_cluster = requested_cluster;
+      ++m_waiting_readers;
+      m_cluster_filled_event.wait(lock, [&] {
+        return m_filler_stopped || IsFilled(requested_cluster, end_cluster);
+      });
+      --m_waiting_readers;
+      filled = IsFilled(requested_cluster, end_cluster);
     }
 
-    return CacheState::Cached;
+    if (!filled)
+      return false;
+
+    const DT::rep wait_ticks = (Clock::now() - wait_start).count();
+    m_waited_reads.fetch_add(1, std::memory_order_relaxed);
+    m_total_wait.fetch_add(wait_ticks, std::memory_order_relaxed);
+    DT::rep max_wait = m_max_wait.load(std::memory_order_relaxed);
+    while (wait_ticks > max_wait &&
+           !m_max_wait.compare_exchange_weak(max_wait, wait_ticks, std::memory_order_relaxed))
+    {
+    }
+    return true;
+  }
+
+  // Returns the cluster a reader is waiting for, if any.
+  std::optional<u64> TakeRequestedCluster()
+  {
+    std::lock_guard lock{m_fill_mutex};
+    return std::exchange(m_requested_cluster, std::nullopt);
+  }
+
+  void MarkClusterFilled(u64 cluster)
+  {
+    m_cluster_filled[cluster].store(true, std::memory_order_release);
+
+    std::lock_guard lock{m_fill_mutex};
+    if (m_waiting_readers != 0)
+      m_cluster_filled_event.notify_all();
+  }
+
+  void StopFilling()
+  {
+    std::lock_guard lock{m_fill_mutex};
+    m_filler_stopped = true;
+    m_cluster_filled_event.notify_all();
   }
 
   void ThreadFunc(std::unique_ptr<BlobReader> reader, bool attempt_to_scrub)
+  {
+    FillCache(std::move(reader), attempt_to_scrub);
+    StopFilling();
+  }
+
+  void FillCache(std::unique_ptr<BlobReader> reader, bool attempt_to_scrub)
   {
     static constexpr auto PERIODIC_LOG_TIME = std::chrono::seconds{1};
 
@@ -120,46 +215,61 @@ private:
       }
     }
 
+    m_ready.store(true, std::memory_order_release);
+
     auto next_log_time = start_time + PERIODIC_LOG_TIME;
-    u64 read_offset = 0;
     u64 committed_count = 0;
-
-    while (true)
+    u64 clusters_visited = 0;
+    u64 jumps = 0;
+
+    // Clusters are filled front to back, except that whenever a read has to wait for the cache,
+    // filling continues from the cluster it is waiting for. Files are mostly stored contiguously,
+    // so this keeps filling the rest of the file the game is loading. Skipped clusters are filled
+    // after wrapping around at the end.
+    u64 cluster = 0;
+    while (clusters_visited < m_cluster_count)
     {
       if (m_stop_thread.load(std::memory_order_relaxed))
       {
         INFO_LOG_FMT(DISCIO, "CachedBlobReader: Stopped");
-        break;
+        return;
       }
 
-      const auto read_size = get_read_size(read_offset);
-      if (read_size == 0)
+      if (const std::optional<u64> requested_cluster = TakeRequestedCluster())
       {
-        const auto total_time = DT_s{Clock::now() - start_time}.count();
-
-        static constexpr auto mib_scale = double(1 << 20);
+        cluster = *requested_cluster;
+        ++jumps;
+      }
 
-        NOTICE_LOG_FMT(
-            DISCIO, "CachedBlobReader: Completed. Cached {:.2f} of {:.2f} MiB in {:.2f} seconds.",
-            committed_count / mib_scale, total_size / mib_scale, total_time);
-        break;
+      // Find the next cluster which still needs to be handled, wrapping around at the end.
+      while (m_cluster_filled[cluster].load(std::memory_order_relaxed) ||
+             m_cluster_skipped[cluster])
+      {
+        cluster = (cluster + 1) % m_cluster_count;
       }
 
-      if (!m_scrubber.CanBlockBeScrubbed(read_offset))
+      const u64 read_offset = cluster * DiscScrubber::CLUSTER_SIZE;
+      const auto read_size = get_read_size(read_offset);
+      if (m_scrubber.CanBlockBeScrubbed(read_offset))
+      {
+        m_cluster_skipped[cluster] = true;
+      }
+      else
       {
         m_memory_region.EnsureMemoryPagesWritable(read_offset, read_size);
 
         if (!reader->Read(read_offset, read_size, m_memory_region_data + read_offset))
         {
           ERROR_LOG_FMT(DISCIO, "CachedBlobReader: Read({}, {}) failed.", read_offset, read_size);
-          break;
+          return;
         }
 
         committed_count += read_size;
+        MarkClusterFilled(cluster);
       }
 
-      read_offset += read_size;
-      m_cache_filled_pos.store(read_offset, std::memory_order_release);
+      ++clusters_visited;
+      cluster = (cluster + 1) % m_cluster_count;
 
       if (const auto now = Clock::now(); now >= next_log_time)
       {
@@ -168,16 +278,48 @@ private:
         next_log_time = now + PERIODIC_LOG_TIME;
       }
     }
+
+    const auto total_time = DT_s{Clock::now() - start_time}.count();
+
+    static constexpr auto mib_scale = double(1 << 20);
+
+    NOTICE_LOG_FMT(DISCIO,
+                   "CachedBlobReader: Completed. Cached {:.2f} of {:.2f} MiB in {:.2f} seconds, "
+                   "jumping to requested clusters {} times.",
+                   committed_count / mib_scale, total_size / mib_scale, total_time, jumps);
   }
 
-  // The thread has read non-scrubbed bytes into memory up to this point.
-  std::atomic<u64> m_cache_filled_pos{};
+  const u64 m_cluster_count;
+
+  // Set by the filler thread for each cluster once its data is in the memory region.
+  std::vector<std::atomic<bool>> m_cluster_filled;
+
+  // Scrubbed clusters which the filler thread has passed. Only used by the filler thread.
+  std::vector<bool> m_cluster_skipped = std::vector<bool>(m_cluster_count);
+
+  // Set once the memory region and the scrubber are ready to be used by readers.
+  std::atomic_bool m_ready{};
 
   Common::LazyMemoryRegion m_memory_region;
   u8* m_memory_region_data{};
 
   DiscScrubber m_scrubber;
 
+  // Protects the requests from readers to the filler thread.
+  std::mutex m_fill_mutex;
+  std::condition_variable m_cluster_filled_event;
+  std::optional<u64> m_requested_cluster;
+  u32 m_waiting_readers = 0;
+  bool m_filler_stopped = false;
+
+  // Reads which were cached right away, had to wait for the filler thread, or were passed on
+  // to the underlying reader.
+  std::atomic<u64> m_cached_reads{};
+  std::atomic<u64> m_waited_reads{};
+  std::atomic<u64> m_uncached_reads{};
+  std::atomic<DT::rep> m_total_wait{};
+  std::atomic<DT::rep> m_max_wait{};
+
   std::atomic_bool m_stop_thread{};
   std::thread m_thread;
 };
@@ -0,0 +1,289 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/ChunkStore.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/file.h>
+#endif
+
+#include <zstd.h>
+
+#include "Common/BitUtils.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/Random.h"
+
+namespace DiscIO
+{
+std::string GetChunkStoreDataPath(const std::string& directory)
+{
+  return directory + "/chunks.bin";
+}
+
+std::string GetChunkStoreIndexPath(const std::string& directory)
+{
+  return directory + "/index.bin";
+}
+
+static std::string GetLockPath(const std::string& directory)
+{
+  return directory + "/lock";
+}
+
+// The lock is released when the file is closed, including when the process exits.
+static bool TryLockFile(const File::DirectIOFile& file)
+{
+#if defined(_WIN32)
+  OVERLAPPED overlapped{};
+  return LockFileEx(file.GetHandle(), LOCKFILE_EXCLUSIVE_LOCK | LOCKFILE_FAIL_IMMEDIATELY, 0, 1,
+                    0, &overlapped) != 0;
+#else
+  return flock(file.GetHandle(), LOCK_EX | LOCK_NB) == 0;
+#endif
+}
+
+static bool ReadHeader(File::DirectIOFile& file, u32 magic, ChunkStoreID* id)
+{
+  ChunkStoreFileHeader header;
+  if (!file.OffsetRead(0, Common::AsWritableU8Span(header)) || header.magic != magic)
+    return false;
+
+  if (header.version != CHUNK_STORE_VERSION)
+  {
+    ERROR_LOG_FMT(DISCIO, "Chunk store has unsupported version {}", header.version);
+    return false;
+  }
+
+  *id = header.id;
+  return true;
+}
+
+File::DirectIOFile OpenChunkStoreData(const std::string& directory, ChunkStoreID* id)
+{
+  File::DirectIOFile file(GetChunkStoreDataPath(directory), File::AccessMode::Read);
+  if (file.IsOpen() && !ReadHeader(file, CHUNK_STORE_DATA_MAGIC, id))
+    file.Close();
+  return file;
+}
+
+bool DecodeChunkStoreChunk(const ChunkStoreEntry& entry, const u8* stored_data, std::span<u8> out)
+{
+  if ((entry.flags & CHUNK_STORE_FLAG_COMPRESSED) == 0)
+  {
+    if (entry.stored_size != out.size())
+      return false;
+    std::memcpy(out.data(), stored_data, out.size());
+    return true;
+  }
+
+  const size_t result = ZSTD_decompress(out.data(), out.size(), stored_data, entry.stored_size);
+  if (ZSTD_isError(result) || result != out.size())
+  {
+    ERROR_LOG_FMT(DISCIO, "Chunk store chunk at {:#x} could not be decompressed", entry.offset);
+    return false;
+  }
+  return true;
+}
+
+ChunkStore::ChunkStore(std::string directory) : m_directory(std::move(directory))
+{
+}
+
+ChunkStore::~ChunkStore()
+{
+  if (m_data_file.IsOpen() && m_index_file.IsOpen())
+    Flush();
+}
+
+std::unique_ptr<ChunkStore> ChunkStore::Open(const std::string& directory)
+{
+  std::unique_ptr<ChunkStore> store(new ChunkStore(directory));
+
+  if (!File::IsDirectory(directory) && !File::CreateFullPath(directory + '/'))
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to create chunk store directory {}", directory);
+    return nullptr;
+  }
+
+  if (!store->m_lock_file.Open(GetLockPath(directory), File::AccessMode::ReadAndWrite,
+                               File::OpenMode::Always))
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to create the lock file of the chunk store in {}", directory);
+    return nullptr;
+  }
+  if (!TryLockFile(store->m_lock_file))
+  {
+    ERROR_LOG_FMT(DISCIO, "The chunk store in {} is in use by another process", directory);
+    return nullptr;
+  }
+
+  const bool exists = File::Exists(GetChunkStoreIndexPath(directory));
+  if (exists ? !store->Load() : !store->Create())
+    return nullptr;
+
+  return store;
+}
+
+bool ChunkStore::Create()
+{
+  Common::Random::Generate(m_id.data(), m_id.size());
+
+  m_data_file.Open(GetChunkStoreDataPath(m_directory), File::AccessMode::ReadAndWrite,
+                   File::OpenMode::Truncate);
+  m_index_file.Open(GetChunkStoreIndexPath(m_directory), File::AccessMode::ReadAndWrite,
+                    File::OpenMode::Truncate);
+  if (!m_data_file.IsOpen() || !m_index_file.IsOpen())
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to create chunk store in {}", m_directory);
+    return false;
+  }
+
+  ChunkStoreFileHeader header{CHUNK_STORE_DATA_MAGIC, CHUNK_STORE_VERSION, m_id};
+  if (!m_data_file.OffsetWrite(0, Common::AsU8Span(header)))
+    return false;
+
+  // The index header goes last, so that a store whose creation was interrupted isn't loaded.
+  header.magic = CHUNK_STORE_INDEX_MAGIC;
+  if (!m_index_file.OffsetWrite(0, Common::AsU8Span(header)))
+    return false;
+
+  m_data_end = sizeof(ChunkStoreFileHeader);
+  m_index_end = sizeof(ChunkStoreFileHeader);
+  return true;
+}
+
+bool ChunkStore::Load()
+{
+  m_data_file.Open(GetChunkStoreDataPath(m_directory), File::AccessMode::ReadAndWrite,
+                   File::OpenMode::Existing);
+  m_index_file.Open(GetChunkStoreIndexPath(m_directory), File::AccessMode::ReadAndWrite,
+                    File::OpenMode::Existing);
+
+  ChunkStoreID data_id;
+  if (!m_data_file.IsOpen() || !m_index_file.IsOpen() ||
+      !ReadHeader(m_data_file, CHUNK_STORE_DATA_MAGIC, &data_id) ||
+      !ReadHeader(m_index_file, CHUNK_STORE_INDEX_MAGIC, &m_id) || data_id != m_id)
+  {
+    ERROR_LOG_FMT(DISCIO, "{} does not contain a valid chunk store", m_directory);
+    return false;
+  }
+
+  // A partially written entry at the end means that flushing was interrupted. The chunk isn't
+  // referenced by anything yet, so it is simply forgotten.
+  const u64 entry_count =
+      (m_index_file.GetSize() - sizeof(ChunkStoreFileHeader)) / sizeof(ChunkStoreEntry);
+  std::vector<ChunkStoreEntry> entries(entry_count);
+  if (!m_index_file.OffsetRead(sizeof(ChunkStoreFileHeader), Common::AsWritableU8Span(entries)))
+    return false;
+
+  m_data_end = sizeof(ChunkStoreFileHeader);
+  m_entries.reserve(entries.size());
+  for (const ChunkStoreEntry& entry : entries)
+  {
+    m_entries.emplace(entry.hash, entry);
+    m_data_end = std::max(m_data_end, entry.offset + entry.stored_size);
+  }
+
+  const u64 data_file_size = m_data_file.GetSize();
+  if (data_file_size < m_data_end)
+  {
+    ERROR_LOG_FMT(DISCIO, "The data file of the chunk store in {} has been truncated",
+                  m_directory);
+    return false;
+  }
+
+  // Likewise, drop chunk data that never made it into the index. Index entries are only written
+  // once the data they point to has been flushed, so the data of every entry is intact.
+  m_index_end = sizeof(ChunkStoreFileHeader) + entry_count * sizeof(ChunkStoreEntry);
+  if ((m_index_file.GetSize() != m_index_end && !File::Resize(m_index_file, m_index_end)) ||
+      (data_file_size != m_data_end && !File::Resize(m_data_file, m_data_end)))
+  {
+    return false;
+  }
+
+  return true;
+}
+
+u64 ChunkStore::GetChunkCount() const
+{
+  std::lock_guard lk(m_lock);
+  return m_entries.size();
+}
+
+u64 ChunkStore::GetDataFileSize() const
+{
+  std::lock_guard lk(m_lock);
+  return m_data_end;
+}
+
+std::optional<ChunkStoreEntry> ChunkStore::Find(const Common::SHA1::Digest& hash) const
+{
+  std::lock_guard lk(m_lock);
+  const auto it = m_entries.find(hash);
+  if (it == m_entries.end())
+    return std::nullopt;
+  return it->second;
+}
+
+std::optional<ChunkStoreEntry> ChunkStore::Add(const Common::SHA1::Digest& hash,
+                                               std::span<const u8> stored_data, u32 flags,
+                                               bool* added)
+{
+  std::lock_guard lk(m_lock);
+
+  if (added)
+    *added = false;
+
+  const auto it = m_entries.find(hash);
+  if (it != m_entries.end())
+    return it->second;
+
+  const ChunkStoreEntry entry{hash, m_data_end, static_cast<u32>(stored_data.size()), flags};
+
+  // The index entry is written by Flush, after the data has reached the disk. Until then, an
+  // interrupted write leaves at most some data behind that nothing refers to.
+  if (!m_data_file.OffsetWrite(m_data_end, stored_data))
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to write to the chunk store in {}", m_directory);
+    return std::nullopt;
+  }
+
+  m_data_end += stored_data.size();
+  m_entries.emplace(hash, entry);
+  m_unindexed_entries.push_back(entry);
+
+  if (added)
+    *added = true;
+  return entry;
+}
+
+bool ChunkStore::Flush()
+{
+  std::lock_guard lk(m_lock);
+
+  if (!m_data_file.Flush())
+    return false;
+
+  if (!m_unindexed_entries.empty())
+  {
+    if (!m_index_file.OffsetWrite(m_index_end, Common::AsU8Span(m_unindexed_entries)))
+    {
+      ERROR_LOG_FMT(DISCIO, "Failed to write to the chunk store in {}", m_directory);
+      return false;
+    }
+    m_index_end += m_unindexed_entries.size() * sizeof(ChunkStoreEntry);
+    m_unindexed_entries.clear();
+  }
+
+  return m_index_file.Flush();
+}
+
+}  // namespace DiscIO
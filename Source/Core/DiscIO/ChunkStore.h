@@ -0,0 +1,136 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/DirectIOFile.h"
+
+namespace DiscIO
+{
+// A chunk store is a directory holding chunks of disc data which are shared between any number of
+// disc images, so that data which several discs have in common (other discs of the same game,
+// other regions of it, the update partitions of Wii discs...) only takes up space once.
+//
+// Chunks are identified by the SHA-1 of their uncompressed data. The store consists of a data
+// file that chunks are appended to and an index file that maps each hash to where the chunk is.
+// Nothing is ever removed from a store, so locations stay valid once they have been handed out.
+
+static constexpr u32 CHUNK_STORE_DATA_MAGIC = 0x44534344;   // "DCSD" (byteswapped to little endian)
+static constexpr u32 CHUNK_STORE_INDEX_MAGIC = 0x49534344;  // "DCSI" (byteswapped to little endian)
+static constexpr u32 CHUNK_STORE_VERSION = 1;
+
+static constexpr u32 CHUNK_STORE_FLAG_COMPRESSED = 1;
+
+using ChunkStoreID = std::array<u8, 16>;
+
+// Blobs created by Dolphin are always little endian
+#pragma pack(push, 1)
+struct ChunkStoreFileHeader
+{
+  u32 magic;
+  u32 version;
+  // Random bytes identifying the store, so that images can't be read from the wrong store.
+  ChunkStoreID id;
+};
+static_assert(sizeof(ChunkStoreFileHeader) == 24);
+
+struct ChunkStoreEntry
+{
+  Common::SHA1::Digest hash;
+  // Offset of the stored chunk in the data file.
+  u64 offset;
+  u32 stored_size;
+  u32 flags;
+};
+static_assert(sizeof(ChunkStoreEntry) == 36);
+#pragma pack(pop)
+
+std::string GetChunkStoreDataPath(const std::string& directory);
+std::string GetChunkStoreIndexPath(const std::string& directory);
+
+// Opens the data file of a store for reading. Returns a closed file if it isn't a valid store.
+File::DirectIOFile OpenChunkStoreData(const std::string& directory, ChunkStoreID* id);
+
+// Decompresses a chunk that has been read from the data file into out, which must be as large as
+// the uncompressed chunk.
+bool DecodeChunkStoreChunk(const ChunkStoreEntry& entry, const u8* stored_data,
+                           std::span<u8> out);
+
+// Write access to a store. Only one ChunkStore may have a given directory open at a time, which
+// is enforced with a lock file.
+class ChunkStore final
+{
+public:
+  // Creates the store if the directory doesn't contain one yet. Fails if another process has the
+  // store open.
+  static std::unique_ptr<ChunkStore> Open(const std::string& directory);
+
+  ChunkStore(const ChunkStore&) = delete;
+  ChunkStore(ChunkStore&&) = delete;
+  ChunkStore& operator=(const ChunkStore&) = delete;
+  ChunkStore& operator=(ChunkStore&&) = delete;
+  ~ChunkStore();
+
+  const std::string& GetDirectory() const { return m_directory; }
+  const ChunkStoreID& GetID() const { return m_id; }
+  u64 GetChunkCount() const;
+  u64 GetDataFileSize() const;
+
+  // Find and Add are thread-safe.
+  std::optional<ChunkStoreEntry> Find(const Common::SHA1::Digest& hash) const;
+
+  // Appends the chunk unless a chunk with the same hash is already stored. Either way, returns
+  // where the chunk with this hash is. Returns std::nullopt if writing failed.
+  std::optional<ChunkStoreEntry> Add(const Common::SHA1::Digest& hash,
+                                     std::span<const u8> stored_data, u32 flags,
+                                     bool* added = nullptr);
+
+  // Makes sure everything added so far has reached the disk, so that it is safe to write an image
+  // which refers to it. Chunks only get their index entries here, after their data is on disk.
+  bool Flush();
+
+private:
+  struct DigestHash
+  {
+    size_t operator()(const Common::SHA1::Digest& digest) const
+    {
+      // The digest is already evenly distributed, so any part of it makes a good hash.
+      size_t result;
+      std::memcpy(&result, digest.data(), sizeof(result));
+      return result;
+    }
+  };
+
+  explicit ChunkStore(std::string directory);
+
+  bool Create();
+  bool Load();
+
+  std::string m_directory;
+  ChunkStoreID m_id{};
+
+  File::DirectIOFile m_lock_file;
+  File::DirectIOFile m_data_file;
+  File::DirectIOFile m_index_file;
+  u64 m_data_end = 0;
+  u64 m_index_end = 0;
+  // Chunks which have been added since the last Flush.
+  std::vector<ChunkStoreEntry> m_unindexed_entries;
+
+  std::unordered_map<Common::SHA1::Digest, ChunkStoreEntry, DigestHash> m_entries;
+  mutable std::mutex m_lock;
+};
+
+}  // namespace DiscIO
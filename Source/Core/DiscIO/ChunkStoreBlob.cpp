@@ -0,0 +1,426 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/ChunkStoreBlob.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <zstd.h>
+
+#include "Common/Align.h"
+#include "Common/Assert.h"
+#include "Common/BitUtils.h"
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "DiscIO/MultithreadedCompressor.h"
+
+namespace DiscIO
+{
+static constexpr u32 MAX_STORE_PATH_SIZE = 0x10000;
+
+ChunkStoreFileReader::ChunkStoreFileReader(
+    File::DirectIOFile file, std::string path, const ChunkStoreImageHeader& header,
+    std::shared_ptr<const std::vector<ChunkStoreEntry>> entries, File::DirectIOFile data_file)
+    : m_file(std::move(file)), m_path(std::move(path)), m_header(header),
+      m_entries(std::move(entries)), m_data_file(std::move(data_file)),
+      m_cached_chunk(header.chunk_size)
+{
+}
+
+std::unique_ptr<ChunkStoreFileReader> ChunkStoreFileReader::Create(File::DirectIOFile file,
+                                                                   const std::string& path)
+{
+  ChunkStoreImageHeader header;
+  if (!file.OffsetRead(0, Common::AsWritableU8Span(header)) ||
+      header.magic != CHUNK_STORE_IMAGE_MAGIC)
+  {
+    return nullptr;
+  }
+
+  if (header.version != CHUNK_STORE_IMAGE_VERSION)
+  {
+    ERROR_LOG_FMT(DISCIO, "{} has unsupported chunk store image version {}", path,
+                  header.version);
+    return nullptr;
+  }
+
+  if (header.chunk_size == 0 || !std::has_single_bit(header.chunk_size) ||
+      header.store_path_size > MAX_STORE_PATH_SIZE ||
+      header.chunk_count != Common::AlignUp(header.data_size, header.chunk_size) /
+                                header.chunk_size)
+  {
+    ERROR_LOG_FMT(DISCIO, "{} has an invalid chunk store image header", path);
+    return nullptr;
+  }
+
+  std::string store_path(header.store_path_size, '\0');
+  if (!file.OffsetRead(sizeof(header), reinterpret_cast<u8*>(store_path.data()),
+                       store_path.size()))
+  {
+    return nullptr;
+  }
+
+  std::filesystem::path store_fs_path = StringToPath(store_path);
+  if (store_fs_path.is_relative())
+  {
+    std::string image_directory;
+    SplitPath(path, &image_directory, nullptr, nullptr);
+    store_fs_path = StringToPath(image_directory) / store_fs_path;
+  }
+  store_path = PathToString(store_fs_path);
+
+  ChunkStoreID store_id;
+  File::DirectIOFile data_file = OpenChunkStoreData(store_path, &store_id);
+  if (!data_file.IsOpen() || store_id != header.store_id)
+  {
+    ERROR_LOG_FMT(DISCIO, "The chunk store {} which {} refers to is missing or has been replaced",
+                  store_path, path);
+    return nullptr;
+  }
+
+  auto entries = std::make_shared<std::vector<ChunkStoreEntry>>(header.chunk_count);
+  if (!file.OffsetRead(sizeof(header) + header.store_path_size,
+                       Common::AsWritableU8Span(*entries)))
+  {
+    return nullptr;
+  }
+
+  // Everything that is read later on is checked here, so that Read can rely on it.
+  const u64 data_file_size = data_file.GetSize();
+  const u32 max_stored_size = static_cast<u32>(ZSTD_compressBound(header.chunk_size));
+  for (const ChunkStoreEntry& entry : *entries)
+  {
+    if (entry.stored_size > max_stored_size || entry.offset > data_file_size ||
+        entry.stored_size > data_file_size - entry.offset)
+    {
+      ERROR_LOG_FMT(DISCIO, "{} refers to chunks that are missing from {}", path, store_path);
+      return nullptr;
+    }
+  }
+
+  return std::unique_ptr<ChunkStoreFileReader>(new ChunkStoreFileReader(
+      std::move(file), path, header, std::move(entries), std::move(data_file)));
+}
+
+std::unique_ptr<BlobReader> ChunkStoreFileReader::CopyReader() const
+{
+  return std::unique_ptr<ChunkStoreFileReader>(
+      new ChunkStoreFileReader(m_file, m_path, m_header, m_entries, m_data_file));
+}
+
+bool ChunkStoreFileReader::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  if (offset > m_header.data_size || size > m_header.data_size - offset)
+    return false;
+  if (size == 0)
+    return true;
+
+  const u64 chunk_size = m_header.chunk_size;
+  const u64 first_chunk = offset / chunk_size;
+  const u64 end_chunk = (offset + size - 1) / chunk_size + 1;
+
+  // Games mostly make small reads, which tend to come one after another within the same chunk.
+  if (end_chunk - first_chunk == 1 && m_cached_chunk_index == first_chunk)
+  {
+    std::memcpy(out_ptr, m_cached_chunk.data() + offset % chunk_size, size);
+    return true;
+  }
+
+  // Chunks that are shared with other images are spread out over the data file, so reading them
+  // one at a time would mean waiting for one seek after the other. Instead, they are all read in
+  // one batch.
+  const std::span<const ChunkStoreEntry> entries(m_entries->data() + first_chunk,
+                                                 end_chunk - first_chunk);
+  u64 stored_size = 0;
+  for (const ChunkStoreEntry& entry : entries)
+    stored_size += entry.stored_size;
+  m_stored_buffer.resize(stored_size);
+
+  std::vector<File::BatchRead> reads;
+  reads.reserve(entries.size());
+  u8* stored_ptr = m_stored_buffer.data();
+  for (const ChunkStoreEntry& entry : entries)
+  {
+    reads.push_back({&m_data_file, entry.offset, stored_ptr, entry.stored_size});
+    stored_ptr += entry.stored_size;
+  }
+  if (!File::OffsetReadBatch(reads))
+    return false;
+
+  stored_ptr = m_stored_buffer.data();
+  for (u64 chunk = first_chunk; chunk < end_chunk; ++chunk)
+  {
+    const ChunkStoreEntry& entry = (*m_entries)[chunk];
+    const u64 offset_in_chunk = offset % chunk_size;
+    const u64 bytes_to_copy = std::min(chunk_size - offset_in_chunk, size);
+
+    if (bytes_to_copy == chunk_size)
+    {
+      if (!DecodeChunkStoreChunk(entry, stored_ptr, {out_ptr, chunk_size}))
+        return false;
+    }
+    else
+    {
+      m_cached_chunk_index.reset();
+      if (!DecodeChunkStoreChunk(entry, stored_ptr, m_cached_chunk))
+        return false;
+      m_cached_chunk_index = chunk;
+      std::memcpy(out_ptr, m_cached_chunk.data() + offset_in_chunk, bytes_to_copy);
+    }
+
+    stored_ptr += entry.stored_size;
+    out_ptr += bytes_to_copy;
+    offset += bytes_to_copy;
+    size -= bytes_to_copy;
+  }
+
+  return true;
+}
+
+namespace
+{
+struct ZstdCCtxDeleter
+{
+  void operator()(ZSTD_CCtx* context) const { ZSTD_freeCCtx(context); }
+};
+
+struct CompressThreadState
+{
+  std::unique_ptr<ZSTD_CCtx, ZstdCCtxDeleter> context;
+};
+
+struct CompressParameters
+{
+  std::vector<u8> data;
+  u64 chunk_index;
+};
+
+struct OutputParameters
+{
+  Common::SHA1::Digest hash;
+  // Empty if the chunk was already in the store when it was hashed.
+  std::vector<u8> stored_data;
+  u32 flags;
+  u64 chunk_index;
+};
+}  // namespace
+
+static ConversionResult<OutputParameters> Compress(CompressThreadState* state,
+                                                   CompressParameters parameters,
+                                                   const ChunkStore& store, int compression_level)
+{
+  OutputParameters output{Common::SHA1::CalculateDigest(parameters.data), {}, 0,
+                          parameters.chunk_index};
+
+  // Most of the time, a chunk that is a duplicate of something is a duplicate of something that
+  // was added long ago, so this avoids compressing the large majority of them. Duplicates which
+  // are still in flight get compressed, and then thrown away by Output.
+  if (store.Find(output.hash))
+    return output;
+
+  output.stored_data.resize(ZSTD_compressBound(parameters.data.size()));
+  const size_t result =
+      ZSTD_compressCCtx(state->context.get(), output.stored_data.data(),
+                        output.stored_data.size(), parameters.data.data(),
+                        parameters.data.size(), compression_level);
+  if (ZSTD_isError(result))
+  {
+    ERROR_LOG_FMT(DISCIO, "ZSTD_compressCCtx failed: {}", ZSTD_getErrorName(result));
+    return std::unexpected{ConversionResultCode::InternalError};
+  }
+
+  if (result < parameters.data.size())
+  {
+    output.stored_data.resize(result);
+    output.flags = CHUNK_STORE_FLAG_COMPRESSED;
+  }
+  else
+  {
+    output.stored_data = std::move(parameters.data);
+  }
+
+  return output;
+}
+
+static ConversionResultCode Output(OutputParameters parameters, ChunkStore* store,
+                                   std::vector<ChunkStoreEntry>* entries,
+                                   ChunkStoreConversionStats* stats, const CompressCB& callback)
+{
+  std::optional<ChunkStoreEntry> entry;
+  bool added = false;
+  if (parameters.stored_data.empty())
+    entry = store->Find(parameters.hash);
+  else
+    entry = store->Add(parameters.hash, parameters.stored_data, parameters.flags, &added);
+
+  if (!entry)
+    return ConversionResultCode::WriteFailed;
+
+  (*entries)[parameters.chunk_index] = *entry;
+
+  stats->referenced_bytes += entry->stored_size;
+  if (added)
+  {
+    ++stats->new_chunk_count;
+    stats->added_bytes += entry->stored_size;
+  }
+
+  const u64 chunks_done = parameters.chunk_index + 1;
+  if (chunks_done % 64 == 0 || chunks_done == entries->size())
+  {
+    const std::string text =
+        Common::FmtFormatT("{0} of {1} chunks. {2} were already stored", chunks_done,
+                           entries->size(), chunks_done - stats->new_chunk_count);
+    const float completion = static_cast<float>(chunks_done) / entries->size();
+    if (!callback(text, completion))
+      return ConversionResultCode::Canceled;
+  }
+
+  return ConversionResultCode::Success;
+}
+
+// Paths are stored relative to the image when possible, so that the image and the store can be
+// moved together.
+static std::string GetStorePathForImage(const std::string& store_directory,
+                                        const std::string& image_path)
+{
+  std::error_code store_error, image_error;
+  const std::filesystem::path store_path =
+      std::filesystem::absolute(StringToPath(store_directory), store_error);
+  const std::filesystem::path image_directory =
+      std::filesystem::absolute(StringToPath(image_path), image_error).parent_path();
+  if (store_error || image_error)
+    return store_directory;
+
+  std::filesystem::path relative_path = store_path.lexically_relative(image_directory);
+  std::string result = PathToString(relative_path.empty() ? store_path : relative_path);
+#ifdef _WIN32
+  std::ranges::replace(result, '\\', '/');
+#endif
+  return result;
+}
+
+bool ConvertToChunkStore(BlobReader* infile, const std::string& infile_path, ChunkStore* store,
+                         const std::string& outfile_path, int chunk_size, int compression_level,
+                         const CompressCB& callback, ChunkStoreConversionStats* stats)
+{
+  ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
+  ASSERT(chunk_size > 0 && std::has_single_bit(static_cast<u32>(chunk_size)));
+
+  File::DirectIOFile outfile(outfile_path, File::AccessMode::Write);
+  if (!outfile.IsOpen())
+  {
+    PanicAlertFmtT(
+        "Failed to open the output file \"{0}\".\n"
+        "Check that you have permissions to write the target folder and that the media can "
+        "be written.",
+        outfile_path);
+    return false;
+  }
+
+  callback(Common::GetStringT("Files opened, ready to compress."), 0);
+
+  const u64 data_size = infile->GetDataSize();
+  const u64 chunk_count = Common::AlignUp(data_size, u64(chunk_size)) / chunk_size;
+  std::vector<ChunkStoreEntry> entries(chunk_count);
+  *stats = {};
+  stats->chunk_count = chunk_count;
+
+  const auto set_up_compress_thread_state = [](CompressThreadState* state) {
+    state->context.reset(ZSTD_createCCtx());
+    return state->context ? ConversionResultCode::Success : ConversionResultCode::InternalError;
+  };
+
+  const auto compress = [&](CompressThreadState* state, CompressParameters parameters) {
+    return Compress(state, std::move(parameters), *store, compression_level);
+  };
+
+  const auto output = [&](OutputParameters parameters) {
+    return Output(std::move(parameters), store, &entries, stats, callback);
+  };
+
+  MultithreadedCompressor<CompressThreadState, CompressParameters, OutputParameters> compressor(
+      set_up_compress_thread_state, compress, output);
+
+  for (u64 i = 0; i < chunk_count; ++i)
+  {
+    if (compressor.GetStatus() != ConversionResultCode::Success)
+      break;
+
+    // Chunks are the raw bytes of the image, so that they are identical between images which
+    // contain the same data. Like in the other formats, the last chunk is padded with zeroes.
+    std::vector<u8> data(chunk_size);
+    const u64 offset = i * chunk_size;
+    if (!infile->Read(offset, std::min<u64>(chunk_size, data_size - offset), data.data()))
+    {
+      compressor.SetError(ConversionResultCode::ReadFailed);
+      break;
+    }
+
+    compressor.CompressAndWrite(CompressParameters{std::move(data), i});
+  }
+
+  compressor.Shutdown();
+
+  ConversionResultCode result = compressor.GetStatus();
+
+  if (result == ConversionResultCode::Success)
+  {
+    const std::string store_path = GetStorePathForImage(store->GetDirectory(), outfile_path);
+
+    ChunkStoreImageHeader header;
+    header.magic = CHUNK_STORE_IMAGE_MAGIC;
+    header.version = CHUNK_STORE_IMAGE_VERSION;
+    header.store_id = store->GetID();
+    header.data_size = data_size;
+    header.chunk_size = static_cast<u32>(chunk_size);
+    header.compression_level = compression_level;
+    header.chunk_count = static_cast<u32>(chunk_count);
+    header.store_path_size = static_cast<u32>(store_path.size());
+
+    // The store has to be on the disk before anything refers to it.
+    if (!store->Flush() || !outfile.Write(Common::AsU8Span(header)) ||
+        !outfile.Write(reinterpret_cast<const u8*>(store_path.data()), store_path.size()) ||
+        !outfile.Write(Common::AsU8Span(entries)))
+    {
+      result = ConversionResultCode::WriteFailed;
+    }
+  }
+
+  if (result != ConversionResultCode::Success)
+  {
+    // Remove the incomplete output file.
+    outfile.Close();
+    File::Delete(outfile_path);
+  }
+  else
+  {
+    callback(Common::GetStringT("Done compressing disc image."), 1.0f);
+  }
+
+  if (result == ConversionResultCode::ReadFailed)
+    PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
+
+  if (result == ConversionResultCode::WriteFailed)
+  {
+    PanicAlertFmtT("Failed to write the output file \"{0}\".\n"
+                   "Check that you have enough space available on the target drive.",
+                   outfile_path);
+  }
+
+  return result == ConversionResultCode::Success;
+}
+
+}  // namespace DiscIO
@@ -0,0 +1,98 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/DirectIOFile.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/ChunkStore.h"
+
+namespace DiscIO
+{
+// A disc image whose data is kept in a chunk store. The image file itself only lists which chunk
+// of the store each chunk of the disc is.
+
+static constexpr u32 CHUNK_STORE_IMAGE_MAGIC = 0x4D534344;  // "DCSM" (byteswapped to little endian)
+static constexpr u32 CHUNK_STORE_IMAGE_VERSION = 1;
+
+// Blobs created by Dolphin are always little endian
+#pragma pack(push, 1)
+struct ChunkStoreImageHeader
+{
+  u32 magic;
+  u32 version;
+  ChunkStoreID store_id;
+  u64 data_size;
+  u32 chunk_size;
+  s32 compression_level;
+  u32 chunk_count;
+  // The path of the store follows the header. Unless it is absolute, it is relative to the
+  // directory that the image is in. After the path, there is a ChunkStoreEntry for every chunk.
+  u32 store_path_size;
+};
+static_assert(sizeof(ChunkStoreImageHeader) == 48);
+#pragma pack(pop)
+
+class ChunkStoreFileReader final : public BlobReader
+{
+public:
+  static std::unique_ptr<ChunkStoreFileReader> Create(File::DirectIOFile file,
+                                                      const std::string& path);
+
+  BlobType GetBlobType() const override { return BlobType::CHUNK_STORE; }
+  std::unique_ptr<BlobReader> CopyReader() const override;
+
+  // Only counts the image file, since the chunks in the store may be shared with other images.
+  u64 GetRawSize() const override { return m_file.GetSize(); }
+  u64 GetDataSize() const override { return m_header.data_size; }
+  DataSizeType GetDataSizeType() const override { return DataSizeType::Accurate; }
+
+  u64 GetBlockSize() const override { return m_header.chunk_size; }
+  bool HasFastRandomAccessInBlock() const override { return false; }
+  std::string GetCompressionMethod() const override { return "Zstandard"; }
+  std::optional<int> GetCompressionLevel() const override { return m_header.compression_level; }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+
+private:
+  ChunkStoreFileReader(File::DirectIOFile file, std::string path,
+                       const ChunkStoreImageHeader& header,
+                       std::shared_ptr<const std::vector<ChunkStoreEntry>> entries,
+                       File::DirectIOFile data_file);
+
+  File::DirectIOFile m_file;
+  std::string m_path;
+  ChunkStoreImageHeader m_header;
+  std::shared_ptr<const std::vector<ChunkStoreEntry>> m_entries;
+  File::DirectIOFile m_data_file;
+
+  std::vector<u8> m_stored_buffer;
+  std::vector<u8> m_cached_chunk;
+  std::optional<u64> m_cached_chunk_index;
+};
+
+struct ChunkStoreConversionStats
+{
+  u64 chunk_count = 0;
+  // Chunks which weren't in the store yet and had to be added.
+  u64 new_chunk_count = 0;
+  // The stored sizes of all the chunks the image refers to, which is how much space the image
+  // would take up in a store of its own. This is usually more than an RVZ file of the image,
+  // since chunks don't leave out junk data or decrypt Wii partitions before compressing.
+  u64 referenced_bytes = 0;
+  u64 added_bytes = 0;
+};
+
+// Adds the data of infile to the store, and writes an image to outfile_path that refers to it.
+// If this fails, chunks which were added to the store before the failure stay in the store.
+bool ConvertToChunkStore(BlobReader* infile, const std::string& infile_path, ChunkStore* store,
+                         const std::string& outfile_path, int chunk_size, int compression_level,
+                         const CompressCB& callback, ChunkStoreConversionStats* stats);
+
+}  // namespace DiscIO
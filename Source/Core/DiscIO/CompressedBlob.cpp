@@ -33,6 +33,8 @@ namespace DiscIO
 {
 bool IsGCZBlob(File::DirectIOFile& file);
 
+constexpr u32 GCZ_CHUNK_SIZE = 0x20000;
+
 CompressedBlobReader::CompressedBlobReader(File::DirectIOFile file, const std::string& filename)
     : m_file(std::move(file)), m_file_name(filename)
 {
@@ -41,6 +43,8 @@ CompressedBlobReader::CompressedBlobReader(File::DirectIOFile file, const std::s
   m_file.Read(Common::AsWritableU8Span(m_header));
 
   SetSectorSize(m_header.block_size);
+  // Reading several blocks at a time lets ReadMultipleAlignedBlocks issue concurrent reads.
+  SetChunkSize(std::max<u32>(GCZ_CHUNK_SIZE / std::max<u32>(m_header.block_size, 1), 1));
 
   // cache block pointers and hashes
   m_block_pointers.resize(m_header.num_blocks);
@@ -90,19 +94,18 @@ u64 CompressedBlobReader::GetBlockCompressedSize(u64 block_num) const
   return 0;
 }
 
-bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+u64 CompressedBlobReader::GetBlockFileOffset(u64 block_num, bool* uncompressed) const
 {
-  bool uncompressed = false;
-  u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
   u64 offset = m_block_pointers[block_num] + m_data_offset;
+  *uncompressed = (offset & (1ULL << 63)) != 0;
+  return offset & ~(1ULL << 63);
+}
 
-  if (offset & (1ULL << 63))
-  {
-    if (comp_block_size != m_header.block_size)
-      ERROR_LOG_FMT(DISCIO, "Uncompressed block with wrong size");
-    uncompressed = true;
-    offset &= ~(1ULL << 63);
-  }
+bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+{
+  bool uncompressed;
+  const u64 offset = GetBlockFileOffset(block_num, &uncompressed);
+  const u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
 
   // clear unused part of zlib buffer. maybe this can be deleted when it works fully.
   memset(&m_zlib_buffer[comp_block_size], 0, m_zlib_buffer.size() - comp_block_size);
@@ -114,8 +117,66 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
     return false;
   }
 
+  return DecompressBlock(block_num, m_zlib_buffer.data(), comp_block_size, uncompressed, out_ptr);
+}
+
+bool CompressedBlobReader::ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr)
+{
+  if (num_blocks == 1)
+    return GetBlock(block_num, out_ptr);
+
+  // The compressed data of all blocks is read at once, so that the storage can work on the
+  // reads concurrently.
+  std::vector<u64> compressed_offsets(num_blocks + 1);
+  for (u64 i = 0; i < num_blocks; ++i)
+  {
+    const u64 comp_block_size = GetBlockCompressedSize(block_num + i);
+    if (comp_block_size > m_header.block_size)
+      return SectorReader::ReadMultipleAlignedBlocks(block_num, num_blocks, out_ptr);
+    compressed_offsets[i + 1] = compressed_offsets[i] + comp_block_size;
+  }
+
+  std::vector<u8> compressed_data(compressed_offsets.back());
+  std::vector<File::BatchRead> reads;
+  std::vector<bool> uncompressed(num_blocks);
+  for (u64 i = 0; i < num_blocks; ++i)
+  {
+    bool block_uncompressed;
+    const u64 offset = GetBlockFileOffset(block_num + i, &block_uncompressed);
+    uncompressed[i] = block_uncompressed;
+    reads.push_back({&m_file, offset, compressed_data.data() + compressed_offsets[i],
+                     compressed_offsets[i + 1] - compressed_offsets[i]});
+  }
+
+  if (!File::OffsetReadBatch(reads))
+  {
+    ERROR_LOG_FMT(DISCIO, "The disc image \"{}\" is truncated, some of the data is missing.",
+                  m_file_name);
+    return false;
+  }
+
+  for (u64 i = 0; i < num_blocks; ++i)
+  {
+    const u8* compressed_block = compressed_data.data() + compressed_offsets[i];
+    const u32 comp_block_size = static_cast<u32>(compressed_offsets[i + 1] - compressed_offsets[i]);
+    if (!DecompressBlock(block_num + i, compressed_block, comp_block_size, uncompressed[i],
+                         out_ptr + i * m_header.block_size))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool CompressedBlobReader::DecompressBlock(u64 block_num, const u8* in_ptr, u32 comp_block_size,
+                                           bool uncompressed, u8* out_ptr)
+{
+  if (uncompressed && comp_block_size != m_header.block_size)
+    ERROR_LOG_FMT(DISCIO, "Uncompressed block with wrong size");
+
   // First, check hash.
-  const u32 block_hash = Common::HashAdler32(m_zlib_buffer.data(), comp_block_size);
+  const u32 block_hash = Common::HashAdler32(in_ptr, comp_block_size);
   if (block_hash != m_hashes[block_num])
   {
     ERROR_LOG_FMT(DISCIO,
@@ -126,12 +187,12 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
 
   if (uncompressed)
   {
-    std::copy_n(m_zlib_buffer.begin(), comp_block_size, out_ptr);
+    std::copy_n(in_ptr, comp_block_size, out_ptr);
   }
   else
   {
     z_stream z = {};
-    z.next_in = m_zlib_buffer.data();
+    z.next_in = const_cast<u8*>(in_ptr);
     z.avail_in = comp_block_size;
     if (z.avail_in > m_header.block_size)
     {
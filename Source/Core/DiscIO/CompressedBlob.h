@@ -64,9 +64,16 @@ public:
   u64 GetBlockCompressedSize(u64 block_num) const;
   bool GetBlock(u64 block_num, u8* out_ptr) override;
 
+protected:
+  bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr) override;
+
 private:
   CompressedBlobReader(File::DirectIOFile file, const std::string& filename);
 
+  u64 GetBlockFileOffset(u64 block_num, bool* uncompressed) const;
+  bool DecompressBlock(u64 block_num, const u8* in_ptr, u32 comp_block_size, bool uncompressed,
+                       u8* out_ptr);
+
   CompressedBlobHeader m_header;
   std::vector<u64> m_block_pointers;
   std::vector<u32> m_hashes;
@@ -4,6 +4,7 @@
 #include "DiscIO/FileBlob.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -15,6 +16,9 @@
 
 namespace DiscIO
 {
+// How much data after a read through the mapping the OS gets asked to load in the background.
+constexpr u64 MAPPING_READ_AHEAD_SIZE = 1024 * 1024;
+
 PlainFileReader::PlainFileReader(File::DirectIOFile file) : m_file(std::move(file))
 {
   m_size = m_file.GetSize();
@@ -30,12 +34,48 @@ std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::DirectIOFile file
 
 std::unique_ptr<BlobReader> PlainFileReader::CopyReader() const
 {
-  return Create(m_file);
+  std::unique_ptr<PlainFileReader> copy = Create(m_file);
+  if (copy)
+    copy->m_mapping = m_mapping;
+  return copy;
+}
+
+bool PlainFileReader::MapIntoMemory()
+{
+  if (m_mapping)
+    return true;
+
+  auto mapping = std::make_shared<File::MappedFile>();
+  if (!mapping->Map(m_file) || mapping->GetSize() != m_size)
+    return false;
+
+  m_mapping = std::move(mapping);
+  return true;
 }
 
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
-  return m_file.OffsetRead(offset, out_ptr, nbytes);
+  if (!m_mapping)
+    return m_file.OffsetRead(offset, out_ptr, nbytes);
+
+  if (offset > m_size || nbytes > m_size - offset)
+    return false;
+
+  std::memcpy(out_ptr, m_mapping->GetSpan().data() + offset, nbytes);
+  return true;
+}
+
+std::shared_ptr<const u8> PlainFileReader::ReadView(u64 offset, u64 nbytes)
+{
+  if (!m_mapping || offset > m_size || nbytes > m_size - offset)
+    return nullptr;
+
+  // Whoever receives the view may be a thread that shouldn't wait for the disk, so the data is
+  // brought into memory here. Games tend to keep reading where they left off.
+  m_mapping->WillNeed(offset + nbytes, MAPPING_READ_AHEAD_SIZE);
+  m_mapping->Prefault(offset, nbytes);
+
+  return std::shared_ptr<const u8>(m_mapping, m_mapping->GetSpan().data() + offset);
 }
 
 bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
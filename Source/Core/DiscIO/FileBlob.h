@@ -8,6 +8,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/DirectIOFile.h"
+#include "Common/MappedFile.h"
 #include "DiscIO/Blob.h"
 
 namespace DiscIO
@@ -30,12 +31,18 @@ public:
   std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
 
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
+  std::shared_ptr<const u8> ReadView(u64 offset, u64 nbytes) override;
+
+  // Serves reads from a mapping of the file instead of reading it, which allows ReadView to be
+  // used. Copies of this reader share the mapping.
+  bool MapIntoMemory();
 
 private:
   PlainFileReader(File::DirectIOFile file);
 
   File::DirectIOFile m_file;
   u64 m_size;
+  std::shared_ptr<File::MappedFile> m_mapping;
 };
 
 }  // namespace DiscIO
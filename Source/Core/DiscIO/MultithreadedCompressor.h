@@ -7,11 +7,14 @@
 #include <expected>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "Common/Assert.h"
 #include "Common/Event.h"
+#include "Common/ThreadPool.h"
 
 namespace DiscIO
 {
@@ -27,12 +30,14 @@ enum class ConversionResultCode
 template <typename T>
 using ConversionResult = std::expected<T, ConversionResultCode>;
 
-// This class starts a number of compression threads and one output thread.
-// The set_up_compress_thread_state function is called at the start of each compression thread.
-// When CompressAndWrite is called, the compress function will be called on one of the
-// compression threads, and then the output function will be called on the output thread.
+// This class compresses data using tasks on the shared thread pool, and starts one output thread.
+// The set_up_compress_thread_state function is called on each compression state before it is
+// first used. A state is only used by one compression task at a time, but it is not tied to any
+// particular thread.
+// When CompressAndWrite is called, the compress function will be called on one of the pool
+// threads, and then the output function will be called on the output thread.
 // The output thread handles data in the order that data was submitted using CompressAndWrite,
-// but the compression threads are not guaranteed to handle data in a predictable order.
+// but the compression tasks are not guaranteed to handle data in a predictable order.
 // Remember to check GetStatus regularly and cancel if it doesn't return Success,
 // and call Shutdown when you want to ensure that everything finishes.
 template <typename CompressThreadState, typename CompressParameters, typename OutputParameters>
@@ -46,16 +51,13 @@ public:
       std::function<ConversionResultCode(OutputParameters)> output)
       : m_set_up_compress_thread_state(std::move(set_up_compress_thread_state)),
         m_compress(std::move(compress)), m_output(std::move(output)),
-        m_threads(std::max<unsigned int>(1, std::thread::hardware_concurrency()))
+        // Two slots per pool thread, so that every thread can have more work queued up while the
+        // output thread is busy
+        m_slot_count(m_compress_tasks.GetThreadCount() * 2)
   {
-    m_compress_threads = std::make_unique<CompressThread[]>(m_threads);
-
-    for (size_t i = 0; i < m_threads; ++i)
-    {
-      m_compress_threads[i].thread =
-          std::thread(std::mem_fn(&MultithreadedCompressor::CompressThreadFunction), this,
-                      &m_compress_threads[i]);
-    }
+    m_slots = std::make_unique<Slot[]>(m_slot_count);
+    for (size_t i = 0; i < m_slot_count; ++i)
+      m_slots[i].ready_event.Set();
 
     m_output_thread =
         std::thread(std::mem_fn(&MultithreadedCompressor::OutputThreadFunction), this);
@@ -72,15 +74,15 @@ public:
     if (GetStatus() != ConversionResultCode::Success)
       return;
 
-    CompressThread& compress_thread = m_compress_threads[m_current_index];
+    Slot& slot = m_slots[m_current_index];
 
-    compress_thread.compress_ready_event.Wait();
-    compress_thread.compress_parameters = std::move(parameters);
-    compress_thread.compress_event.Set();
+    slot.ready_event.Wait();
+    slot.compress_parameters = std::move(parameters);
+    m_compress_tasks.Run([this, &slot] { Compress(&slot); });
 
     ++m_current_index;
-    if (m_current_index >= m_threads)
-      m_current_index -= m_threads;
+    if (m_current_index >= m_slot_count)
+      m_current_index -= m_slot_count;
   }
 
   void SetError(ConversionResultCode result)
@@ -96,110 +98,119 @@ public:
 
   void Shutdown()
   {
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_ready_event.Wait();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_done_event.Wait();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_ready_event.Wait();
+    m_compress_tasks.Wait();
 
-    m_shutting_down.store(true);
+    // A slot becomes ready once the output thread is done with the data that was compressed in it
+    for (size_t i = 0; i < m_slot_count; ++i)
+      m_slots[i].ready_event.Wait();
 
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].compress_event.Set();
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_event.Set();
+    m_shutting_down.store(true);
 
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].thread.join();
+    for (size_t i = 0; i < m_slot_count; ++i)
+      m_slots[i].output_event.Set();
 
     m_output_thread.join();
   }
 
 private:
-  struct CompressThread
+  struct Slot
   {
-    std::thread thread;
-
-    Common::Event compress_ready_event;
-    Common::Event compress_event;
-    Common::Event compress_done_event;
-    Common::Event output_ready_event;
+    Common::Event ready_event;
     Common::Event output_event;
 
     CompressParameters compress_parameters;
     OutputParameters output_parameters;
+    bool has_output = false;
   };
 
-  void CompressThreadFunction(CompressThread* state)
+  std::unique_ptr<CompressThreadState> AcquireCompressThreadState()
   {
-    CompressThreadState compress_thread_state;
-
-    ConversionResultCode setup_result = m_set_up_compress_thread_state(&compress_thread_state);
-    if (setup_result != ConversionResultCode::Success)
-      SetError(setup_result);
+    {
+      std::lock_guard lk(m_free_states_lock);
+      if (!m_free_states.empty())
+      {
+        std::unique_ptr<CompressThreadState> state = std::move(m_free_states.back());
+        m_free_states.pop_back();
+        return state;
+      }
+    }
 
-    state->compress_ready_event.Set();
-    state->compress_done_event.Set();
+    auto state = std::make_unique<CompressThreadState>();
 
-    while (true)
+    const ConversionResultCode setup_result = m_set_up_compress_thread_state(state.get());
+    if (setup_result != ConversionResultCode::Success)
     {
-      state->compress_event.Wait();
-
-      if (m_shutting_down.load())
-        return;
+      SetError(setup_result);
+      return nullptr;
+    }
 
-      CompressParameters parameters = std::move(state->compress_parameters);
+    return state;
+  }
 
-      state->compress_done_event.Reset();
-      state->compress_ready_event.Set();
+  void ReleaseCompressThreadState(std::unique_ptr<CompressThreadState> state)
+  {
+    std::lock_guard lk(m_free_states_lock);
+    m_free_states.push_back(std::move(state));
+  }
 
+  // Runs on the thread pool, so it must not wait for the output thread.
+  void Compress(Slot* slot)
+  {
+    std::unique_ptr<CompressThreadState> state = AcquireCompressThreadState();
+    if (state)
+    {
       ConversionResult<OutputParameters> result =
-          m_compress(&compress_thread_state, std::move(parameters));
+          m_compress(state.get(), std::move(slot->compress_parameters));
+
+      ReleaseCompressThreadState(std::move(state));
 
       if (result)
       {
-        state->output_ready_event.Wait();
-        state->output_parameters = std::move(*result);
-        state->output_event.Set();
+        slot->output_parameters = std::move(*result);
+        slot->has_output = true;
       }
       else
       {
         SetError(result.error());
       }
-
-      state->compress_done_event.Set();
     }
+
+    slot->output_event.Set();
   }
 
   void OutputThreadFunction()
   {
-    for (size_t i = 0; i < m_threads; ++i)
-      m_compress_threads[i].output_ready_event.Set();
-
     size_t index = 0;
 
     while (true)
     {
-      CompressThread& compress_thread = m_compress_threads[index];
+      Slot& slot = m_slots[index];
 
-      compress_thread.output_event.Wait();
+      slot.output_event.Wait();
 
       if (m_shutting_down.load())
         return;
 
-      OutputParameters parameters = std::move(compress_thread.output_parameters);
+      if (slot.has_output)
+      {
+        OutputParameters parameters = std::move(slot.output_parameters);
+        slot.has_output = false;
 
-      compress_thread.output_ready_event.Set();
+        slot.ready_event.Set();
 
-      const ConversionResultCode result = m_output(std::move(parameters));
+        const ConversionResultCode result = m_output(std::move(parameters));
 
-      if (result != ConversionResultCode::Success)
-        SetError(result);
+        if (result != ConversionResultCode::Success)
+          SetError(result);
+      }
+      else
+      {
+        slot.ready_event.Set();
+      }
 
       ++index;
-      if (index >= m_threads)
-        index -= m_threads;
+      if (index >= m_slot_count)
+        index -= m_slot_count;
     }
   }
 
@@ -208,13 +219,18 @@ private:
       m_compress;
   std::function<ConversionResultCode(OutputParameters)> m_output;
 
+  Common::TaskGroup m_compress_tasks;
+
   // We can't use std::vector for this, because Common::Event is not movable
-  std::unique_ptr<CompressThread[]> m_compress_threads;
+  std::unique_ptr<Slot[]> m_slots;
   std::thread m_output_thread;
 
-  const size_t m_threads;
+  const size_t m_slot_count;
   size_t m_current_index = 0;
 
+  std::mutex m_free_states_lock;
+  std::vector<std::unique_ptr<CompressThreadState>> m_free_states;
+
   std::atomic<ConversionResultCode> m_result = ConversionResultCode::Success;
   std::atomic<bool> m_shutting_down = false;
 };
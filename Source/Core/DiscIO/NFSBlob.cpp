@@ -195,7 +195,8 @@ u64 NFSFileReader::ToPhysicalBlockIndex(u64 logical_block_index) const
   return std::numeric_limits<u64>::max();
 }
 
-bool NFSFileReader::ReadEncryptedBlock(u64 physical_block_index)
+void NFSFileReader::AddEncryptedBlockReads(u64 physical_block_index, u8* out_ptr,
+                                           std::vector<File::BatchRead>* reads)
 {
   constexpr u64 BLOCKS_PER_FILE = MAX_FILE_SIZE / BLOCK_SIZE;
 
@@ -211,42 +212,35 @@ bool NFSFileReader::ReadEncryptedBlock(u64 physical_block_index)
     constexpr size_t PART_1_SIZE = BLOCK_SIZE - sizeof(NFSHeader);
     constexpr size_t PART_2_SIZE = sizeof(NFSHeader);
 
-    File::DirectIOFile& file_1 = m_files[file_index];
-    File::DirectIOFile& file_2 = m_files[file_index + 1];
-
-    if (!file_1.OffsetRead(offset_in_file, m_current_block_encrypted.data(), PART_1_SIZE))
-      return false;
-
-    if (!file_2.OffsetRead(0, m_current_block_encrypted.data() + PART_1_SIZE, PART_2_SIZE))
-      return false;
+    reads->push_back({&m_files[file_index], offset_in_file, out_ptr, PART_1_SIZE});
+    reads->push_back({&m_files[file_index + 1], 0, out_ptr + PART_1_SIZE, PART_2_SIZE});
   }
   else
   {
     // Normal case. The read is offset by 0x200 bytes, but it's all within one file.
 
-    File::DirectIOFile& file = m_files[file_index];
-
-    if (!file.OffsetRead(offset_in_file, m_current_block_encrypted.data(), BLOCK_SIZE))
-    {
-      return false;
-    }
+    reads->push_back({&m_files[file_index], offset_in_file, out_ptr, BLOCK_SIZE});
   }
+}
 
-  return true;
+bool NFSFileReader::ReadEncryptedBlock(u64 physical_block_index)
+{
+  std::vector<File::BatchRead> reads;
+  AddEncryptedBlockReads(physical_block_index, m_current_block_encrypted.data(), &reads);
+  return File::OffsetReadBatch(reads);
 }
 
-void NFSFileReader::DecryptBlock(u64 logical_block_index)
+void NFSFileReader::DecryptBlock(u64 logical_block_index, const u8* encrypted_block)
 {
   std::array<u8, 16> iv{};
   const u64 swapped_block_index = Common::swap64(logical_block_index);
   std::memcpy(iv.data() + iv.size() - sizeof(swapped_block_index), &swapped_block_index,
               sizeof(swapped_block_index));
 
-  m_aes_context->Crypt(iv.data(), m_current_block_encrypted.data(),
-                       m_current_block_decrypted.data(), BLOCK_SIZE);
+  m_aes_context->Crypt(iv.data(), encrypted_block, m_current_block_decrypted.data(), BLOCK_SIZE);
 }
 
-bool NFSFileReader::ReadAndDecryptBlock(u64 logical_block_index)
+bool NFSFileReader::ReadAndDecryptBlock(u64 logical_block_index, const u8* encrypted_block)
 {
   const u64 physical_block_index = ToPhysicalBlockIndex(logical_block_index);
 
@@ -257,10 +251,14 @@ bool NFSFileReader::ReadAndDecryptBlock(u64 logical_block_index)
   }
   else
   {
-    if (!ReadEncryptedBlock(physical_block_index))
-      return false;
+    if (!encrypted_block)
+    {
+      if (!ReadEncryptedBlock(physical_block_index))
+        return false;
+      encrypted_block = m_current_block_encrypted.data();
+    }
 
-    DecryptBlock(logical_block_index);
+    DecryptBlock(logical_block_index, encrypted_block);
   }
 
   // Small hack: Set 0x61 of the header to 1 so that VolumeWii realizes that the disc is unencrypted
@@ -272,6 +270,32 @@ bool NFSFileReader::ReadAndDecryptBlock(u64 logical_block_index)
 
 bool NFSFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
+  if (nbytes == 0)
+    return true;
+
+  // When a read spans several blocks, all of them are read from the files at once, so that the
+  // storage can work on them concurrently.
+  const u64 first_block_index = offset / BLOCK_SIZE;
+  const u64 end_block_index = (offset + nbytes + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  std::vector<u8> encrypted_blocks;
+  if (end_block_index - first_block_index > 1)
+  {
+    encrypted_blocks.resize((end_block_index - first_block_index) * BLOCK_SIZE);
+    std::vector<File::BatchRead> reads;
+    for (u64 i = first_block_index; i < end_block_index; ++i)
+    {
+      const u64 physical_block_index = ToPhysicalBlockIndex(i);
+      if (physical_block_index != std::numeric_limits<u64>::max())
+      {
+        u8* encrypted_block = encrypted_blocks.data() + (i - first_block_index) * BLOCK_SIZE;
+        AddEncryptedBlockReads(physical_block_index, encrypted_block, &reads);
+      }
+    }
+
+    if (!File::OffsetReadBatch(reads))
+      return false;
+  }
+
   while (nbytes != 0)
   {
     const u64 logical_block_index = offset / BLOCK_SIZE;
@@ -279,7 +303,14 @@ bool NFSFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 
     if (logical_block_index != m_current_logical_block_index)
     {
-      if (!ReadAndDecryptBlock(logical_block_index))
+      const u8* encrypted_block = nullptr;
+      if (!encrypted_blocks.empty())
+      {
+        encrypted_block =
+            encrypted_blocks.data() + (logical_block_index - first_block_index) * BLOCK_SIZE;
+      }
+
+      if (!ReadAndDecryptBlock(logical_block_index, encrypted_block))
         return false;
 
       m_current_logical_block_index = logical_block_index;
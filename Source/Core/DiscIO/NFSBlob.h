@@ -75,9 +75,12 @@ private:
                 u64 raw_size);
 
   u64 ToPhysicalBlockIndex(u64 logical_block_index) const;
+  void AddEncryptedBlockReads(u64 physical_block_index, u8* out_ptr,
+                              std::vector<File::BatchRead>* reads);
   bool ReadEncryptedBlock(u64 physical_block_index);
-  void DecryptBlock(u64 logical_block_index);
-  bool ReadAndDecryptBlock(u64 logical_block_index);
+  void DecryptBlock(u64 logical_block_index, const u8* encrypted_block);
+  // If encrypted_block is nullptr, the encrypted data is read from the files.
+  bool ReadAndDecryptBlock(u64 logical_block_index, const u8* encrypted_block = nullptr);
 
   std::array<u8, BLOCK_SIZE> m_current_block_encrypted;
   std::array<u8, BLOCK_SIZE> m_current_block_decrypted;
@@ -63,24 +63,23 @@ bool SplitPlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   u64 current_offset = offset;
   u64 rest = nbytes;
   u8* out = out_ptr;
+  std::vector<File::BatchRead> reads;
   for (auto& file : m_files)
   {
     if (current_offset >= file.offset && current_offset < file.offset + file.size)
     {
-      auto& f = file.file;
       const u64 offset_in_file = current_offset - file.offset;
       const u64 current_read = std::min(file.size - offset_in_file, rest);
-      if (!f.OffsetRead(offset_in_file, out, current_read))
-        return false;
+      reads.push_back({&file.file, offset_in_file, out, current_read});
 
       rest -= current_read;
       if (rest == 0)
-        return true;
+        break;
       current_offset += current_read;
       out += current_read;
     }
   }
 
-  return rest == 0;
+  return rest == 0 && File::OffsetReadBatch(reads);
 }
 }  // namespace DiscIO
@@ -23,6 +23,7 @@
 #include "DiscIO/CachedBlob.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Enums.h"
+#include "DiscIO/FileBlob.h"
 #include "DiscIO/VolumeDisc.h"
 #include "DiscIO/VolumeGC.h"
 #include "DiscIO/VolumeWad.h"
@@ -124,6 +125,13 @@ std::unique_ptr<VolumeDisc> CreateDiscForCore(const std::string& path)
   if (Config::Get(Config::MAIN_LOAD_GAME_INTO_MEMORY))
     return TryCreateDisc(reader, CreateScrubbingCachedBlobReader);
 
+  // Lets the DVD thread hand out data of uncompressed images without copying it.
+  if (Config::Get(Config::MAIN_MEMORY_MAP_DISC_IMAGES))
+  {
+    if (auto* plain_reader = dynamic_cast<PlainFileReader*>(reader.get()))
+      plain_reader->MapIntoMemory();
+  }
+
   return TryCreateDisc(reader);
 }
 
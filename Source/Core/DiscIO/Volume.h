@@ -45,6 +45,13 @@ public:
   Volume() {}
   virtual ~Volume() {}
   virtual bool Read(u64 offset, u64 length, u8* buffer, const Partition& partition) const = 0;
+  // Returns the data without copying it if the blob reader supports that and the data is stored
+  // as is. Returns nullptr otherwise, in which case Read has to be used instead.
+  virtual std::shared_ptr<const u8> ReadView(u64 offset, u64 length,
+                                             const Partition& partition) const
+  {
+    return nullptr;
+  }
   template <typename T>
   std::optional<T> ReadSwapped(u64 offset, const Partition& partition) const
   {
@@ -360,6 +360,9 @@ RedumpVerifier::Result RedumpVerifier::Finish(const Hashes<std::vector<u8>>& has
 }
 
 constexpr u64 DEFAULT_READ_SIZE = 0x20000;  // Arbitrary value
+// How much data may have been read without having been fully checked and hashed yet. This lets
+// the reading of the next chunks overlap with the checking of several previous ones.
+constexpr u64 MAX_BYTES_IN_FLIGHT = 0x2000000;
 
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
                                Hashes<bool> hashes_to_calculate)
@@ -1075,40 +1078,57 @@ void VolumeVerifier::SetUpHashing()
   }
 }
 
-void VolumeVerifier::WaitForAsyncOperations() const
+void VolumeVerifier::WaitForAsyncOperations()
 {
-  if (m_crc32_future.valid())
-    m_crc32_future.wait();
-  if (m_md5_future.valid())
-    m_md5_future.wait();
-  if (m_sha1_future.valid())
-    m_sha1_future.wait();
-  if (m_content_future.valid())
-    m_content_future.wait();
-  if (m_group_future.valid())
-    m_group_future.wait();
+  while (!m_chunks_in_flight.empty())
+    FinishOldestChunk();
 }
 
-bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
+void VolumeVerifier::FinishOldestChunk()
 {
-  std::vector<u8> data(bytes_to_read);
+  const std::unique_ptr<ChunkInFlight> chunk = std::move(m_chunks_in_flight.front());
+  m_chunks_in_flight.pop_front();
+  m_bytes_in_flight -= chunk->size;
 
-  const u64 bytes_to_copy = std::min(m_excess_bytes, bytes_to_read);
+  chunk->tasks.Wait();
+
+  if (chunk->corrupt_content_id)
+  {
+    AddProblem(Severity::High,
+               Common::FmtFormatT("Content {0:08x} is corrupt.", *chunk->corrupt_content_id));
+  }
+
+  if (chunk->group_partition)
+  {
+    if (chunk->block_errors != 0)
+      m_block_errors[*chunk->group_partition] += chunk->block_errors;
+    if (chunk->unused_block_errors != 0)
+      m_unused_block_errors[*chunk->group_partition] += chunk->unused_block_errors;
+    m_biggest_verified_offset = std::max(m_biggest_verified_offset, chunk->biggest_verified_offset);
+  }
+}
+
+bool VolumeVerifier::ReadChunk(u64 bytes_to_read, std::shared_ptr<std::vector<u8>>* data)
+{
+  *data = std::make_shared<std::vector<u8>>(bytes_to_read);
+  u8* out = (*data)->data();
+
+  // After a failed read, the excess bytes aren't available and have to be read again.
+  const u64 bytes_to_copy = m_data ? std::min(m_excess_bytes, bytes_to_read) : 0;
   if (bytes_to_copy > 0)
-    std::memcpy(data.data(), m_data.data() + m_data.size() - m_excess_bytes, bytes_to_copy);
+    std::memcpy(out, m_data->data() + m_data->size() - m_excess_bytes, bytes_to_copy);
   bytes_to_read -= bytes_to_copy;
 
   if (bytes_to_read > 0)
   {
-    if (!m_volume.Read(m_progress + bytes_to_copy, bytes_to_read, data.data() + bytes_to_copy,
+    if (!m_volume.Read(m_progress + bytes_to_copy, bytes_to_read, out + bytes_to_copy,
                        PARTITION_NONE))
     {
       return false;
     }
   }
 
-  WaitForAsyncOperations();
-  m_data = std::move(data);
+  m_data = *data;
   return true;
 }
 
@@ -1183,7 +1203,8 @@ void VolumeVerifier::Process()
   }
 
   const bool is_data_needed = m_calculating_any_hash || content_read || group_read;
-  const bool read_failed = is_data_needed && !ReadChunkAndWaitForAsyncOperations(bytes_to_read);
+  std::shared_ptr<std::vector<u8>> data;
+  const bool read_failed = is_data_needed && !ReadChunk(bytes_to_read, &data);
 
   if (read_failed)
   {
@@ -1191,43 +1212,49 @@ void VolumeVerifier::Process()
 
     m_read_errors_occurred = true;
     m_calculating_any_hash = false;
+    m_data.reset();
   }
 
   m_excess_bytes = excess_bytes;
   const u64 byte_increment = bytes_to_read - excess_bytes;
 
+  // The tasks of a chunk only write to the chunk itself (apart from the hash contexts, which are
+  // only updated through their task sequences), and the chunk is applied to the results once all
+  // of them have finished. This way, the checks of several chunks can run at the same time.
+  auto chunk = std::make_unique<ChunkInFlight>();
+  ChunkInFlight* const chunk_ptr = chunk.get();
+  chunk->size = bytes_to_read;
+
   if (m_calculating_any_hash)
   {
     if (m_hashes_to_calculate.crc32)
     {
-      m_crc32_future = std::async(std::launch::async, [this, byte_increment] {
-        m_crc32_context = Common::UpdateCRC32(m_crc32_context, m_data.data(),
+      m_crc32_sequence.Run(chunk->tasks, [this, data, byte_increment] {
+        m_crc32_context = Common::UpdateCRC32(m_crc32_context, data->data(),
                                               static_cast<size_t>(byte_increment));
       });
     }
 
     if (m_hashes_to_calculate.md5)
     {
-      m_md5_future = std::async(std::launch::async, [this, byte_increment] {
-        mbedtls_md5_update_ret(&m_md5_context, m_data.data(), byte_increment);
+      m_md5_sequence.Run(chunk->tasks, [this, data, byte_increment] {
+        mbedtls_md5_update_ret(&m_md5_context, data->data(), byte_increment);
       });
     }
 
     if (m_hashes_to_calculate.sha1)
     {
-      m_sha1_future = std::async(std::launch::async, [this, byte_increment] {
-        m_sha1_context->Update(m_data.data(), byte_increment);
+      m_sha1_sequence.Run(chunk->tasks, [this, data, byte_increment] {
+        m_sha1_context->Update(data->data(), byte_increment);
       });
     }
   }
 
   if (content_read)
   {
-    m_content_future = std::async(std::launch::async, [this, read_failed, content] {
-      if (read_failed || !m_volume.CheckContentIntegrity(content, m_data, m_ticket))
-      {
-        AddProblem(Severity::High, Common::FmtFormatT("Content {0:08x} is corrupt.", content.id));
-      }
+    chunk->tasks.Run([this, chunk_ptr, data, read_failed, content] {
+      if (read_failed || !m_volume.CheckContentIntegrity(content, *data, m_ticket))
+        chunk_ptr->corrupt_content_id = content.id;
     });
 
     m_content_index++;
@@ -1235,8 +1262,8 @@ void VolumeVerifier::Process()
 
   if (group_read)
   {
-    m_group_future = std::async(std::launch::async, [this, read_failed,
-                                                     group_index = m_group_index] {
+    chunk->group_partition = m_groups[m_group_index].partition;
+    chunk->tasks.Run([this, chunk_ptr, data, read_failed, group_index = m_group_index] {
       const GroupToVerify& group = m_groups[group_index];
       u64 offset_in_group = 0;
       for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
@@ -1245,22 +1272,22 @@ void VolumeVerifier::Process()
         const u64 block_offset = group.offset + offset_in_group;
 
         if (!read_failed && m_volume.CheckBlockIntegrity(
-                                block_index, m_data.data() + offset_in_group, group.partition))
+                                block_index, data->data() + offset_in_group, group.partition))
         {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
+          chunk_ptr->biggest_verified_offset = std::max(
+              chunk_ptr->biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
         }
         else
         {
           if (m_scrubber.CanBlockBeScrubbed(block_offset))
           {
             WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
+            chunk_ptr->unused_block_errors++;
           }
           else
           {
             WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
+            chunk_ptr->block_errors++;
           }
         }
       }
@@ -1269,6 +1296,14 @@ void VolumeVerifier::Process()
     m_group_index++;
   }
 
+  if (is_data_needed)
+  {
+    m_bytes_in_flight += chunk->size;
+    m_chunks_in_flight.push_back(std::move(chunk));
+  }
+  while (m_bytes_in_flight > MAX_BYTES_IN_FLIGHT)
+    FinishOldestChunk();
+
   m_progress += byte_increment;
 }
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <deque>
 #include <future>
 #include <map>
 #include <memory>
@@ -14,6 +15,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/SHA1.h"
+#include "Common/ThreadPool.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/DiscScrubber.h"
 #include "DiscIO/Volume.h"
@@ -144,6 +146,22 @@ private:
     size_t block_index_end;
   };
 
+  // A chunk of the disc which has been read and is being checked and hashed on the thread pool.
+  // The results of the checks are kept here until the chunk is finished, so that the tasks of
+  // several chunks can run at the same time without touching the rest of the verifier.
+  struct ChunkInFlight
+  {
+    u64 size = 0;
+    Common::TaskGroup tasks;
+
+    std::optional<u32> corrupt_content_id;
+
+    std::optional<Partition> group_partition;
+    size_t block_errors = 0;
+    size_t unused_block_errors = 0;
+    u64 biggest_verified_offset = 0;
+  };
+
   std::vector<Partition> CheckPartitions();
   bool CheckPartition(const Partition& partition);  // Returns false if partition should be ignored
   std::string GetPartitionName(std::optional<u32> type) const;
@@ -156,8 +174,9 @@ private:
   void CheckMisc();
   void CheckSuperPaperMario();
   void SetUpHashing();
-  void WaitForAsyncOperations() const;
-  bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  void WaitForAsyncOperations();
+  void FinishOldestChunk();
+  bool ReadChunk(u64 bytes_to_read, std::shared_ptr<std::vector<u8>>* data);
 
   void AddProblem(Severity severity, std::string text);
 
@@ -178,14 +197,15 @@ private:
   u32 m_crc32_context = 0;
   mbedtls_md5_context m_md5_context{};
   std::unique_ptr<Common::SHA1::Context> m_sha1_context;
+  // Each hash has to see the chunks in order, but the three hashes can run alongside each other.
+  Common::TaskSequence m_crc32_sequence;
+  Common::TaskSequence m_md5_sequence;
+  Common::TaskSequence m_sha1_sequence;
 
   u64 m_excess_bytes = 0;
-  std::vector<u8> m_data;
-  std::future<void> m_crc32_future;
-  std::future<void> m_md5_future;
-  std::future<void> m_sha1_future;
-  std::future<void> m_content_future;
-  std::future<void> m_group_future;
+  std::shared_ptr<const std::vector<u8>> m_data;
+  std::deque<std::unique_ptr<ChunkInFlight>> m_chunks_in_flight;
+  u64 m_bytes_in_flight = 0;
 
   DiscScrubber m_scrubber;
   IOS::ES::TicketReader m_ticket;
@@ -7,12 +7,10 @@
 #include <array>
 #include <cstddef>
 #include <cstring>
-#include <future>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
-#include <thread>
 #include <utility>
 #include <vector>
 
@@ -22,6 +20,7 @@
 #include "Common/Crypto/AES.h"
 #include "Common/Crypto/SHA1.h"
 #include "Common/Logging/Log.h"
+#include "Common/ThreadPool.h"
 
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscExtractor.h"
@@ -237,6 +236,23 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
   return true;
 }
 
+std::shared_ptr<const u8> VolumeWii::ReadView(u64 offset, u64 length,
+                                              const Partition& partition) const
+{
+  if (partition == PARTITION_NONE)
+    return m_reader->ReadView(offset, length);
+
+  // Partitions with hashes have to be decrypted or have the hashes skipped, which needs a copy.
+  if (m_has_hashes)
+    return nullptr;
+
+  auto it = m_partitions.find(partition);
+  if (it == m_partitions.end())
+    return nullptr;
+
+  return m_reader->ReadView(partition.offset + *it->second.data_offset + offset, length);
+}
+
 bool VolumeWii::HasWiiHashes() const
 {
   return m_has_hashes;
@@ -509,19 +525,21 @@ bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GR
                           HashBlock out[BLOCKS_PER_GROUP],
                           const std::function<bool(size_t block)>& read_function)
 {
-  std::array<std::future<void>, BLOCKS_PER_GROUP> hash_futures;
   bool success = true;
 
-  for (size_t i = 0; i < BLOCKS_PER_GROUP; ++i)
   {
-    if (read_function && success)
-      success = read_function(i);
+    // Blocks are hashed while the next ones are being read
+    Common::TaskGroup hash_tasks;
 
-    hash_futures[i] = std::async(std::launch::async, [&in, &out, &hash_futures, success, i] {
-      const size_t h1_base = Common::AlignDown(i, 8);
-
-      if (success)
+    for (size_t i = 0; i < BLOCKS_PER_GROUP; ++i)
+    {
+      if (read_function && !read_function(i))
       {
+        success = false;
+        break;
+      }
+
+      hash_tasks.Run([&in, &out, i] {
         // H0 hashes
         for (size_t j = 0; j < 31; ++j)
           out[i].h0[j] = Common::SHA1::CalculateDigest(in[i].data() + j * 0x400, 0x400);
@@ -530,50 +548,38 @@ bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GR
         out[i].padding_0 = {};
 
         // H1 hash
+        const size_t h1_base = Common::AlignDown(i, 8);
         out[h1_base].h1[i - h1_base] = Common::SHA1::CalculateDigest(out[i].h0);
-      }
-
-      if (i % 8 == 7)
-      {
-        for (size_t j = 0; j < 7; ++j)
-          hash_futures[h1_base + j].get();
-
-        if (success)
-        {
-          // H1 padding
-          out[h1_base].padding_1 = {};
+      });
+    }
 
-          // H1 copies
-          for (size_t j = 1; j < 8; ++j)
-            out[h1_base + j].h1 = out[h1_base].h1;
+    hash_tasks.Wait();
+  }
 
-          // H2 hash
-          out[0].h2[h1_base / 8] = Common::SHA1::CalculateDigest(out[i].h1);
-        }
+  if (!success)
+    return false;
 
-        if (i == BLOCKS_PER_GROUP - 1)
-        {
-          for (size_t j = 0; j < 7; ++j)
-            hash_futures[j * 8 + 7].get();
+  for (size_t h1_base = 0; h1_base < BLOCKS_PER_GROUP; h1_base += 8)
+  {
+    // H1 padding
+    out[h1_base].padding_1 = {};
 
-          if (success)
-          {
-            // H2 padding
-            out[0].padding_2 = {};
+    // H1 copies
+    for (size_t j = 1; j < 8; ++j)
+      out[h1_base + j].h1 = out[h1_base].h1;
 
-            // H2 copies
-            for (size_t j = 1; j < BLOCKS_PER_GROUP; ++j)
-              out[j].h2 = out[0].h2;
-          }
-        }
-      }
-    });
+    // H2 hash
+    out[0].h2[h1_base / 8] = Common::SHA1::CalculateDigest(out[h1_base].h1);
   }
 
-  // Wait for all the async tasks to finish
-  hash_futures.back().get();
+  // H2 padding
+  out[0].padding_2 = {};
 
-  return success;
+  // H2 copies
+  for (size_t j = 1; j < BLOCKS_PER_GROUP; ++j)
+    out[j].h2 = out[0].h2;
+
+  return true;
 }
 
 bool VolumeWii::EncryptGroup(
@@ -608,34 +614,30 @@ bool VolumeWii::EncryptGroup(
   if (hash_exception_callback)
     hash_exception_callback(unencrypted_hashes.data());
 
-  const unsigned int threads =
-      std::min(BLOCKS_PER_GROUP, std::max<unsigned int>(1, std::thread::hardware_concurrency()));
-
-  std::vector<std::future<void>> encryption_futures(threads);
-
   auto aes_context = Common::AES::CreateContextEncrypt(key.data());
 
-  for (size_t i = 0; i < threads; ++i)
+  Common::TaskGroup encryption_tasks;
+  const size_t tasks = std::min<size_t>(BLOCKS_PER_GROUP, encryption_tasks.GetThreadCount());
+
+  for (size_t i = 0; i < tasks; ++i)
   {
-    encryption_futures[i] = std::async(
-        std::launch::async,
-        [&unencrypted_data, &unencrypted_hashes, &aes_context, &out](size_t start, size_t end) {
-          for (size_t j = start; j < end; ++j)
-          {
-            u8* out_ptr = out->data() + j * BLOCK_TOTAL_SIZE;
+    encryption_tasks.Run([&unencrypted_data, &unencrypted_hashes, &aes_context, &out,
+                          start = i * BLOCKS_PER_GROUP / tasks,
+                          end = (i + 1) * BLOCKS_PER_GROUP / tasks] {
+      for (size_t j = start; j < end; ++j)
+      {
+        u8* out_ptr = out->data() + j * BLOCK_TOTAL_SIZE;
 
-            aes_context->CryptIvZero(reinterpret_cast<u8*>(&unencrypted_hashes[j]), out_ptr,
-                                     BLOCK_HEADER_SIZE);
+        aes_context->CryptIvZero(reinterpret_cast<u8*>(&unencrypted_hashes[j]), out_ptr,
+                                 BLOCK_HEADER_SIZE);
 
-            aes_context->Crypt(out_ptr + 0x3D0, unencrypted_data[j].data(),
-                               out_ptr + BLOCK_HEADER_SIZE, BLOCK_DATA_SIZE);
-          }
-        },
-        i * BLOCKS_PER_GROUP / threads, (i + 1) * BLOCKS_PER_GROUP / threads);
+        aes_context->Crypt(out_ptr + 0x3D0, unencrypted_data[j].data(),
+                           out_ptr + BLOCK_HEADER_SIZE, BLOCK_DATA_SIZE);
+      }
+    });
   }
 
-  for (std::future<void>& future : encryption_futures)
-    future.get();
+  encryption_tasks.Wait();
 
   return true;
 }
@@ -12,6 +12,7 @@
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -86,7 +87,24 @@ WIARVZFileReader<RVZ>::WIARVZFileReader(File::DirectIOFile file, const std::stri
 }
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::~WIARVZFileReader() = default;
+WIARVZFileReader<RVZ>::~WIARVZFileReader()
+{
+  // Don't decompress chunks which nothing is going to read anymore.
+  for (auto& thread : m_read_ahead_threads)
+    thread->Cancel();
+
+  const ChunkCacheStats& stats = m_chunk_cache_stats;
+  if (stats.read_ahead_chunks != 0)
+  {
+    INFO_LOG_FMT(DISCIO,
+                 "Chunk cache for {}: {} hits, {} misses, {} of {} read-ahead chunks used, "
+                 "waited {} times for {} ms",
+                 m_path, stats.hits, stats.misses, stats.read_ahead_hits, stats.read_ahead_chunks,
+                 stats.read_ahead_waits,
+                 std::chrono::duration_cast<std::chrono::milliseconds>(stats.decompression_wait)
+                     .count());
+  }
+}
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
@@ -153,6 +171,11 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
     return false;
   }
 
+  m_max_cached_chunks =
+      std::clamp<size_t>(CHUNK_CACHE_SIZE / chunk_size, MIN_CACHED_CHUNKS, MAX_CACHED_CHUNKS);
+  // Leave room for the chunks that are being read while the next ones are decompressed.
+  m_read_ahead_chunks = static_cast<u32>(m_max_cached_chunks / 2);
+
   const u32 compression_type = Common::swap32(m_header_2.compression_type);
   m_compression_type = static_cast<WIARVZCompressionType>(compression_type);
   if (m_compression_type > (RVZ ? WIARVZCompressionType::Zstd : WIARVZCompressionType::LZMA2) ||
@@ -504,6 +527,9 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   data_offset -= skipped_data;
   data_size += skipped_data;
 
+  // chunk_size is reduced for the last group below.
+  const u64 group_size = chunk_size;
+
   const u64 start_group_index = (*offset - data_offset) / chunk_size;
   for (u64 i = start_group_index; i < number_of_groups && (*size) > 0; ++i)
   {
@@ -511,42 +537,27 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     if (total_group_index >= m_group_entries.size())
       return false;
 
-    const GroupEntry group = m_group_entries[total_group_index];
+    const GroupData group = GetGroupData(m_group_entries[total_group_index]);
     const u64 group_offset_in_data = i * chunk_size;
     const u64 offset_in_group = *offset - group_offset_in_data - data_offset;
 
     chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
 
     const u64 bytes_to_read = std::min(chunk_size - offset_in_group, *size);
-    u32 group_data_size = Common::swap32(group.data_size);
 
-    WIARVZCompressionType compression_type = m_compression_type;
-    u32 rvz_packed_size = 0;
-    if constexpr (RVZ)
-    {
-      if ((group_data_size & 0x80000000) == 0)
-        compression_type = WIARVZCompressionType::None;
-
-      group_data_size &= 0x7FFFFFFF;
-
-      rvz_packed_size = Common::swap32(group.rvz_packed_size);
-    }
-
-    if (group_data_size == 0)
+    if (group.size == 0)
     {
       std::memset(*out_ptr, 0, bytes_to_read);
     }
     else
     {
-      const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
-
       Chunk& chunk =
-          ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
-                             exception_lists, rvz_packed_size, group_offset_in_data);
+          ReadCompressedData(group.offset_in_file, group.size, chunk_size, group.compression_type,
+                             exception_lists, group.rvz_packed_size, group_offset_in_data);
 
       if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+        EvictCachedChunk(group.offset_in_file);
         return false;
       }
 
@@ -561,6 +572,17 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
       }
     }
 
+    if (total_group_index != m_last_group_index)
+    {
+      if (total_group_index == m_last_group_index + 1)
+        ++m_sequential_groups;
+      else
+        m_sequential_groups = 0;
+      m_last_group_index = total_group_index;
+    }
+    if (m_sequential_groups >= SEQUENTIAL_GROUPS_BEFORE_READ_AHEAD)
+      ReadAhead(i + 1, group_size, data_size, group_index, number_of_groups, exception_lists);
+
     *offset += bytes_to_read;
     *size -= bytes_to_read;
     *out_ptr += bytes_to_read;
@@ -569,6 +591,29 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   return true;
 }
 
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::GroupData
+WIARVZFileReader<RVZ>::GetGroupData(const GroupEntry& group) const
+{
+  GroupData result;
+  result.offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+  result.size = Common::swap32(group.data_size);
+  result.compression_type = m_compression_type;
+  result.rvz_packed_size = 0;
+
+  if constexpr (RVZ)
+  {
+    if ((result.size & 0x80000000) == 0)
+      result.compression_type = WIARVZCompressionType::None;
+
+    result.size &= 0x7FFFFFFF;
+
+    result.rvz_packed_size = Common::swap32(group.rvz_packed_size);
+  }
+
+  return result;
+}
+
 template <bool RVZ>
 typename WIARVZFileReader<RVZ>::Chunk&
 WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
@@ -576,9 +621,46 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                           WIARVZCompressionType compression_type,
                                           u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
 {
-  if (offset_in_file == m_cached_chunk_offset)
-    return m_cached_chunk;
+  const auto it = FindCachedChunk(offset_in_file);
+  if (it == m_cached_chunks.end())
+  {
+    ++m_chunk_cache_stats.misses;
+    return *InsertCachedChunk(offset_in_file,
+                              CreateChunk(offset_in_file, compressed_size, decompressed_size,
+                                          compression_type, exception_lists, rvz_packed_size,
+                                          data_offset))
+                .chunk;
+  }
+
+  ++m_chunk_cache_stats.hits;
+
+  if (it->read_ahead.valid())
+  {
+    ++m_chunk_cache_stats.read_ahead_hits;
+    if (it->read_ahead.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+      const TimePoint wait_start = Clock::now();
+      it->read_ahead.wait();
+      ++m_chunk_cache_stats.read_ahead_waits;
+      m_chunk_cache_stats.decompression_wait += Clock::now() - wait_start;
+    }
+
+    // If decompression failed, reading from the chunk fails the same way, so the result can be
+    // ignored here.
+    it->read_ahead.get();
+  }
 
+  // Mark the chunk as the most recently used one.
+  std::rotate(it, it + 1, m_cached_chunks.end());
+  return *m_cached_chunks.back().chunk;
+}
+
+template <bool RVZ>
+std::shared_ptr<typename WIARVZFileReader<RVZ>::Chunk>
+WIARVZFileReader<RVZ>::CreateChunk(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
+                                   WIARVZCompressionType compression_type, u32 exception_lists,
+                                   u32 rvz_packed_size, u64 data_offset)
+{
   std::unique_ptr<Decompressor> decompressor;
   switch (compression_type)
   {
@@ -607,11 +689,79 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
 
   const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  return std::make_shared<Chunk>(&m_file, offset_in_file, compressed_size, decompressed_size,
+                                 exception_lists, compressed_exception_lists, rvz_packed_size,
+                                 data_offset, std::move(decompressor));
+}
+
+template <bool RVZ>
+typename std::vector<typename WIARVZFileReader<RVZ>::CachedChunk>::iterator
+WIARVZFileReader<RVZ>::FindCachedChunk(u64 offset_in_file)
+{
+  return std::ranges::find(m_cached_chunks, offset_in_file, &CachedChunk::offset_in_file);
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::CachedChunk&
+WIARVZFileReader<RVZ>::InsertCachedChunk(u64 offset_in_file, std::shared_ptr<Chunk> chunk)
+{
+  // A chunk that is still being decompressed by a read-ahead thread can be evicted safely, as
+  // the read-ahead task holds its own reference to the chunk.
+  if (m_cached_chunks.size() >= std::max<size_t>(m_max_cached_chunks, 1))
+    m_cached_chunks.erase(m_cached_chunks.begin());
+
+  return m_cached_chunks.emplace_back(offset_in_file, std::move(chunk), std::future<bool>());
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::EvictCachedChunk(u64 offset_in_file)
+{
+  const auto it = FindCachedChunk(offset_in_file);
+  if (it != m_cached_chunks.end())
+    m_cached_chunks.erase(it);
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::ReadAhead(u64 first_group, u64 chunk_size, u64 data_size,
+                                      u32 group_index, u32 number_of_groups, u32 exception_lists)
+{
+  const u64 end_group = std::min<u64>(first_group + m_read_ahead_chunks, number_of_groups);
+  for (u64 i = first_group; i < end_group; ++i)
+  {
+    const u64 total_group_index = group_index + i;
+    const u64 group_offset_in_data = i * chunk_size;
+    if (total_group_index >= m_group_entries.size() || group_offset_in_data >= data_size)
+      return;
+
+    const GroupData group = GetGroupData(m_group_entries[total_group_index]);
+    if (group.size == 0 || FindCachedChunk(group.offset_in_file) != m_cached_chunks.end())
+      continue;
+
+    if (m_read_ahead_threads.empty())
+    {
+      const u32 thread_count =
+          std::clamp(std::thread::hardware_concurrency() / 2, 1u, MAX_READ_AHEAD_THREADS);
+      for (u32 j = 0; j < thread_count; ++j)
+      {
+        m_read_ahead_threads.emplace_back(
+            std::make_unique<Common::AsyncWorkThreadSP>(RVZ ? "RVZ Read-Ahead" : "WIA Read-Ahead"));
+      }
+    }
+
+    std::shared_ptr<Chunk> chunk =
+        CreateChunk(group.offset_in_file, group.size,
+                    std::min(chunk_size, data_size - group_offset_in_data), group.compression_type,
+                    exception_lists, group.rvz_packed_size, group_offset_in_data);
+
+    auto task = std::make_shared<std::packaged_task<bool()>>(
+        [chunk] { return chunk->DecompressAll(); });
+    InsertCachedChunk(group.offset_in_file, std::move(chunk)).read_ahead = task->get_future();
+
+    m_read_ahead_threads[m_next_read_ahead_thread]->Push([task] { (*task)(); });
+    m_next_read_ahead_thread = (m_next_read_ahead_thread + 1) % m_read_ahead_threads.size();
+
+    ++m_chunk_cache_stats.read_ahead_chunks;
+  }
 }
 
 template <bool RVZ>
@@ -628,9 +778,6 @@ std::string WIARVZFileReader<RVZ>::VersionToString(u32 version)
     return fmt::format("{}.{:02x}.{:02x}.beta{}", a, b, c, d);
 }
 
-template <bool RVZ>
-WIARVZFileReader<RVZ>::Chunk::Chunk() = default;
-
 template <bool RVZ>
 WIARVZFileReader<RVZ>::Chunk::Chunk(File::DirectIOFile* file, u64 offset_in_file,
                                     u64 compressed_size, u64 decompressed_size, u32 exception_lists,
@@ -655,16 +802,29 @@ WIARVZFileReader<RVZ>::Chunk::Chunk(File::DirectIOFile* file, u64 offset_in_file
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 {
-  if (!m_decompressor || !m_file ||
-      offset + size > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
-  {
+  if (!DecompressUntil(offset + size))
     return false;
-  }
 
-  while (offset + size > GetOutBytesWrittenExcludingExceptions())
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressAll()
+{
+  return DecompressUntil(m_out.data.size() - m_out_bytes_allocated_for_exceptions);
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressUntil(u64 end)
+{
+  if (!m_decompressor || !m_file || end > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
+    return false;
+
+  while (end > GetOutBytesWrittenExcludingExceptions())
   {
     u64 bytes_to_read;
-    if (offset + size == m_out.data.size())
+    if (end == m_out.data.size())
     {
       // Read all the remaining data.
       bytes_to_read = m_in.data.size() - m_in.bytes_written;
@@ -677,7 +837,7 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 
       // The compressed data is probably not much bigger than the decompressed data.
       // Add a few bytes for possible compression overhead and for any hash exceptions.
-      bytes_to_read = offset + size - GetOutBytesWrittenExcludingExceptions() + 0x100;
+      bytes_to_read = end - GetOutBytesWrittenExcludingExceptions() + 0x100;
 
       // Align the access in an attempt to gain speed. But we don't actually know the
       // block size of the underlying storage device, so we just use the Wii block size.
@@ -755,7 +915,6 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     }
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
@@ -4,17 +4,20 @@
 #pragma once
 
 #include <array>
+#include <future>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/SHA1.h"
 #include "Common/DirectIOFile.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/WIACompression.h"
@@ -72,6 +75,21 @@ public:
                                       WIARVZCompressionType compression_type, int compression_level,
                                       int chunk_size, CompressCB callback);
 
+  struct ChunkCacheStats
+  {
+    // Lookups of decompressed chunks, including repeated reads from the same chunk.
+    u64 hits = 0;
+    u64 misses = 0;
+    // Chunks which were decompressed ahead of time, and how many of them were used.
+    u64 read_ahead_chunks = 0;
+    u64 read_ahead_hits = 0;
+    // Reads which had to wait for a read-ahead chunk to finish decompressing, and how long for.
+    u64 read_ahead_waits = 0;
+    DT decompression_wait{};
+  };
+
+  ChunkCacheStats GetChunkCacheStats() const { return m_chunk_cache_stats; }
+
 private:
   using WiiKey = std::array<u8, 16>;
 
@@ -188,13 +206,16 @@ private:
   class Chunk
   {
   public:
-    Chunk();
     Chunk(File::DirectIOFile* file, u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
           u32 exception_lists, bool compressed_exception_lists, u32 rvz_packed_size,
           u64 data_offset, std::unique_ptr<Decompressor> decompressor);
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
 
+    // Reads and decompresses the whole chunk without copying it anywhere. Only reads from the
+    // file through positional reads, so chunks can be decompressed on other threads.
+    bool DecompressAll();
+
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
                            u64 exception_list_index, u16 additional_offset) const;
@@ -206,6 +227,7 @@ private:
     }
 
   private:
+    bool DecompressUntil(u64 end);
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
                           size_t* bytes_used, bool align);
@@ -241,6 +263,35 @@ private:
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  std::shared_ptr<Chunk> CreateChunk(u64 offset_in_file, u64 compressed_size,
+                                     u64 decompressed_size, WIARVZCompressionType compression_type,
+                                     u32 exception_lists, u32 rvz_packed_size, u64 data_offset);
+
+  // How the data of a group is stored in the file.
+  struct GroupData
+  {
+    u64 offset_in_file;
+    u32 size;  // Zero if the group only contains zeroes
+    WIARVZCompressionType compression_type;
+    u32 rvz_packed_size;
+  };
+  GroupData GetGroupData(const GroupEntry& group) const;
+
+  struct CachedChunk
+  {
+    u64 offset_in_file;
+    std::shared_ptr<Chunk> chunk;
+    // Valid until the chunk has been used after being queued for read-ahead.
+    std::future<bool> read_ahead;
+  };
+
+  typename std::vector<CachedChunk>::iterator FindCachedChunk(u64 offset_in_file);
+  CachedChunk& InsertCachedChunk(u64 offset_in_file, std::shared_ptr<Chunk> chunk);
+  void EvictCachedChunk(u64 offset_in_file);
+
+  // Starts decompressing the groups after first_group on the read-ahead threads.
+  void ReadAhead(u64 first_group, u64 chunk_size, u64 data_size, u32 group_index,
+                 u32 number_of_groups, u32 exception_lists);
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -368,10 +419,29 @@ private:
 
   File::DirectIOFile m_file;
   std::string m_path;
-  Chunk m_cached_chunk;
-  u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
   WiiEncryptionCache m_encryption_cache;
 
+  // Recently used chunks, the most recently used one last. Seeking back and forth within a few
+  // chunks, as games streaming several files at once do, doesn't have to decompress them again.
+  std::vector<CachedChunk> m_cached_chunks;
+  size_t m_max_cached_chunks = 0;
+  ChunkCacheStats m_chunk_cache_stats;
+
+  // Once the groups of a file are being read one after another, the next few groups are
+  // decompressed in parallel before they are requested.
+  u64 m_last_group_index = std::numeric_limits<u64>::max();
+  u32 m_sequential_groups = 0;
+  u32 m_read_ahead_chunks = 0;
+  std::vector<std::unique_ptr<Common::AsyncWorkThreadSP>> m_read_ahead_threads;
+  size_t m_next_read_ahead_thread = 0;
+
+  // The decompressed size of the cached chunks is kept around this, within the chunk count limits.
+  static constexpr u64 CHUNK_CACHE_SIZE = 16 * 1024 * 1024;
+  static constexpr size_t MIN_CACHED_CHUNKS = 2;
+  static constexpr size_t MAX_CACHED_CHUNKS = 16;
+  static constexpr u32 SEQUENTIAL_GROUPS_BEFORE_READ_AHEAD = 4;
+  static constexpr u32 MAX_READ_AHEAD_THREADS = 4;
+
   std::vector<HashExceptionEntry> m_exception_list;
   bool m_write_to_exception_list = false;
   u64 m_exception_list_last_group_index;
@@ -124,6 +124,8 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   if (offset + nbytes > GetDataSize())
     return false;
 
+  // Clusters can be anywhere in the files, so they are read concurrently where possible.
+  std::vector<File::BatchRead> reads;
   while (nbytes)
   {
     u64 read_size;
@@ -132,17 +134,14 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
       return false;
     read_size = std::min(read_size, nbytes);
 
-    if (!data_file.Read(out_ptr, read_size))
-    {
-      return false;
-    }
+    reads.push_back({&data_file, data_file.Tell(), out_ptr, read_size});
 
     out_ptr += read_size;
     nbytes -= read_size;
     offset += read_size;
   }
 
-  return true;
+  return File::OffsetReadBatch(reads);
 }
 
 File::DirectIOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
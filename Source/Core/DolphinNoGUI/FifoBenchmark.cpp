@@ -0,0 +1,263 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/FifoBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <picojson.h>
+
+#include "Common/Config/Config.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/JsonUtil.h"
+#include "Common/Version.h"
+#include "Core/Boot/Boot.h"
+#include "Core/BootManager.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "Core/System.h"
+#include "DolphinNoGUI/Platform.h"
+#include "VideoCommon/Spirv.h"
+#include "VideoCommon/StageTimers.h"
+#include "VideoCommon/VideoBackendBase.h"
+
+namespace FifoBenchmark
+{
+namespace
+{
+struct RunResult
+{
+  bool booted = false;
+  bool finished = false;
+  u32 frames = 0;
+  DT elapsed{};
+  std::vector<DT> frame_times;
+  StageTimers::Totals stages{};
+  SPIRV::CacheStats spirv_cache{};
+};
+
+// Only accessed from the CPU thread while the log is playing.
+struct RunState
+{
+  u32 frames_to_replay = 0;
+  u32 frames_started = 0;
+  TimePoint start_time;
+  TimePoint last_frame_time;
+  RunResult result;
+};
+
+std::vector<std::string> FindFifoLogs(const std::string& path)
+{
+  if (!File::IsDirectory(path))
+    return {path};
+
+  std::vector<std::string> files = Common::DoFileSearch(path, ".dff");
+  std::ranges::sort(files);
+  return files;
+}
+
+bool IsAvailableBackend(const std::string& name)
+{
+  const auto& backends = VideoBackendBase::GetAvailableBackends();
+  return std::ranges::any_of(
+      backends, [&name](const auto& backend) { return backend->GetConfigName() == name; });
+}
+
+double ToMilliseconds(DT time)
+{
+  return std::chrono::duration<double, std::milli>(time).count();
+}
+
+RunResult ReplayFifoLog(Platform& platform, const WindowSystemInfo& wsi, const std::string& path,
+                        const std::string& backend, u32 loops)
+{
+  // The command line layer is never saved, so none of this leaks into the user's configuration.
+  Config::Set(Config::LayerType::CommandLine, Config::MAIN_GFX_BACKEND, backend);
+  Config::Set(Config::LayerType::CommandLine, Config::MAIN_FIFOPLAYER_LOOP_REPLAY, true);
+  Config::Set(Config::LayerType::CommandLine, Config::MAIN_EMULATION_SPEED, 0.0f);
+
+  auto& system = Core::System::GetInstance();
+  FifoPlayer& player = system.GetFifoPlayer();
+
+  RunState state;
+  player.SetFrameWrittenCallback([&state, &player, &platform, loops] {
+    if (state.result.finished)
+      return;
+
+    // This is called just before a frame is written. FifoPlayer waits for the GPU to go idle at
+    // the end of every frame, so the previous frame has been completely processed by now.
+    const TimePoint now = Clock::now();
+    if (state.frames_started == 0)
+    {
+      state.frames_to_replay =
+          (player.GetFrameRangeEnd() - player.GetFrameRangeStart() + 1) * loops;
+      state.start_time = now;
+      StageTimers::Reset();
+      StageTimers::SetEnabled(true);
+      SPIRV::ResetCacheStats();
+    }
+    else
+    {
+      state.result.frame_times.push_back(now - state.last_frame_time);
+    }
+    state.last_frame_time = now;
+
+    if (state.frames_started++ < state.frames_to_replay)
+      return;
+
+    StageTimers::SetEnabled(false);
+    state.result.stages = StageTimers::GetTotals();
+    state.result.spirv_cache = SPIRV::GetCacheStats();
+    state.result.frames = state.frames_to_replay;
+    state.result.elapsed = now - state.start_time;
+    state.result.finished = true;
+    platform.Stop();
+  });
+
+  platform.Restart();
+  state.result.booted = BootManager::BootCore(system, BootParameters::GenerateFromFile(path), wsi);
+  if (state.result.booted)
+    platform.MainLoop();
+
+  Core::Stop(system);
+  Core::Shutdown(system);
+
+  player.SetFrameWrittenCallback(nullptr);
+  StageTimers::SetEnabled(false);
+
+  return std::move(state.result);
+}
+
+picojson::object ToJson(const std::string& path, const std::string& backend,
+                        const RunResult& result)
+{
+  picojson::object json;
+  json["file"] = picojson::value(path);
+  json["backend"] = picojson::value(backend);
+  if (!result.finished)
+  {
+    json["error"] = picojson::value(result.booted ? "Replay was interrupted" : "Failed to boot");
+    return json;
+  }
+
+  const double seconds = std::chrono::duration<double>(result.elapsed).count();
+  json["frames"] = picojson::value(static_cast<double>(result.frames));
+  json["seconds"] = picojson::value(seconds);
+  json["fps"] = picojson::value(seconds > 0.0 ? result.frames / seconds : 0.0);
+
+  std::vector<DT> frame_times = result.frame_times;
+  std::ranges::sort(frame_times);
+  picojson::object frame_time_json;
+  if (!frame_times.empty())
+  {
+    frame_time_json["min"] = picojson::value(ToMilliseconds(frame_times.front()));
+    frame_time_json["median"] =
+        picojson::value(ToMilliseconds(frame_times[frame_times.size() / 2]));
+    frame_time_json["p95"] =
+        picojson::value(ToMilliseconds(frame_times[frame_times.size() * 95 / 100]));
+    frame_time_json["max"] = picojson::value(ToMilliseconds(frame_times.back()));
+  }
+  json["frame_time_ms"] = picojson::value(std::move(frame_time_json));
+
+  picojson::object stages_json;
+  for (size_t i = 0; i < result.stages.size(); i++)
+  {
+    const StageTimers::StageTotals& totals = result.stages[i];
+    const double milliseconds = ToMilliseconds(totals.time);
+
+    picojson::object stage_json;
+    stage_json["calls"] = picojson::value(static_cast<double>(totals.calls));
+    stage_json["ms"] = picojson::value(milliseconds);
+    stage_json["ms_per_frame"] =
+        picojson::value(result.frames != 0 ? milliseconds / result.frames : 0.0);
+    stages_json[StageTimers::GetStageName(static_cast<StageTimers::Stage>(i))] =
+        picojson::value(std::move(stage_json));
+  }
+  json["stages"] = picojson::value(std::move(stages_json));
+
+  // Only backends which compile their shaders through glslang use the SPIR-V cache.
+  picojson::object spirv_cache_json;
+  spirv_cache_json["hits"] = picojson::value(static_cast<double>(result.spirv_cache.hits));
+  spirv_cache_json["misses"] = picojson::value(static_cast<double>(result.spirv_cache.misses));
+  json["spirv_cache"] = picojson::value(std::move(spirv_cache_json));
+
+  return json;
+}
+}  // namespace
+
+int Run(Platform& platform, const WindowSystemInfo& wsi, const Options& options)
+{
+  const std::vector<std::string> files = FindFifoLogs(options.path);
+  if (files.empty())
+  {
+    fprintf(stderr, "No FIFO logs found in %s\n", options.path.c_str());
+    return EXIT_FAILURE;
+  }
+
+  for (const std::string& backend : options.backends)
+  {
+    if (!IsAvailableBackend(backend))
+    {
+      fprintf(stderr, "Unknown video backend: %s\n", backend.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  bool all_finished = true;
+  bool interrupted = false;
+  picojson::array results;
+  for (const std::string& file : files)
+  {
+    for (const std::string& backend : options.backends)
+    {
+      const RunResult result = ReplayFifoLog(platform, wsi, file, backend, options.loops);
+      results.emplace_back(ToJson(file, backend, result));
+
+      if (!result.finished)
+      {
+        all_finished = false;
+        fprintf(stderr, "%s [%s]: %s\n", file.c_str(), backend.c_str(),
+                result.booted ? "interrupted" : "failed to boot");
+
+        // A replay only stops early if the user asked us to quit
+        interrupted = result.booted;
+        if (interrupted)
+          break;
+        continue;
+      }
+
+      const double seconds = std::chrono::duration<double>(result.elapsed).count();
+      fprintf(stderr, "%s [%s]: %u frames in %.3f s (%.2f fps)\n", file.c_str(), backend.c_str(),
+              result.frames, seconds, seconds > 0.0 ? result.frames / seconds : 0.0);
+    }
+
+    if (interrupted)
+      break;
+  }
+
+  picojson::object root;
+  root["revision"] = picojson::value(Common::GetScmDescStr());
+  root["loops"] = picojson::value(static_cast<double>(options.loops));
+  root["results"] = picojson::value(std::move(results));
+  const picojson::value root_value(std::move(root));
+
+  if (options.output_path.empty())
+  {
+    printf("%s\n", root_value.serialize(true).c_str());
+  }
+  else if (!JsonToFile(options.output_path, root_value, true))
+  {
+    fprintf(stderr, "Failed to write %s\n", options.output_path.c_str());
+    return EXIT_FAILURE;
+  }
+
+  return all_finished ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace FifoBenchmark
@@ -0,0 +1,29 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WindowSystemInfo.h"
+
+class Platform;
+
+namespace FifoBenchmark
+{
+struct Options
+{
+  // A .dff file, or a directory whose .dff files are all replayed
+  std::string path;
+  std::vector<std::string> backends;
+  u32 loops = 1;
+  // Results are printed to stdout if empty
+  std::string output_path;
+};
+
+// Replays each FIFO log once per backend, as fast as possible, and reports frame rates and the
+// time spent in each GPU stage as JSON. Returns the process exit code.
+int Run(Platform& platform, const WindowSystemInfo& wsi, const Options& options);
+}  // namespace FifoBenchmark
@@ -4,8 +4,10 @@
 #include "DolphinNoGUI/Platform.h"
 
 #include <OptionParser.h>
+#include <algorithm>
 #include <csignal>
 #include <cstdio>
+#include <list>
 #include <string>
 #include <vector>
 
@@ -22,6 +24,7 @@
 #include "Core/DolphinAnalytics.h"
 #include "Core/Host.h"
 #include "Core/System.h"
+#include "DolphinNoGUI/FifoBenchmark.h"
 
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
@@ -209,6 +212,26 @@ int main(const int argc, char* argv[])
                 "macos"
 #endif
       });
+  parser->add_option("--fifo_benchmark")
+      .action("store")
+      .metavar("<file or directory>")
+      .type("string")
+      .help("Replay FIFO logs as fast as possible, print their performance as JSON and exit");
+  parser->add_option("--benchmark_backend")
+      .action("append")
+      .metavar("<backend>")
+      .type("string")
+      .help("Video backend to replay FIFO logs with (default: Null and Software Renderer)");
+  parser->add_option("--benchmark_loops")
+      .action("store")
+      .type("int")
+      .set_default(1)
+      .help("Number of times to replay each FIFO log");
+  parser->add_option("--benchmark_output")
+      .action("store")
+      .metavar("<file>")
+      .type("string")
+      .help("Write the FIFO benchmark results to a file instead of stdout");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -221,7 +244,12 @@ int main(const int argc, char* argv[])
 
   std::unique_ptr<BootParameters> boot;
   bool game_specified = false;
-  if (options.is_set("exec"))
+  const bool fifo_benchmark = options.is_set("fifo_benchmark");
+  if (fifo_benchmark)
+  {
+    // Each FIFO log is booted by the benchmark itself
+  }
+  else if (options.is_set("exec"))
   {
     const std::list<std::string> paths_list = options.all("exec");
     const std::vector<std::string> paths{std::make_move_iterator(std::begin(paths_list)),
@@ -259,7 +287,11 @@ int main(const int argc, char* argv[])
   if (options.is_set("user"))
     user_directory = static_cast<const char*>(options.get("user"));
 
-  s_platform = GetPlatform(options);
+  // Benchmarks shouldn't be affected by presenting to a window unless one was explicitly requested
+  if (fifo_benchmark && !options.is_set_by_user("platform"))
+    s_platform = Platform::CreateHeadlessPlatform();
+  else
+    s_platform = GetPlatform(options);
   if (!s_platform || !s_platform->Init())
   {
     fprintf(stderr, "No platform found, or failed to initialize.\n");
@@ -303,6 +335,28 @@ int main(const int argc, char* argv[])
 
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
 
+  if (fifo_benchmark)
+  {
+    FifoBenchmark::Options benchmark_options;
+    benchmark_options.path = static_cast<const char*>(options.get("fifo_benchmark"));
+    benchmark_options.loops = std::max(static_cast<int>(options.get("benchmark_loops")), 1);
+    if (options.is_set("benchmark_output"))
+      benchmark_options.output_path = static_cast<const char*>(options.get("benchmark_output"));
+    if (options.is_set("benchmark_backend"))
+    {
+      const std::list<std::string> backends = options.all("benchmark_backend");
+      benchmark_options.backends.assign(backends.begin(), backends.end());
+    }
+    else
+    {
+      benchmark_options.backends = {"Null", "Software Renderer"};
+    }
+
+    const int result = FifoBenchmark::Run(*s_platform, wsi, benchmark_options);
+    s_platform.reset();
+    return result;
+  }
+
   if (!BootManager::BootCore(Core::System::GetInstance(), std::move(boot), wsi))
   {
     fprintf(stderr, "Could not boot the specified file\n");
@@ -44,6 +44,13 @@ void Platform::Stop()
   m_running.Clear();
 }
 
+void Platform::Restart()
+{
+  m_shutdown_requested.Clear();
+  m_tried_graceful_shutdown.Clear();
+  m_running.Set();
+}
+
 void Platform::RequestShutdown()
 {
   m_shutdown_requested.Set();
@@ -30,6 +30,9 @@ public:
   // Request an immediate shutdown.
   void Stop();
 
+  // Allows MainLoop() to run again after a shutdown, so that another title can be booted.
+  void Restart();
+
   static std::unique_ptr<Platform> CreateHeadlessPlatform();
 #ifdef HAVE_X11
   static std::unique_ptr<Platform> CreateX11Platform();
@@ -47,11 +47,14 @@ void HacksWidget::CreateWidgets()
                                       Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM, m_game_layer);
   m_defer_efb_copies = new ConfigBool(tr("Defer EFB Copies to RAM"),
                                       Config::GFX_HACK_DEFER_EFB_COPIES, m_game_layer);
+  m_efb_copy_dedup = new ConfigBool(tr("Skip Unchanged EFB Copies"),
+                                    Config::GFX_HACK_EFB_COPY_DEDUPLICATION, m_game_layer);
 
   efb_layout->addWidget(m_skip_efb_cpu, 0, 0);
   efb_layout->addWidget(m_ignore_format_changes, 0, 1);
   efb_layout->addWidget(m_store_efb_copies, 1, 0);
   efb_layout->addWidget(m_defer_efb_copies, 1, 1);
+  efb_layout->addWidget(m_efb_copy_dedup, 2, 0);
 
   // Texture Cache
   auto* texture_cache_box = new QGroupBox(tr("Texture Cache"));
@@ -186,6 +189,12 @@ void HacksWidget::AddDescriptions()
       "many games, at the risk of breaking those which do not safely synchronize with the "
       "emulated GPU.<br><br><dolphin_emphasis>If unsure, leave this "
       "checked.</dolphin_emphasis>");
+  static const char TR_EFB_COPY_DEDUP_DESCRIPTION[] = QT_TR_NOOP(
+      "Skips EFB copies when nothing that was rendered to the EFB has changed since the same copy "
+      "was last made, reusing the previous copy instead.<br><br>Speeds up games which repeatedly "
+      "copy the same content, such as static menus and shadow maps, at the cost of hashing every "
+      "draw. May cause graphical defects if a draw depends on state that isn't tracked."
+      "<br><br><dolphin_emphasis>If unsure, leave this unchecked.</dolphin_emphasis>");
   static const char TR_ACCUARCY_DESCRIPTION[] = QT_TR_NOOP(
       "Adjusts the accuracy at which the GPU receives texture updates from RAM.<br><br>"
       "The \"Safe\" setting eliminates the likelihood of the GPU missing texture updates "
@@ -248,6 +257,7 @@ void HacksWidget::AddDescriptions()
   m_ignore_format_changes->SetDescription(tr(TR_IGNORE_FORMAT_CHANGE_DESCRIPTION));
   m_store_efb_copies->SetDescription(tr(TR_STORE_EFB_TO_TEXTURE_DESCRIPTION));
   m_defer_efb_copies->SetDescription(tr(TR_DEFER_EFB_COPIES_DESCRIPTION));
+  m_efb_copy_dedup->SetDescription(tr(TR_EFB_COPY_DEDUP_DESCRIPTION));
   m_accuracy->SetTitle(tr("Texture Cache Accuracy"));
   m_accuracy->SetDescription(tr(TR_ACCUARCY_DESCRIPTION));
   m_store_xfb_copies->SetDescription(tr(TR_STORE_XFB_TO_TEXTURE_DESCRIPTION));
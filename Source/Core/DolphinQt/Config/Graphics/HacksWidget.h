@@ -29,6 +29,7 @@ private:
   ConfigBool* m_ignore_format_changes;
   ConfigBool* m_store_efb_copies;
   ConfigBool* m_defer_efb_copies;
+  ConfigBool* m_efb_copy_dedup;
 
   // Texture Cache
   ConfigSliderLabel* m_accuracy_label;
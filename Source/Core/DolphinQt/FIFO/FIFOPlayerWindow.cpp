@@ -247,6 +247,17 @@ void FIFOPlayerWindow::SaveRecording()
   if (path.isEmpty())
     return;
 
+  // The loaded log stays open while it is played, so it can't be replaced on every platform.
+  const FifoDataFile* loaded_file = m_fifo_player.GetFile();
+  if (loaded_file && loaded_file->StreamsFrom(path.toStdString()))
+  {
+    ModalMessageBox::critical(
+        this, tr("Error"),
+        tr("The FIFO log can't be saved over the log that is currently loaded. Choose a "
+           "different file."));
+    return;
+  }
+
   FifoDataFile* file = m_fifo_recorder.GetRecordedFile();
 
   bool result = file->Save(path.toStdString());
@@ -319,14 +330,21 @@ void FIFOPlayerWindow::UpdateInfo()
 
     for (u32 i = 0; i < file->GetFrameCount(); ++i)
     {
-      fifo_bytes += file->GetFrame(i).fifoData.size();
-      for (const auto& mem_update : file->GetFrame(i).memoryUpdates)
+      const auto frame = file->GetFrame(i);
+      fifo_bytes += frame->fifoData.size();
+      for (const auto& mem_update : frame->memoryUpdates)
         mem_bytes += mem_update.data.size();
     }
 
-    m_info_label->setText(tr("%1 FIFO bytes\n%2 memory bytes\n%3 frames")
+    const FifoRecorder::Stats stats = m_fifo_recorder.GetStats();
+    const double overhead_ms =
+        stats.frames != 0 ? DT_ms(stats.total_overhead).count() / stats.frames : 0.0;
+
+    m_info_label->setText(tr("%1 FIFO bytes\n%2 memory bytes\n%3 frames (%4 ms recording "
+                             "overhead per frame)")
                               .arg(QString::number(fifo_bytes), QString::number(mem_bytes),
-                                   QString::number(file->GetFrameCount())));
+                                   QString::number(file->GetFrameCount()),
+                                   QString::number(overhead_ms, 'f', 2)));
     return;
   }
 
@@ -0,0 +1,581 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/BenchmarkCommand.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/DirectIOFile.h"
+#include "Common/StringUtil.h"
+#include "Common/Swap.h"
+#include "Common/ThreadPool.h"
+#include "Core/IOS/ES/Formats.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/DiscUtils.h"
+#include "DiscIO/Volume.h"
+#include "DiscIO/VolumeVerifier.h"
+#include "DiscIO/VolumeWii.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+namespace
+{
+// Supplies made-up decrypted Wii partition data, so that EncryptGroup can be measured without
+// being limited by disk or decompression speed.
+class SyntheticWiiReader final : public DiscIO::BlobReader
+{
+public:
+  SyntheticWiiReader() = default;
+
+  // The given data replaces the start of the partition, where a real one has its disc header and
+  // file system table.
+  explicit SyntheticWiiReader(std::vector<u8> partition_header)
+      : m_partition_header(std::move(partition_header))
+  {
+  }
+
+  DiscIO::BlobType GetBlobType() const override { return DiscIO::BlobType::PLAIN; }
+  std::unique_ptr<BlobReader> CopyReader() const override
+  {
+    return std::make_unique<SyntheticWiiReader>(m_partition_header);
+  }
+
+  u64 GetRawSize() const override { return std::numeric_limits<u64>::max(); }
+  u64 GetDataSize() const override { return std::numeric_limits<u64>::max(); }
+  DiscIO::DataSizeType GetDataSizeType() const override
+  {
+    return DiscIO::DataSizeType::Accurate;
+  }
+
+  u64 GetBlockSize() const override { return 0; }
+  bool HasFastRandomAccessInBlock() const override { return true; }
+  std::string GetCompressionMethod() const override { return {}; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override
+  {
+    Fill(offset, size, out_ptr);
+    return true;
+  }
+
+  bool SupportsReadWiiDecrypted(u64, u64, u64) const override { return true; }
+
+  bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64) override
+  {
+    Fill(offset, size, out_ptr);
+    return true;
+  }
+
+private:
+  void Fill(u64 offset, u64 size, u8* out_ptr) const
+  {
+    std::memset(out_ptr, static_cast<u8>(offset / DiscIO::VolumeWii::BLOCK_DATA_SIZE), size);
+
+    if (offset < m_partition_header.size())
+    {
+      std::memcpy(out_ptr, m_partition_header.data() + offset,
+                  std::min<u64>(size, m_partition_header.size() - offset));
+    }
+  }
+
+  std::vector<u8> m_partition_header;
+};
+
+// A Wii disc with a single data partition of SyntheticWiiReader data, encrypted and hashed like a
+// retail disc, so that verification can be measured reproducibly without a copyrighted image.
+// Every group after the first one is identical, so only two groups have to be kept in memory. The
+// ticket and TMD aren't signed, which the verifier reports as a problem, but all hashes and block
+// checks still run.
+class SyntheticWiiDiscReader final : public DiscIO::BlobReader
+{
+public:
+  static std::unique_ptr<SyntheticWiiDiscReader> Create(u64 groups);
+
+  DiscIO::BlobType GetBlobType() const override { return DiscIO::BlobType::PLAIN; }
+  std::unique_ptr<BlobReader> CopyReader() const override
+  {
+    return std::make_unique<SyntheticWiiDiscReader>(*this);
+  }
+
+  u64 GetRawSize() const override
+  {
+    return m_header->size() + m_group_count * DiscIO::VolumeWii::GROUP_TOTAL_SIZE;
+  }
+  u64 GetDataSize() const override { return GetRawSize(); }
+  DiscIO::DataSizeType GetDataSizeType() const override
+  {
+    return DiscIO::DataSizeType::Accurate;
+  }
+
+  u64 GetBlockSize() const override { return 0; }
+  bool HasFastRandomAccessInBlock() const override { return true; }
+  std::string GetCompressionMethod() const override { return {}; }
+  std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override
+  {
+    using DiscIO::VolumeWii;
+
+    if (offset > GetRawSize() || size > GetRawSize() - offset)
+      return false;
+
+    while (size > 0)
+    {
+      const u8* source;
+      u64 available;
+      if (offset < m_header->size())
+      {
+        source = m_header->data() + offset;
+        available = m_header->size() - offset;
+      }
+      else
+      {
+        const u64 group = (offset - m_header->size()) / VolumeWii::GROUP_TOTAL_SIZE;
+        const u64 offset_in_group = (offset - m_header->size()) % VolumeWii::GROUP_TOTAL_SIZE;
+        source = m_groups->data() + std::min<u64>(group, 1) * VolumeWii::GROUP_TOTAL_SIZE +
+                 offset_in_group;
+        available = VolumeWii::GROUP_TOTAL_SIZE - offset_in_group;
+      }
+
+      const u64 bytes_to_copy = std::min(size, available);
+      std::memcpy(out_ptr, source, bytes_to_copy);
+      offset += bytes_to_copy;
+      size -= bytes_to_copy;
+      out_ptr += bytes_to_copy;
+    }
+
+    return true;
+  }
+
+  SyntheticWiiDiscReader(std::shared_ptr<const std::vector<u8>> header,
+                         std::shared_ptr<const std::vector<u8>> groups, u64 group_count)
+      : m_header(std::move(header)), m_groups(std::move(groups)), m_group_count(group_count)
+  {
+  }
+
+private:
+  // Everything before the encrypted partition data: the disc header, the partition table, and the
+  // partition's ticket, TMD and H3 table
+  std::shared_ptr<const std::vector<u8>> m_header;
+  // The first group of the partition, followed by the group which is repeated for all others
+  std::shared_ptr<const std::vector<u8>> m_groups;
+  u64 m_group_count;
+};
+
+std::unique_ptr<SyntheticWiiDiscReader> SyntheticWiiDiscReader::Create(u64 groups)
+{
+  using DiscIO::VolumeWii;
+
+  if (groups == 0 || groups > DiscIO::WII_PARTITION_H3_SIZE / Common::SHA1::DIGEST_LEN)
+    return nullptr;
+
+  constexpr u64 PARTITION_TABLE_OFFSET = 0x40020;
+  constexpr u64 PARTITION_OFFSET = 0x50000;
+  constexpr u64 TMD_OFFSET = 0x2c0;
+  constexpr u64 TMD_SIZE = sizeof(IOS::ES::TMDHeader) + sizeof(IOS::ES::Content);
+  constexpr u64 H3_OFFSET = 0x8000;
+  constexpr u64 DATA_OFFSET = 0x20000;
+  constexpr u64 FST_OFFSET = 0x440;
+  constexpr u64 FST_SIZE = 0x10;
+  constexpr std::string_view GAME_ID = "DTLE01";
+  constexpr u64 TITLE_ID = 0x0001000044544C45;
+
+  const auto write_u16 = [](std::vector<u8>* buffer, u64 offset, u16 value) {
+    value = Common::swap16(value);
+    std::memcpy(buffer->data() + offset, &value, sizeof(value));
+  };
+  const auto write_u32 = [](std::vector<u8>* buffer, u64 offset, u32 value) {
+    value = Common::swap32(value);
+    std::memcpy(buffer->data() + offset, &value, sizeof(value));
+  };
+  const auto write_u64 = [](std::vector<u8>* buffer, u64 offset, u64 value) {
+    value = Common::swap64(value);
+    std::memcpy(buffer->data() + offset, &value, sizeof(value));
+  };
+
+  // The decrypted partition starts with a disc header and a file system which only has a root
+  std::vector<u8> partition_header(FST_OFFSET + FST_SIZE);
+  std::ranges::copy(GAME_ID, partition_header.begin());
+  write_u32(&partition_header, 0x18, DiscIO::WII_DISC_MAGIC);
+  write_u32(&partition_header, 0x424, FST_OFFSET >> 2);
+  write_u32(&partition_header, 0x428, FST_SIZE >> 2);
+  write_u32(&partition_header, 0x42C, FST_SIZE >> 2);
+  partition_header[FST_OFFSET] = 1;
+  write_u32(&partition_header, FST_OFFSET + 8, 1);
+
+  auto header = std::make_shared<std::vector<u8>>(PARTITION_OFFSET + DATA_OFFSET);
+  std::ranges::copy(GAME_ID, header->begin());
+  write_u32(header.get(), 0x18, DiscIO::WII_DISC_MAGIC);
+  write_u32(header.get(), 0x40000, 1);
+  write_u32(header.get(), 0x40004, PARTITION_TABLE_OFFSET >> 2);
+  write_u32(header.get(), PARTITION_TABLE_OFFSET, PARTITION_OFFSET >> 2);
+  write_u32(header.get(), PARTITION_TABLE_OFFSET + 4, DiscIO::PARTITION_DATA);
+
+  const u64 partition = PARTITION_OFFSET;
+  write_u32(header.get(), partition + DiscIO::WII_PARTITION_TMD_SIZE_ADDRESS, TMD_SIZE);
+  write_u32(header.get(), partition + DiscIO::WII_PARTITION_TMD_OFFSET_ADDRESS, TMD_OFFSET >> 2);
+  write_u32(header.get(), partition + DiscIO::WII_PARTITION_H3_OFFSET_ADDRESS, H3_OFFSET >> 2);
+  write_u32(header.get(), partition + 0x2b8, DATA_OFFSET >> 2);
+  write_u32(header.get(), partition + 0x2bc, (groups * VolumeWii::GROUP_TOTAL_SIZE) >> 2);
+
+  std::vector<u8> ticket(sizeof(IOS::ES::Ticket));
+  write_u32(&ticket, 0, static_cast<u32>(IOS::SignatureType::RSA2048));
+  std::ranges::copy(std::string_view("Root-CA00000001-XS00000003"),
+                    ticket.begin() + offsetof(IOS::ES::Ticket, signature.issuer));
+  write_u64(&ticket, offsetof(IOS::ES::Ticket, title_id), TITLE_ID);
+  std::ranges::copy(ticket, header->begin() + partition);
+
+  std::vector<u8> tmd(TMD_SIZE);
+  write_u32(&tmd, 0, static_cast<u32>(IOS::SignatureType::RSA2048));
+  std::ranges::copy(std::string_view("Root-CA00000001-CP00000004"),
+                    tmd.begin() + offsetof(IOS::ES::TMDHeader, signature.issuer));
+  write_u64(&tmd, offsetof(IOS::ES::TMDHeader, ios_id), 0x000000010000003A);
+  write_u64(&tmd, offsetof(IOS::ES::TMDHeader, title_id), TITLE_ID);
+  write_u16(&tmd, offsetof(IOS::ES::TMDHeader, num_contents), 1);
+  write_u64(&tmd, sizeof(IOS::ES::TMDHeader) + offsetof(IOS::ES::Content, size),
+            groups * VolumeWii::GROUP_DATA_SIZE);
+
+  const std::array<u8, VolumeWii::AES_KEY_SIZE> key =
+      IOS::ES::TicketReader(std::move(ticket)).GetTitleKey();
+  SyntheticWiiReader data_reader(std::move(partition_header));
+  auto encrypted_groups = std::make_shared<std::vector<u8>>(2 * VolumeWii::GROUP_TOTAL_SIZE);
+  auto encrypted_group = std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>();
+  for (u64 i = 0; i < 2; ++i)
+  {
+    Common::SHA1::Digest h3;
+    const auto get_h3 = [&h3](VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) {
+      h3 = Common::SHA1::CalculateDigest(hash_blocks[0].h2);
+    };
+    if (!VolumeWii::EncryptGroup(i * VolumeWii::GROUP_DATA_SIZE, 0,
+                                 groups * VolumeWii::GROUP_DATA_SIZE, key, &data_reader,
+                                 encrypted_group.get(), get_h3))
+    {
+      return nullptr;
+    }
+    std::ranges::copy(*encrypted_group,
+                      encrypted_groups->begin() + i * VolumeWii::GROUP_TOTAL_SIZE);
+
+    // The second group also stands in for all of the groups after it
+    for (u64 j = i; j < (i == 0 ? 1 : groups); ++j)
+    {
+      std::ranges::copy(h3, header->begin() + partition + H3_OFFSET +
+                                j * Common::SHA1::DIGEST_LEN);
+    }
+  }
+
+  const Common::SHA1::Digest h3_table_hash = Common::SHA1::CalculateDigest(
+      header->data() + partition + H3_OFFSET, DiscIO::WII_PARTITION_H3_SIZE);
+  std::ranges::copy(h3_table_hash, tmd.begin() + sizeof(IOS::ES::TMDHeader) +
+                                       offsetof(IOS::ES::Content, sha1));
+  std::ranges::copy(tmd, header->begin() + partition + TMD_OFFSET);
+
+  return std::make_unique<SyntheticWiiDiscReader>(std::move(header), std::move(encrypted_groups),
+                                                  groups);
+}
+
+bool RunJob(const std::string& operation, u64 groups)
+{
+  using DiscIO::VolumeWii;
+
+  SyntheticWiiReader reader;
+  const std::array<u8, VolumeWii::AES_KEY_SIZE> key{};
+  auto encrypted = std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>();
+  std::vector<std::array<u8, VolumeWii::BLOCK_DATA_SIZE>> data(VolumeWii::BLOCKS_PER_GROUP);
+  std::vector<VolumeWii::HashBlock> hashes(VolumeWii::BLOCKS_PER_GROUP);
+
+  for (u64 i = 0; i < groups; ++i)
+  {
+    const u64 offset = i * VolumeWii::GROUP_DATA_SIZE;
+
+    if (operation == "hash")
+    {
+      for (size_t j = 0; j < data.size(); ++j)
+        reader.ReadWiiDecrypted(offset + j * data[j].size(), data[j].size(), data[j].data(), 0);
+
+      if (!VolumeWii::HashGroup(data.data(), hashes.data()))
+        return false;
+    }
+    else if (!VolumeWii::EncryptGroup(offset, 0, std::numeric_limits<u64>::max(), key, &reader,
+                                      encrypted.get()))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Reads random blocks of a file, issuing queue_depth reads at a time through OffsetReadBatch.
+int RunReadBenchmark(const std::string& input_file_path, const std::string& queue_depths_string,
+                     int block_size, int reads)
+{
+  File::DirectIOFile file(input_file_path, File::AccessMode::Read);
+  if (!file.IsOpen())
+  {
+    fmt::print(std::cerr, "Error: Unable to open input file\n");
+    return EXIT_FAILURE;
+  }
+
+  const u64 block_count = file.GetSize() / block_size;
+  if (block_count == 0)
+  {
+    fmt::print(std::cerr, "Error: The input file is smaller than one block\n");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<u32> queue_depths;
+  for (const std::string& depth_string : SplitString(queue_depths_string, ','))
+  {
+    u32 depth;
+    if (!TryParse(depth_string, &depth) || depth == 0)
+    {
+      fmt::print(std::cerr, "Error: Invalid queue depth \"{}\"\n", depth_string);
+      return EXIT_FAILURE;
+    }
+    queue_depths.push_back(depth);
+  }
+
+  fmt::print(std::cout, "Reading {} random blocks of {} bytes per queue depth\n", reads,
+             block_size);
+
+  std::mt19937_64 random_engine;
+  std::uniform_int_distribution<u64> block_distribution(0, block_count - 1);
+
+  for (const u32 queue_depth : queue_depths)
+  {
+    std::vector<u8> buffer(u64(queue_depth) * block_size);
+    std::vector<File::BatchRead> batch;
+
+    const TimePoint start_time = Clock::now();
+    for (int i = 0; i < reads; i += queue_depth)
+    {
+      batch.clear();
+      for (u32 j = 0; j < queue_depth && i + j < u32(reads); ++j)
+      {
+        batch.push_back({&file, block_distribution(random_engine) * block_size,
+                         buffer.data() + u64(j) * block_size, u64(block_size)});
+      }
+
+      if (!File::OffsetReadBatch(batch))
+      {
+        fmt::print(std::cerr, "Error: Read failed\n");
+        return EXIT_FAILURE;
+      }
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+
+    fmt::print(std::cout, "Queue depth {}: {:.1f} MiB/s, {:.0f} reads/s\n", queue_depth,
+               double(reads) * block_size / (1024 * 1024) / seconds, reads / seconds);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+// Verifies a synthetic Wii disc with all hashes enabled, the way the game properties dialog does.
+int RunVerifyBenchmark(u64 groups)
+{
+  std::unique_ptr<DiscIO::VolumeDisc> volume;
+  if (auto reader = SyntheticWiiDiscReader::Create(groups))
+    volume = DiscIO::CreateDisc(std::move(reader));
+  if (!volume)
+  {
+    fmt::print(std::cerr, "Error: Unable to create a disc with {} groups\n", groups);
+    return EXIT_FAILURE;
+  }
+
+  Common::ThreadPool& pool = Common::ThreadPool::GetShared();
+  pool.ResetStats();
+
+  const TimePoint start_time = Clock::now();
+  DiscIO::VolumeVerifier verifier(*volume, false, {.crc32 = true, .md5 = true, .sha1 = true});
+  verifier.Start();
+  while (verifier.GetBytesProcessed() != verifier.GetTotalBytes())
+    verifier.Process();
+  verifier.Finish();
+  const double seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+
+  const double mebibytes = static_cast<double>(verifier.GetTotalBytes()) / (1024 * 1024);
+  const Common::ThreadPool::Stats stats = pool.GetStats();
+
+  fmt::print(std::cout, "Operation: verify, {:.1f} MiB\n", mebibytes);
+  fmt::print(std::cout, "Pool threads: {}\n", pool.GetThreadCount());
+  fmt::print(std::cout, "Time: {:.3f} s ({:.1f} MiB/s)\n", seconds, mebibytes / seconds);
+  fmt::print(std::cout, "Tasks: {} ({} stolen)\n", stats.tasks_completed, stats.tasks_stolen);
+  fmt::print(std::cout, "Problems found: {}\n", verifier.GetResult().problems.size());
+
+  return EXIT_SUCCESS;
+}
+}  // namespace
+
+int BenchmarkCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: benchmark [options]...");
+
+  parser.add_option("-o", "--operation")
+      .type("string")
+      .action("store")
+      .help("Operation to measure. encrypt and hash use synthetic Wii partition data, read "
+            "reads from the input file, verify verifies a synthetic Wii disc. [%choices]")
+      .choices({"encrypt", "hash", "read", "verify"})
+      .set_default("encrypt");
+
+  parser.add_option("-g", "--groups")
+      .type("int")
+      .action("store")
+      .help("Number of 2 MiB groups to process per job, or to put in the disc for the verify "
+            "operation. [%default]")
+      .set_default(256);
+
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("Number of jobs to run at the same time, like converting several discs at once. "
+            "[%default]")
+      .set_default(1);
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to the FILE to read from, for the read operation. It should be "
+            "larger than the system memory, or the page cache should be dropped before running "
+            "this.")
+      .metavar("FILE");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path, for the verify operation. Will be automatically created if this "
+            "option is not set.")
+      .set_default("");
+
+  parser.add_option("-q", "--queue_depths")
+      .type("string")
+      .action("store")
+      .help("Comma-separated numbers of reads to issue at once, for the read operation. "
+            "[%default]")
+      .set_default("1,4,16,64");
+
+  parser.add_option("-b", "--block_size")
+      .type("int")
+      .action("store")
+      .help("Size of each read in bytes, for the read operation. [%default]")
+      .set_default(32768);
+
+  parser.add_option("-n", "--reads")
+      .type("int")
+      .action("store")
+      .help("Number of reads per queue depth, for the read operation. [%default]")
+      .set_default(4096);
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::string operation = options["operation"];
+  if (operation == "read")
+  {
+    if (!options.is_set("input"))
+    {
+      fmt::print(std::cerr, "Error: No input set\n");
+      return EXIT_FAILURE;
+    }
+
+    const int block_size = static_cast<int>(options.get("block_size"));
+    const int reads = static_cast<int>(options.get("reads"));
+    if (block_size <= 0 || reads <= 0)
+    {
+      fmt::print(std::cerr, "Error: The block size and number of reads must be positive\n");
+      return EXIT_FAILURE;
+    }
+
+    return RunReadBenchmark(options["input"], options["queue_depths"], block_size, reads);
+  }
+
+  if (operation == "verify")
+  {
+    const int groups = static_cast<int>(options.get("groups"));
+    if (groups <= 0)
+    {
+      fmt::print(std::cerr, "Error: The number of groups must be positive\n");
+      return EXIT_FAILURE;
+    }
+
+    // Checking the signatures of Wii discs needs IOS, which needs a user directory
+    UICommon::SetUserDirectory(options["user"]);
+    UICommon::Init();
+
+    return RunVerifyBenchmark(groups);
+  }
+
+  const int groups = static_cast<int>(options.get("groups"));
+  const int jobs = static_cast<int>(options.get("jobs"));
+  if (groups <= 0 || jobs <= 0)
+  {
+    fmt::print(std::cerr, "Error: The number of groups and jobs must be positive\n");
+    return EXIT_FAILURE;
+  }
+
+  Common::ThreadPool& pool = Common::ThreadPool::GetShared();
+  pool.ResetStats();
+
+  std::atomic<bool> success = true;
+  std::vector<std::thread> threads;
+  const TimePoint start_time = Clock::now();
+  for (int i = 0; i < jobs; ++i)
+  {
+    threads.emplace_back([&operation, groups, &success] {
+      if (!RunJob(operation, groups))
+        success = false;
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+  const DT elapsed = Clock::now() - start_time;
+
+  if (!success)
+  {
+    fmt::print(std::cerr, "Error: {} failed\n", operation);
+    return EXIT_FAILURE;
+  }
+
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  const double mebibytes =
+      static_cast<double>(DiscIO::VolumeWii::GROUP_TOTAL_SIZE) * groups * jobs / (1024 * 1024);
+  const Common::ThreadPool::Stats stats = pool.GetStats();
+  const auto to_us = [](DT duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+  };
+  const u64 tasks = std::max<u64>(stats.tasks_completed, 1);
+
+  fmt::print(std::cout, "Operation: {}, {} job(s) of {} group(s)\n", operation, jobs, groups);
+  fmt::print(std::cout, "Pool threads: {}\n", pool.GetThreadCount());
+  fmt::print(std::cout, "Time: {:.3f} s ({:.1f} MiB/s)\n", seconds, mebibytes / seconds);
+  fmt::print(std::cout, "Tasks: {} ({} stolen)\n", stats.tasks_completed, stats.tasks_stolen);
+  fmt::print(std::cout, "Queue latency: {:.1f} us mean, {:.1f} us max\n",
+             to_us(stats.total_queue_latency) / tasks, to_us(stats.max_queue_latency));
+  fmt::print(std::cout, "Task run time: {:.1f} us mean\n", to_us(stats.total_run_time) / tasks);
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
@@ -3,17 +3,26 @@
 
 #include "DolphinTool/ConvertCommand.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include <OptionParser.h>
 #include <fmt/ostream.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Common/ThreadPool.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/ScrubbedBlob.h"
@@ -54,6 +63,299 @@ static std::optional<DiscIO::BlobType> ParseFormatString(const std::string& form
   return std::nullopt;
 }
 
+struct ConversionSettings
+{
+  DiscIO::BlobType format;
+  bool scrub;
+  std::optional<int> block_size;
+  std::optional<DiscIO::WIARVZCompressionType> compression;
+  std::optional<int> compression_level;
+};
+
+static std::string GetFormatExtension(DiscIO::BlobType format)
+{
+  switch (format)
+  {
+  case DiscIO::BlobType::GCZ:
+    return ".gcz";
+  case DiscIO::BlobType::WIA:
+    return ".wia";
+  case DiscIO::BlobType::RVZ:
+    return ".rvz";
+  default:
+    return ".iso";
+  }
+}
+
+// Messages are prefixed with message_prefix, which in batch mode names the image they are about.
+static bool ConvertImage(const ConversionSettings& settings, const std::string& input_file_path,
+                         const std::string& output_file_path, const std::string& message_prefix,
+                         u64* data_size)
+{
+  const DiscIO::BlobType format = settings.format;
+  const bool scrub = settings.scrub;
+
+  // Open the blob reader
+  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
+  if (!blob_reader)
+  {
+    fmt::print(std::cerr, "{}Error: The input file could not be opened.\n", message_prefix);
+    return false;
+  }
+
+  // Open the volume
+  const std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
+  if (!volume)
+  {
+    if (scrub)
+    {
+      fmt::print(std::cerr, "{}Error: Scrubbing is only supported for GC/Wii disc images.\n",
+                 message_prefix);
+      return false;
+    }
+
+    fmt::print(std::cerr,
+               "{}Warning: The input file is not a GC/Wii disc image. Continuing anyway.\n",
+               message_prefix);
+  }
+
+  if (scrub)
+  {
+    if (volume->IsDatelDisc())
+    {
+      fmt::print(std::cerr, "{}Error: Scrubbing a Datel disc is not supported.\n",
+                 message_prefix);
+      return false;
+    }
+
+    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
+
+    if (!blob_reader)
+    {
+      fmt::print(std::cerr,
+                 "{}Error: Unable to process disc image. Try again without --scrub.\n",
+                 message_prefix);
+      return false;
+    }
+  }
+
+  if (scrub && format == DiscIO::BlobType::RVZ)
+  {
+    fmt::print(std::cerr,
+               "{}Warning: Scrubbing an RVZ container does not offer significant space "
+               "advantages. Continuing anyway.\n",
+               message_prefix);
+  }
+
+  if (scrub && format == DiscIO::BlobType::PLAIN)
+  {
+    fmt::print(std::cerr,
+               "{}Warning: Scrubbing does not save space when converting to ISO unless "
+               "using external compression. Continuing anyway.\n",
+               message_prefix);
+  }
+
+  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
+      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
+  {
+    fmt::print(std::cerr,
+               "{}Warning: Converting Wii disc images to GCZ without scrubbing may not "
+               "offer space advantages over ISO. Continuing anyway.\n",
+               message_prefix);
+  }
+
+  if (volume && volume->IsNKit())
+  {
+    fmt::print(std::cerr,
+               "{}Warning: Converting an NKit file, output will still be NKit! Continuing "
+               "anyway.\n",
+               message_prefix);
+  }
+
+  if (format == DiscIO::BlobType::GCZ && volume &&
+      !DiscIO::IsGCZBlockSizeLegacyCompatible(settings.block_size.value(), volume->GetDataSize()))
+  {
+    fmt::print(std::cerr,
+               "{}Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
+               "must be an integer multiple of the block size and must not be an integer "
+               "multiple of the block size multiplied by 32. Continuing anyway.\n",
+               message_prefix);
+  }
+
+  *data_size = blob_reader->GetDataSize();
+
+  // Perform the conversion
+  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
+
+  bool success = false;
+
+  switch (format)
+  {
+  case DiscIO::BlobType::PLAIN:
+  {
+    success = DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
+                                     NOOP_STATUS_CALLBACK);
+    break;
+  }
+
+  case DiscIO::BlobType::GCZ:
+  {
+    u32 sub_type = std::numeric_limits<u32>::max();
+    if (volume)
+    {
+      if (volume->GetVolumeType() == DiscIO::Platform::GameCubeDisc)
+        sub_type = 0;
+      else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
+        sub_type = 1;
+    }
+    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
+                                   settings.block_size.value(), NOOP_STATUS_CALLBACK);
+    break;
+  }
+
+  case DiscIO::BlobType::WIA:
+  case DiscIO::BlobType::RVZ:
+  {
+    success = DiscIO::ConvertToWIAOrRVZ(
+        blob_reader.get(), input_file_path, output_file_path, format == DiscIO::BlobType::RVZ,
+        settings.compression.value(), settings.compression_level.value(),
+        settings.block_size.value(), NOOP_STATUS_CALLBACK);
+    break;
+  }
+
+  default:
+  {
+    ASSERT(false);
+    break;
+  }
+  }
+
+  if (!success)
+    fmt::print(std::cerr, "{}Error: Conversion failed\n", message_prefix);
+
+  return success;
+}
+
+// Converts several images at once. Every job reads its own image while the compression work of
+// all jobs runs on the shared thread pool, so that the pool stays busy while a job waits for I/O
+// or for its last few blocks to be compressed.
+static int ConvertBatch(const ConversionSettings& settings, std::vector<std::string> input_paths,
+                        const std::string& output_directory, int jobs)
+{
+  if (!File::IsDirectory(output_directory))
+  {
+    fmt::print(std::cerr, "Error: The output directory does not exist\n");
+    return EXIT_FAILURE;
+  }
+
+  // Starting with the largest images keeps a large image from being the only one left at the end.
+  std::ranges::stable_sort(input_paths, std::ranges::greater{},
+                           [](const std::string& path) { return File::GetSize(path); });
+
+  // Inputs with the same name but in different directories or with different extensions would
+  // be converted into the same file, so such a batch is rejected before any job starts. The
+  // comparison ignores case, since not every file system tells such names apart.
+  std::vector<std::string> output_paths;
+  output_paths.reserve(input_paths.size());
+  std::unordered_map<std::string, const std::string*> inputs_by_output;
+  for (const std::string& input_file_path : input_paths)
+  {
+    std::string name;
+    SplitPath(input_file_path, nullptr, &name, nullptr);
+    output_paths.push_back(
+        fmt::format("{}/{}{}", output_directory, name, GetFormatExtension(settings.format)));
+
+    std::string key = output_paths.back();
+    Common::ToLower(&key);
+    const auto [it, inserted] = inputs_by_output.emplace(std::move(key), &input_file_path);
+    if (!inserted)
+    {
+      fmt::print(std::cerr, "Error: {} and {} would both be converted to {}\n", *it->second,
+                 input_file_path, output_paths.back());
+      return EXIT_FAILURE;
+    }
+  }
+
+  Common::ThreadPool& pool = Common::ThreadPool::GetShared();
+  pool.ResetStats();
+
+  std::atomic<size_t> next_input = 0;
+  std::atomic<size_t> images_done = 0;
+  std::atomic<size_t> images_failed = 0;
+  std::atomic<u64> total_data_size = 0;
+  std::atomic<u64> total_output_size = 0;
+  std::mutex print_lock;
+
+  const auto run_job = [&] {
+    while (true)
+    {
+      const size_t index = next_input++;
+      if (index >= input_paths.size())
+        return;
+
+      const std::string& input_file_path = input_paths[index];
+      const std::string& output_file_path = output_paths[index];
+      const std::string message_prefix = fmt::format("{}: ", input_file_path);
+
+      u64 data_size = 0;
+      bool success = false;
+      const TimePoint start_time = Clock::now();
+      if (File::Exists(output_file_path))
+      {
+        fmt::print(std::cerr, "{}Error: The output file {} already exists\n", message_prefix,
+                   output_file_path);
+      }
+      else
+      {
+        success = ConvertImage(settings, input_file_path, output_file_path, message_prefix,
+                               &data_size);
+      }
+      const double seconds = std::chrono::duration<double>(Clock::now() - start_time).count();
+
+      if (!success)
+      {
+        ++images_failed;
+        continue;
+      }
+
+      const u64 output_size = File::GetSize(output_file_path);
+      total_data_size += data_size;
+      total_output_size += output_size;
+
+      std::lock_guard lk(print_lock);
+      fmt::print(std::cout, "[{}/{}] {} -> {}: {:.1f} MiB in {:.1f} s ({:.1f} MiB/s), {:.1f}%\n",
+                 ++images_done, input_paths.size(), input_file_path, output_file_path,
+                 data_size / (1024.0 * 1024.0), seconds, data_size / (1024.0 * 1024.0) / seconds,
+                 data_size != 0 ? 100.0 * output_size / data_size : 0.0);
+    }
+  };
+
+  const TimePoint start_time = Clock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < std::min<int>(jobs, static_cast<int>(input_paths.size())); ++i)
+    threads.emplace_back(run_job);
+  for (std::thread& thread : threads)
+    thread.join();
+  const DT elapsed = Clock::now() - start_time;
+
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  const double total_mib = total_data_size / (1024.0 * 1024.0);
+  const Common::ThreadPool::Stats stats = pool.GetStats();
+  const double pool_busy_fraction =
+      std::chrono::duration<double>(stats.total_run_time).count() /
+      (seconds * pool.GetThreadCount());
+
+  fmt::print(std::cout, "Converted {} of {} images: {:.1f} MiB in {:.1f} s ({:.1f} MiB/s)\n",
+             images_done.load(), input_paths.size(), total_mib, seconds, total_mib / seconds);
+  fmt::print(std::cout, "Output size: {:.1f} MiB ({:.1f}%)\n",
+             total_output_size / (1024.0 * 1024.0),
+             total_data_size != 0 ? 100.0 * total_output_size / total_data_size : 0.0);
+  fmt::print(std::cout, "Pool threads: {}, busy {:.1f}% of the time\n", pool.GetThreadCount(),
+             100.0 * pool_busy_fraction);
+
+  return images_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int ConvertCommand(const std::vector<std::string>& args)
 {
   optparse::OptionParser parser;
@@ -79,6 +381,20 @@ int ConvertCommand(const std::vector<std::string>& args)
       .help("Path to the destination FILE.")
       .metavar("FILE");
 
+  parser.add_option("-d", "--output_directory")
+      .type("string")
+      .action("store")
+      .help("Batch mode: convert every FILE given after the options into DIRECTORY, keeping the "
+            "file names. Replaces --input and --output.")
+      .metavar("DIRECTORY");
+
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("Batch mode: number of images to convert at the same time. Compression work of all "
+            "of them shares one thread pool. [%default]")
+      .set_default(2);
+
   parser.add_option("-f", "--format")
       .type("string")
       .action("store")
@@ -117,97 +433,56 @@ int ConvertCommand(const std::vector<std::string>& args)
 
   // Validate options
 
-  // --input
-  if (!options.is_set("input"))
-  {
-    fmt::print(std::cerr, "Error: No input set\n");
-    return EXIT_FAILURE;
-  }
-  const std::string& input_file_path = options["input"];
-
-  // --output
-  if (!options.is_set("output"))
-  {
-    fmt::print(std::cerr, "Error: No output set\n");
-    return EXIT_FAILURE;
-  }
-  const std::string& output_file_path = options["output"];
-
-  // --format
-  const std::optional<DiscIO::BlobType> format_o = ParseFormatString(options["format"]);
-  if (!format_o.has_value())
-  {
-    fmt::print(std::cerr, "Error: No output format set\n");
-    return EXIT_FAILURE;
-  }
-  const DiscIO::BlobType format = format_o.value();
-
-  // Open the blob reader
-  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
-  if (!blob_reader)
-  {
-    fmt::print(std::cerr, "Error: The input file could not be opened.\n");
-    return EXIT_FAILURE;
-  }
-
-  // --scrub
-  const bool scrub = static_cast<bool>(options.get("scrub"));
-
-  // Open the volume
-  const std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
-  if (!volume)
+  const bool batch_mode = options.is_set("output_directory");
+  const std::vector<std::string> batch_inputs = parser.args();
+  if (batch_mode)
   {
-    if (scrub)
+    if (options.is_set("input") || options.is_set("output"))
     {
-      fmt::print(std::cerr, "Error: Scrubbing is only supported for GC/Wii disc images.\n");
+      fmt::print(std::cerr, "Error: --input and --output can't be used with --output_directory\n");
       return EXIT_FAILURE;
     }
 
-    fmt::print(std::cerr,
-               "Warning: The input file is not a GC/Wii disc image. Continuing anyway.\n");
-  }
-
-  if (scrub)
-  {
-    if (volume->IsDatelDisc())
+    if (batch_inputs.empty())
     {
-      fmt::print(std::cerr, "Error: Scrubbing a Datel disc is not supported.\n");
+      fmt::print(std::cerr, "Error: No input files given\n");
       return EXIT_FAILURE;
     }
 
-    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
-
-    if (!blob_reader)
+    if (static_cast<int>(options.get("jobs")) <= 0)
     {
-      fmt::print(std::cerr, "Error: Unable to process disc image. Try again without --scrub.\n");
+      fmt::print(std::cerr, "Error: The number of jobs must be positive\n");
       return EXIT_FAILURE;
     }
   }
-
-  if (scrub && format == DiscIO::BlobType::RVZ)
+  else
   {
-    fmt::print(std::cerr, "Warning: Scrubbing an RVZ container does not offer significant space "
-                          "advantages. Continuing anyway.\n");
-  }
+    // --input
+    if (!options.is_set("input"))
+    {
+      fmt::print(std::cerr, "Error: No input set\n");
+      return EXIT_FAILURE;
+    }
 
-  if (scrub && format == DiscIO::BlobType::PLAIN)
-  {
-    fmt::print(std::cerr, "Warning: Scrubbing does not save space when converting to ISO unless "
-                          "using external compression. Continuing anyway.\n");
+    // --output
+    if (!options.is_set("output"))
+    {
+      fmt::print(std::cerr, "Error: No output set\n");
+      return EXIT_FAILURE;
+    }
   }
 
-  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
-      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
+  // --format
+  const std::optional<DiscIO::BlobType> format_o = ParseFormatString(options["format"]);
+  if (!format_o.has_value())
   {
-    fmt::print(std::cerr, "Warning: Converting Wii disc images to GCZ without scrubbing may not "
-                          "offer space advantages over ISO. Continuing anyway.\n");
+    fmt::print(std::cerr, "Error: No output format set\n");
+    return EXIT_FAILURE;
   }
+  const DiscIO::BlobType format = format_o.value();
 
-  if (volume && volume->IsNKit())
-  {
-    fmt::print(std::cerr,
-               "Warning: Converting an NKit file, output will still be NKit! Continuing anyway.\n");
-  }
+  // --scrub
+  const bool scrub = static_cast<bool>(options.get("scrub"));
 
   // --block_size
   std::optional<int> block_size_o;
@@ -235,15 +510,6 @@ int ConvertCommand(const std::vector<std::string>& args)
       fmt::print(std::cerr,
                  "Warning: Block size is not ideal for performance. Continuing anyway.\n");
     }
-
-    if (format == DiscIO::BlobType::GCZ && volume &&
-        !DiscIO::IsGCZBlockSizeLegacyCompatible(block_size_o.value(), volume->GetDataSize()))
-    {
-      fmt::print(std::cerr,
-                 "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
-                 "must be an integer multiple of the block size and must not be an integer "
-                 "multiple of the block size multiplied by 32. Continuing anyway.\n");
-    }
   }
 
   // --compress, --compress_level
@@ -294,57 +560,18 @@ int ConvertCommand(const std::vector<std::string>& args)
     }
   }
 
-  // Perform the conversion
-  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
-
-  bool success = false;
-
-  switch (format)
-  {
-  case DiscIO::BlobType::PLAIN:
-  {
-    success = DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
-                                     NOOP_STATUS_CALLBACK);
-    break;
-  }
-
-  case DiscIO::BlobType::GCZ:
-  {
-    u32 sub_type = std::numeric_limits<u32>::max();
-    if (volume)
-    {
-      if (volume->GetVolumeType() == DiscIO::Platform::GameCubeDisc)
-        sub_type = 0;
-      else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
-        sub_type = 1;
-    }
-    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
-                                   block_size_o.value(), NOOP_STATUS_CALLBACK);
-    break;
-  }
-
-  case DiscIO::BlobType::WIA:
-  case DiscIO::BlobType::RVZ:
-  {
-    success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
-                                        format == DiscIO::BlobType::RVZ, compression_o.value(),
-                                        compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
-    break;
-  }
+  const ConversionSettings settings{format, scrub, block_size_o, compression_o,
+                                    compression_level_o};
 
-  default:
+  if (batch_mode)
   {
-    ASSERT(false);
-    break;
-  }
+    return ConvertBatch(settings, batch_inputs, options["output_directory"],
+                        static_cast<int>(options.get("jobs")));
   }
 
-  if (!success)
-  {
-    fmt::print(std::cerr, "Error: Conversion failed\n");
+  u64 data_size;
+  if (!ConvertImage(settings, options["input"], options["output"], "", &data_size))
     return EXIT_FAILURE;
-  }
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,233 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/IngestCommand.h"
+
+#include <bit>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/ChunkStore.h"
+#include "DiscIO/ChunkStoreBlob.h"
+#include "DiscIO/WIABlob.h"
+
+namespace DolphinTool
+{
+static double ToMiB(double bytes)
+{
+  return bytes / (1024.0 * 1024.0);
+}
+
+int IngestCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: ingest [options]... FILE...");
+
+  parser.add_option("-s", "--store")
+      .type("string")
+      .action("store")
+      .help("Path to the chunk store DIRECTORY. It is created if it doesn't exist yet.")
+      .metavar("DIRECTORY");
+
+  parser.add_option("-d", "--output_directory")
+      .type("string")
+      .action("store")
+      .help("DIRECTORY to write the .dcs images to, which refer to the chunk store. Every image "
+            "keeps the file name of its input.")
+      .metavar("DIRECTORY");
+
+  parser.add_option("-b", "--block_size")
+      .type("int")
+      .action("store")
+      .help("Chunk size in bytes. Smaller chunks find more data in common between images but "
+            "compress worse. [%default]")
+      .set_default(131072);
+
+  parser.add_option("-l", "--compression_level")
+      .type("int")
+      .action("store")
+      .help("Zstandard compression level of the chunks that get added. [%default]")
+      .set_default(5);
+
+  parser.add_option("-r", "--compare_rvz")
+      .action("store_true")
+      .help("Also convert every image to a temporary RVZ file with the same block size and "
+            "compression level, and report the savings compared to those. This takes about as "
+            "long as ingesting.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  const std::vector<std::string> input_paths = parser.args();
+  if (input_paths.empty())
+  {
+    fmt::print(std::cerr, "Error: No input files set\n");
+    return EXIT_FAILURE;
+  }
+
+  if (!options.is_set("store"))
+  {
+    fmt::print(std::cerr, "Error: No chunk store set\n");
+    return EXIT_FAILURE;
+  }
+
+  if (!options.is_set("output_directory"))
+  {
+    fmt::print(std::cerr, "Error: No output directory set\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::string output_directory = options["output_directory"];
+  if (!File::IsDirectory(output_directory))
+  {
+    fmt::print(std::cerr, "Error: The output directory does not exist\n");
+    return EXIT_FAILURE;
+  }
+
+  const int block_size = static_cast<int>(options.get("block_size"));
+  if (block_size < 0x8000 || block_size > 0x200000 ||
+      !std::has_single_bit(static_cast<u32>(block_size)))
+  {
+    fmt::print(std::cerr,
+               "Error: The chunk size must be a power of two between 32 KiB and 2 MiB\n");
+    return EXIT_FAILURE;
+  }
+
+  const int compression_level = static_cast<int>(options.get("compression_level"));
+  if (compression_level < 1 || compression_level > 22)
+  {
+    fmt::print(std::cerr, "Error: The compression level must be between 1 and 22\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::unique_ptr<DiscIO::ChunkStore> store = DiscIO::ChunkStore::Open(options["store"]);
+  if (!store)
+  {
+    fmt::print(std::cerr, "Error: The chunk store could not be opened\n");
+    return EXIT_FAILURE;
+  }
+
+  const bool compare_rvz = options.is_set("compare_rvz");
+
+  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
+
+  size_t images_done = 0;
+  size_t images_failed = 0;
+  u64 total_data_size = 0;
+  u64 total_referenced_bytes = 0;
+  u64 total_added_bytes = 0;
+  u64 total_rvz_bytes = 0;
+  bool rvz_sizes_known = compare_rvz;
+
+  for (const std::string& input_file_path : input_paths)
+  {
+    std::string name;
+    SplitPath(input_file_path, nullptr, &name, nullptr);
+    const std::string output_file_path = fmt::format("{}/{}.dcs", output_directory, name);
+
+    const std::unique_ptr<DiscIO::BlobReader> blob_reader =
+        DiscIO::CreateBlobReader(input_file_path);
+    if (!blob_reader)
+    {
+      fmt::print(std::cerr, "{}: Error: The input file could not be opened.\n", input_file_path);
+      ++images_failed;
+      continue;
+    }
+
+    if (blob_reader->GetDataSizeType() != DiscIO::DataSizeType::Accurate)
+    {
+      fmt::print(std::cerr,
+                 "{}: Error: The exact size of the disc isn't known for {} files. Convert it to "
+                 "ISO or RVZ first.\n",
+                 input_file_path, DiscIO::GetName(blob_reader->GetBlobType(), false));
+      ++images_failed;
+      continue;
+    }
+
+    if (File::Exists(output_file_path))
+    {
+      fmt::print(std::cerr, "{}: Error: The output file {} already exists\n", input_file_path,
+                 output_file_path);
+      ++images_failed;
+      continue;
+    }
+
+    DiscIO::ChunkStoreConversionStats stats;
+    if (!DiscIO::ConvertToChunkStore(blob_reader.get(), input_file_path, store.get(),
+                                     output_file_path, block_size, compression_level,
+                                     NOOP_STATUS_CALLBACK, &stats))
+    {
+      fmt::print(std::cerr, "{}: Error: Ingesting failed\n", input_file_path);
+      ++images_failed;
+      continue;
+    }
+
+    // Chunks hold the raw bytes of the image, so unlike RVZ, they don't get anything out of
+    // junk data or encrypted Wii partitions. The only fair baseline is an actual RVZ file.
+    u64 rvz_size = 0;
+    if (compare_rvz)
+    {
+      const std::string rvz_file_path = output_file_path + ".rvz.tmp";
+      const bool rvz_success = DiscIO::ConvertToWIAOrRVZ(
+          blob_reader.get(), input_file_path, rvz_file_path, true,
+          DiscIO::WIARVZCompressionType::Zstd, compression_level, block_size,
+          NOOP_STATUS_CALLBACK);
+      rvz_size = rvz_success ? File::GetSize(rvz_file_path) : 0;
+      File::Delete(rvz_file_path);
+      if (!rvz_success)
+      {
+        fmt::print(std::cerr, "{}: Warning: Converting to RVZ for the comparison failed\n",
+                   input_file_path);
+        rvz_sizes_known = false;
+      }
+    }
+
+    const u64 data_size = blob_reader->GetDataSize();
+    total_data_size += data_size;
+    total_referenced_bytes += stats.referenced_bytes;
+    total_added_bytes += stats.added_bytes;
+    total_rvz_bytes += rvz_size;
+
+    fmt::print(std::cout,
+               "[{}/{}] {} -> {}: {:.1f} MiB, {} of {} chunks already stored, added {:.1f} MiB",
+               ++images_done, input_paths.size(), input_file_path, output_file_path,
+               ToMiB(data_size), stats.chunk_count - stats.new_chunk_count, stats.chunk_count,
+               ToMiB(stats.added_bytes));
+    if (rvz_size != 0)
+      fmt::print(std::cout, ", RVZ {:.1f} MiB", ToMiB(rvz_size));
+    fmt::print(std::cout, "\n");
+  }
+
+  const auto print_savings = [&](const char* baseline_name, u64 baseline_bytes) {
+    const double saved_bytes =
+        static_cast<double>(baseline_bytes) - static_cast<double>(total_added_bytes);
+    fmt::print(std::cout, "Saved compared to {}: {:.1f} MiB ({:.1f}%)\n", baseline_name,
+               ToMiB(saved_bytes),
+               baseline_bytes != 0 ? 100.0 * saved_bytes / baseline_bytes : 0.0);
+  };
+
+  fmt::print(std::cout, "Ingested {} of {} images: {:.1f} MiB\n", images_done, input_paths.size(),
+             ToMiB(total_data_size));
+  fmt::print(std::cout, "Added to the store: {:.1f} MiB\n", ToMiB(total_added_bytes));
+
+  // Storing every image in chunks of its own only shows what sharing chunks saves. RVZ also
+  // compresses junk data and decrypted Wii data, so the store can come out larger than it.
+  print_savings("unshared chunks", total_referenced_bytes);
+  if (rvz_sizes_known)
+    print_savings("RVZ", total_rvz_bytes);
+  fmt::print(std::cout, "Store: {} chunks, {:.1f} MiB\n", store->GetChunkCount(),
+             ToMiB(store->GetDataFileSize()));
+
+  return images_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace DolphinTool
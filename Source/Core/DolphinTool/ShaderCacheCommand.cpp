@@ -0,0 +1,62 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/ShaderCacheCommand.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/ostream.h>
+
+#include "UICommon/UICommon.h"
+#include "VideoCommon/ShaderCache.h"
+
+namespace DolphinTool
+{
+int ShaderCacheCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: shadercache [options]...");
+
+  parser.add_option("-u", "--user")
+      .type("string")
+      .action("store")
+      .help("User folder path containing the shader cache. "
+            "Will be automatically created if this option is not set.")
+      .set_default("");
+
+  parser.add_option("-c", "--compact")
+      .action("store_true")
+      .help("Remove entries from the shared shader cache which are not used by any game.");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  UICommon::SetUserDirectory(options["user"]);
+  UICommon::Init();
+
+  if (!options.is_set_by_user("compact"))
+  {
+    fmt::print(std::cerr, "Error: No action set\n");
+    return EXIT_FAILURE;
+  }
+
+  const auto result = VideoCommon::ShaderCache::CompactSharedCaches();
+  if (result.skipped)
+  {
+    fmt::print(std::cerr, "Error: A pipeline UID cache is outdated or invalid. Run the game it "
+                          "belongs to once to update it, or delete it.\n");
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Files compacted: {}\n", result.files_processed);
+  fmt::print(std::cout, "Entries kept: {}\n", result.entries_kept);
+  fmt::print(std::cout, "Entries removed: {}\n", result.entries_removed);
+  fmt::print(std::cout, "Size: {} -> {} bytes\n", result.bytes_before, result.bytes_after);
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
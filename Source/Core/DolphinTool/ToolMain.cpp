@@ -9,9 +9,12 @@
 
 #include <fmt/ostream.h>
 
+#include "DolphinTool/BenchmarkCommand.h"
 #include "DolphinTool/ConvertCommand.h"
 #include "DolphinTool/ExtractCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/IngestCommand.h"
+#include "DolphinTool/ShaderCacheCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 #ifdef _WIN32
@@ -22,7 +25,8 @@ static void PrintUsage()
 {
   fmt::print(std::cerr, "usage: dolphin-tool COMMAND -h\n"
                         "\n"
-                        "commands supported: [convert, verify, header, extract]\n");
+                        "commands supported: [convert, verify, header, extract, shadercache, "
+                        "benchmark, ingest]\n");
 }
 
 #ifdef _WIN32
@@ -49,6 +53,12 @@ int main(int argc, char* argv[])
     return DolphinTool::HeaderCommand(args);
   else if (command_str == "extract")
     return DolphinTool::Extract(args);
+  else if (command_str == "shadercache")
+    return DolphinTool::ShaderCacheCommand(args);
+  else if (command_str == "benchmark")
+    return DolphinTool::BenchmarkCommand(args);
+  else if (command_str == "ingest")
+    return DolphinTool::IngestCommand(args);
   PrintUsage();
   return EXIT_FAILURE;
 }
@@ -4,9 +4,16 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -16,6 +23,8 @@
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/ThreadPool.h"
 
 #include "DiscIO/DirectoryBlob.h"
 
@@ -23,14 +32,110 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 27;  // Last changed in PR 13844
+static constexpr u32 CACHE_REVISION = 29;  // Last changed for the append-only cache file
+
+// After the revision, the cache file is a sequence of records, each of which starts with its size
+// as a u32. Later records replace earlier ones for the same path, which lets Save append only what
+// has changed. A record that was cut off by an interrupted write is ignored.
+enum class CacheRecordType : u8
+{
+  Game = 0,
+  Removed = 1,
+};
+
+template <typename F>
+static void AppendCacheRecord(std::vector<u8>* out, CacheRecordType type, F do_state)
+{
+  const auto do_record = [&](PointerWrap& p) {
+    p.Do(type);
+    do_state(p);
+  };
+
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  do_record(p_measure);
+  const u32 record_size = static_cast<u32>(reinterpret_cast<size_t>(ptr));
+
+  const size_t start = out->size();
+  out->resize(start + sizeof(record_size) + record_size);
+  std::memcpy(out->data() + start, &record_size, sizeof(record_size));
+
+  ptr = out->data() + start + sizeof(record_size);
+  PointerWrap p(&ptr, record_size, PointerWrap::Mode::Write);
+  do_record(p);
+}
+
+static std::vector<u8> GetCacheFileHeader()
+{
+  std::vector<u8> header(sizeof(CACHE_REVISION));
+  std::memcpy(header.data(), &CACHE_REVISION, sizeof(CACHE_REVISION));
+  return header;
+}
+
+// Creating a GameFile mostly consists of waiting for the storage the game is on, which may be a
+// network share, so it's worth having more of them in progress than there are CPU cores.
+static u32 GetScanThreadCount(size_t item_count)
+{
+  const u32 core_count = std::max(std::thread::hardware_concurrency(), 1u);
+  const u32 thread_count = std::clamp(core_count * 2, 4u, 16u);
+  return static_cast<u32>(std::min<size_t>(thread_count, item_count));
+}
+
+// Calls work for every index from 0 to count - 1 on a set of threads, and passes each result to
+// on_done on the calling thread as soon as it's ready. Once processing has been halted, work is
+// no longer called and the remaining indices get a default-constructed result.
+template <typename Work, typename OnDone>
+static void RunOnScanThreads(size_t count, const Work& work, const OnDone& on_done,
+                             const std::atomic_bool& processing_halted)
+{
+  using Result = std::invoke_result_t<Work, size_t>;
+
+  if (count == 0)
+    return;
+
+  std::mutex lock;
+  std::condition_variable finished_cv;
+  std::vector<std::pair<size_t, Result>> finished;
+
+  // This uses a pool of its own rather than the shared one, since the tasks block on I/O.
+  Common::ThreadPool pool("Game List Scan", GetScanThreadCount(count));
+  for (size_t i = 0; i < count; ++i)
+  {
+    pool.Submit([&, i] {
+      Result result{};
+      if (!processing_halted)
+        result = work(i);
+
+      {
+        std::lock_guard lk(lock);
+        finished.emplace_back(i, std::move(result));
+      }
+      finished_cv.notify_one();
+    });
+  }
+
+  std::vector<std::pair<size_t, Result>> batch;
+  for (size_t done = 0; done < count; done += batch.size())
+  {
+    batch.clear();
+    {
+      std::unique_lock lk(lock);
+      finished_cv.wait(lk, [&] { return !finished.empty(); });
+      std::swap(batch, finished);
+    }
+
+    for (auto& [index, result] : batch)
+      on_done(index, std::move(result));
+  }
+}
 
 std::vector<std::string> FindAllGamePaths(std::span<const std::string_view> directories_to_scan,
                                           bool recursive_scan)
 {
   constexpr auto search_extensions =
       std::to_array<std::string_view>({".gcm", ".tgc", ".bin", ".iso", ".ciso", ".gcz", ".wbfs",
-                                       ".wia", ".rvz", ".nfs", ".wad", ".dol", ".elf", ".json"});
+                                       ".wia", ".rvz", ".nfs", ".dcs", ".wad", ".dol", ".elf",
+                                       ".json"});
 
   // TODO: We could process paths iteratively as they are found
   return Common::DoFileSearch(directories_to_scan, search_extensions, recursive_scan);
@@ -54,7 +159,7 @@ size_t GameFileCache::GetSize() const
 void GameFileCache::Clear(DeleteOnDisk delete_on_disk)
 {
   if (delete_on_disk != DeleteOnDisk::No)
-    File::Delete(m_path);
+    DeleteCacheFile();
 
   m_cached_files.clear();
 }
@@ -83,6 +188,10 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
                            const GameRemovedFromCacheFn& game_removed_from_cache,
                            const std::atomic_bool& processing_halted)
 {
+  const TimePoint start_time = Clock::now();
+  const size_t cached_count = m_cached_files.size();
+  size_t removed_count = 0;
+
   // Copy game paths into a set, except ones that match DiscIO::ShouldHideFromGameList.
   // TODO: Prevent DoFileSearch from looking inside /files/ directories of DirectoryBlobs at all?
   // TODO: Make DoFileSearch support filter predicates so we don't have remove things afterwards?
@@ -117,6 +226,7 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
           game_removed_from_cache((*it)->GetFilePath());
 
         cache_changed = true;
+        ++removed_count;
         --end;
         *it = std::move(*end);
       }
@@ -126,21 +236,31 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
-  {
-    if (processing_halted)
-      break;
+  const std::vector<std::string> new_paths(game_paths.begin(), game_paths.end());
+  size_t added_count = 0;
+  RunOnScanThreads(
+      new_paths.size(),
+      [&new_paths](size_t index) -> std::shared_ptr<GameFile> {
+        auto file = std::make_shared<GameFile>(new_paths[index]);
+        return file->IsValid() ? file : nullptr;
+      },
+      [&](size_t, std::shared_ptr<GameFile> file) {
+        if (!file || processing_halted)
+          return;
+
+        if (game_added_to_cache)
+          game_added_to_cache(file);
 
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
-    {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+        cache_changed = true;
+        ++added_count;
+        m_cached_files.push_back(std::move(file));
+      },
+      processing_halted);
 
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
-    }
-  }
+  INFO_LOG_FMT(COMMON, "Game list scan: {} cached, {} new, {} removed, took {} ms",
+               cached_count - removed_count, added_count, removed_count,
+               std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_time)
+                   .count());
 
   return cache_changed;
 }
@@ -148,18 +268,30 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
 bool GameFileCache::UpdateAdditionalMetadata(const GameUpdatedFn& game_updated,
                                              const std::atomic_bool& processing_halted)
 {
+  const TimePoint start_time = Clock::now();
   bool cache_changed = false;
+  size_t updated_count = 0;
 
-  for (std::shared_ptr<GameFile>& file : m_cached_files)
-  {
-    if (processing_halted)
-      break;
+  // Every task only replaces its own element of m_cached_files, so they don't get in each
+  // other's way.
+  RunOnScanThreads(
+      m_cached_files.size(),
+      [this](size_t index) { return UpdateAdditionalMetadata(&m_cached_files[index]); },
+      [&](size_t index, bool updated) {
+        if (!updated)
+          return;
 
-    const bool updated = UpdateAdditionalMetadata(&file);
-    cache_changed |= updated;
-    if (game_updated && updated)
-      game_updated(file);
-  }
+        cache_changed = true;
+        ++updated_count;
+        if (game_updated && !processing_halted)
+          game_updated(m_cached_files[index]);
+      },
+      processing_halted);
+
+  INFO_LOG_FMT(COMMON, "Game list metadata update: {} of {} updated, took {} ms", updated_count,
+               m_cached_files.size(),
+               std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_time)
+                   .count());
 
   return cache_changed;
 }
@@ -203,79 +335,223 @@ bool GameFileCache::UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_fil
 
 bool GameFileCache::Load()
 {
-  return SyncCacheFile(false);
+  const TimePoint start_time = Clock::now();
+
+  std::vector<u8> buffer;
+  {
+    File::IOFile f(m_path, "rb");
+    if (!f)
+      return false;
+
+    buffer.resize(f.GetSize());
+    if (buffer.size() < sizeof(CACHE_REVISION) || !f.ReadBytes(buffer.data(), buffer.size()))
+    {
+      f.Close();
+      DeleteCacheFile();
+      return false;
+    }
+  }
+
+  u32 revision;
+  std::memcpy(&revision, buffer.data(), sizeof(revision));
+  if (revision != CACHE_REVISION)
+  {
+    DeleteCacheFile();
+    return false;
+  }
+
+  m_cached_files.clear();
+  std::unordered_map<std::string, size_t> indices;
+  size_t record_count = 0;
+
+  size_t offset = sizeof(CACHE_REVISION);
+  while (buffer.size() - offset >= sizeof(u32))
+  {
+    u32 record_size;
+    std::memcpy(&record_size, buffer.data() + offset, sizeof(record_size));
+    if (buffer.size() - offset - sizeof(record_size) < record_size)
+      break;
+
+    u8* const record_start = buffer.data() + offset + sizeof(record_size);
+    u8* ptr = record_start;
+    PointerWrap p(&ptr, record_size, PointerWrap::Mode::Read);
+
+    CacheRecordType type{};
+    p.Do(type);
+
+    std::shared_ptr<GameFile> file;
+    std::string removed_path;
+    if (type == CacheRecordType::Game)
+    {
+      file = std::make_shared<GameFile>();
+      file->DoState(p);
+    }
+    else if (type == CacheRecordType::Removed)
+    {
+      p.Do(removed_path);
+    }
+    else
+    {
+      break;
+    }
+
+    if (!p.IsReadMode() || ptr != record_start + record_size)
+      break;
+
+    offset += sizeof(record_size) + record_size;
+    ++record_count;
+
+    if (file)
+    {
+      const auto [it, inserted] = indices.emplace(file->GetFilePath(), m_cached_files.size());
+      if (inserted)
+        m_cached_files.push_back(std::move(file));
+      else
+        m_cached_files[it->second] = std::move(file);
+    }
+    else if (const auto it = indices.find(removed_path); it != indices.end())
+    {
+      const size_t index = it->second;
+      indices.erase(it);
+      if (index != m_cached_files.size() - 1)
+      {
+        m_cached_files[index] = std::move(m_cached_files.back());
+        indices[m_cached_files[index]->GetFilePath()] = index;
+      }
+      m_cached_files.pop_back();
+    }
+  }
+
+  MarkAllFilesAsOnDisk();
+  m_records_on_disk = record_count;
+  // Anything after the last complete record is left over from an interrupted write, and would
+  // be in the way of appending.
+  m_rewrite_cache_file = offset != buffer.size();
+
+  INFO_LOG_FMT(COMMON, "Loaded {} games from the game list cache ({} records), took {} ms",
+               m_cached_files.size(), record_count,
+               std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_time)
+                   .count());
+
+  return true;
 }
 
 bool GameFileCache::Save()
 {
-  return SyncCacheFile(true);
-}
+  std::vector<u8> records;
+  size_t record_count = 0;
 
-bool GameFileCache::SyncCacheFile(bool save)
-{
-  const char* open_mode = save ? "wb" : "rb";
-  File::IOFile f(m_path, open_mode);
-  if (!f)
-    return false;
-  bool success = false;
-  if (save)
+  std::unordered_set<std::string_view> current_paths;
+  current_paths.reserve(m_cached_files.size());
+  for (const std::shared_ptr<GameFile>& file : m_cached_files)
   {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-    DoState(&p_measure);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-    // Then actually do the write.
-    std::vector<u8> buffer(buffer_size);
-    ptr = buffer.data();
-    PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-    DoState(&p, buffer_size);
-    if (f.WriteBytes(buffer.data(), buffer.size()))
-      success = true;
+    current_paths.insert(file->GetFilePath());
+
+    const auto it = m_files_on_disk.find(file->GetFilePath());
+    if (it == m_files_on_disk.end() || it->second != file)
+    {
+      AppendCacheRecord(&records, CacheRecordType::Game, [&](PointerWrap& p) { file->DoState(p); });
+      ++record_count;
+    }
   }
-  else
+
+  for (const auto& [path, file] : m_files_on_disk)
   {
-    std::vector<u8> buffer(f.GetSize());
-    if (!buffer.empty() && f.ReadBytes(buffer.data(), buffer.size()))
+    if (!current_paths.contains(path))
     {
-      u8* ptr = buffer.data();
-      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-      DoState(&p, buffer.size());
-      if (p.IsReadMode())
-        success = true;
+      AppendCacheRecord(&records, CacheRecordType::Removed, [&](PointerWrap& p) {
+        std::string removed_path = path;
+        p.Do(removed_path);
+      });
+      ++record_count;
     }
   }
-  if (!success)
+
+  if (record_count == 0 && !m_rewrite_cache_file)
+    return true;
+
+  // Once most of the file consists of records that have been replaced, rewrite it from scratch.
+  const size_t live_count = m_cached_files.size();
+  if (m_rewrite_cache_file || !File::Exists(m_path) ||
+      m_records_on_disk + record_count > live_count * 2 + 64)
   {
-    // If some file operation failed, try to delete the probably-corrupted cache
-    f.Close();
-    File::Delete(m_path);
+    return WriteCacheFile();
   }
-  return success;
+
+  return AppendToCacheFile(records, record_count);
 }
 
-void GameFileCache::DoState(PointerWrap* p, u64 size)
+bool GameFileCache::WriteCacheFile()
 {
-  struct
-  {
-    u32 revision;
-    u64 expected_size;
-  } header = {CACHE_REVISION, size};
-  p->Do(header);
-  if (p->IsReadMode())
+  const TimePoint start_time = Clock::now();
+
+  std::vector<u8> buffer = GetCacheFileHeader();
+  for (const std::shared_ptr<GameFile>& file : m_cached_files)
+    AppendCacheRecord(&buffer, CacheRecordType::Game, [&](PointerWrap& p) { file->DoState(p); });
+
+  // Write to a temporary file first, so that a write that gets interrupted doesn't lose the
+  // existing cache.
+  const std::string temp_path = m_path + ".tmp";
   {
-    if (header.revision != CACHE_REVISION || header.expected_size != size)
+    File::IOFile f(temp_path, "wb");
+    if (!f || !f.WriteBytes(buffer.data(), buffer.size()))
     {
-      p->SetMeasureMode();
-      return;
+      f.Close();
+      File::Delete(temp_path);
+      return false;
     }
   }
-  p->DoEachElement(m_cached_files, [](PointerWrap& state, std::shared_ptr<GameFile>& elem) {
-    if (state.IsReadMode())
-      elem = std::make_shared<GameFile>();
-    elem->DoState(state);
-  });
+
+  if (!File::Rename(temp_path, m_path))
+  {
+    File::Delete(temp_path);
+    return false;
+  }
+
+  MarkAllFilesAsOnDisk();
+  m_records_on_disk = m_cached_files.size();
+  m_rewrite_cache_file = false;
+
+  INFO_LOG_FMT(COMMON, "Wrote {} games to the game list cache, took {} ms", m_cached_files.size(),
+               std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_time)
+                   .count());
+
+  return true;
+}
+
+bool GameFileCache::AppendToCacheFile(const std::vector<u8>& records, size_t record_count)
+{
+  File::IOFile f(m_path, "ab");
+  if (!f || !f.WriteBytes(records.data(), records.size()))
+  {
+    // If some file operation failed, try to delete the probably-corrupted cache
+    f.Close();
+    DeleteCacheFile();
+    return false;
+  }
+
+  MarkAllFilesAsOnDisk();
+  m_records_on_disk += record_count;
+
+  INFO_LOG_FMT(COMMON, "Appended {} records to the game list cache", record_count);
+
+  return true;
+}
+
+void GameFileCache::DeleteCacheFile()
+{
+  File::Delete(m_path);
+  m_files_on_disk.clear();
+  m_records_on_disk = 0;
+  m_rewrite_cache_file = true;
+}
+
+void GameFileCache::MarkAllFilesAsOnDisk()
+{
+  m_files_on_disk.clear();
+  m_files_on_disk.reserve(m_cached_files.size());
+  for (const std::shared_ptr<GameFile>& file : m_cached_files)
+    m_files_on_disk.emplace(file->GetFilePath(), file);
 }
 
 }  // namespace UICommon
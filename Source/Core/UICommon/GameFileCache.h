@@ -9,12 +9,11 @@
 #include <memory>
 #include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 
-class PointerWrap;
-
 namespace UICommon
 {
 class GameFile;
@@ -55,16 +54,26 @@ public:
                                 const std::atomic_bool& processing_halted = false);
 
   bool Load();
+  // Only appends the games which have been added, updated or removed since the last Load or Save
+  // to the cache file, unless enough of the file is outdated that rewriting it is worth it.
   bool Save();
 
 private:
   bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
 
-  bool SyncCacheFile(bool save);
-  void DoState(PointerWrap* p, u64 size = 0);
+  bool WriteCacheFile();
+  bool AppendToCacheFile(const std::vector<u8>& records, size_t record_count);
+  void DeleteCacheFile();
+  void MarkAllFilesAsOnDisk();
 
   std::string m_path;
   std::vector<std::shared_ptr<GameFile>> m_cached_files;
+
+  // The GameFile that the cache file currently has for each path. A GameFile gets replaced by a
+  // copy whenever it's updated, so comparing pointers tells whether it has to be written again.
+  std::unordered_map<std::string, std::shared_ptr<GameFile>> m_files_on_disk;
+  size_t m_records_on_disk = 0;
+  bool m_rewrite_cache_file = true;
 };
 
 }  // namespace UICommon
@@ -29,11 +29,12 @@
 
 namespace DX11
 {
-static ComPtr<ID3D11Buffer> AllocateConstantBuffer(u32 size)
+static ComPtr<ID3D11Buffer> AllocateConstantBuffer(u32 size, bool dynamic = true)
 {
   const u32 cbsize = Common::AlignUp(size, 16u);  // must be a multiple of 16
-  const CD3D11_BUFFER_DESC cbdesc(cbsize, D3D11_BIND_CONSTANT_BUFFER, D3D11_USAGE_DYNAMIC,
-                                  D3D11_CPU_ACCESS_WRITE);
+  const CD3D11_BUFFER_DESC cbdesc(cbsize, D3D11_BIND_CONSTANT_BUFFER,
+                                  dynamic ? D3D11_USAGE_DYNAMIC : D3D11_USAGE_DEFAULT,
+                                  dynamic ? D3D11_CPU_ACCESS_WRITE : 0);
   ComPtr<ID3D11Buffer> cbuf;
   const HRESULT hr = D3D::device->CreateBuffer(&cbdesc, nullptr, &cbuf);
   ASSERT_MSG(VIDEO, SUCCEEDED(hr), "Failed to create shader constant buffer (size={}): {}", cbsize,
@@ -88,11 +89,32 @@ bool VertexManager::Initialize()
       D3DCommon::SetDebugObjectName(buffer.Get(), "Buffer of VertexManager");
   }
 
-  m_vertex_constant_buffer = AllocateConstantBuffer(sizeof(VertexShaderConstants));
-  m_geometry_constant_buffer = AllocateConstantBuffer(sizeof(GeometryShaderConstants));
-  m_pixel_constant_buffer = AllocateConstantBuffer(sizeof(PixelShaderConstants));
-  if (!m_vertex_constant_buffer || !m_geometry_constant_buffer || !m_pixel_constant_buffer)
+  // With partial updates, only the part of a GX constant buffer that changed is uploaded. This
+  // requires buffers that can't be mapped, so utility uniforms get a dynamic buffer of their own.
+  D3D11_FEATURE_DATA_D3D11_OPTIONS options{};
+  if (D3D::device1 &&
+      SUCCEEDED(D3D::device1->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options,
+                                                  sizeof(options))) &&
+      options.ConstantBufferPartialUpdate)
+  {
+    D3D::context.As(&m_context1);
+  }
+
+  const bool dynamic_constant_buffers = !m_context1;
+  m_vertex_constant_buffer =
+      AllocateConstantBuffer(sizeof(VertexShaderConstants), dynamic_constant_buffers);
+  m_geometry_constant_buffer =
+      AllocateConstantBuffer(sizeof(GeometryShaderConstants), dynamic_constant_buffers);
+  m_pixel_constant_buffer =
+      AllocateConstantBuffer(sizeof(PixelShaderConstants), dynamic_constant_buffers);
+  m_utility_constant_buffer = dynamic_constant_buffers ?
+                                  m_vertex_constant_buffer :
+                                  AllocateConstantBuffer(sizeof(VertexShaderConstants));
+  if (!m_vertex_constant_buffer || !m_geometry_constant_buffer || !m_pixel_constant_buffer ||
+      !m_utility_constant_buffer)
+  {
     return false;
+  }
 
   CD3D11_BUFFER_DESC texel_buf_desc(TEXEL_STREAM_BUFFER_SIZE, D3D11_BIND_SHADER_RESOURCE,
                                     D3D11_USAGE_DYNAMIC, D3D11_CPU_ACCESS_WRITE);
@@ -123,10 +145,28 @@ void VertexManager::UploadUtilityUniforms(const void* uniforms, u32 uniforms_siz
 {
   // Just use the one buffer for all three.
   InvalidateConstants();
-  UpdateConstantBuffer(m_vertex_constant_buffer.Get(), uniforms, uniforms_size);
-  D3D::stateman->SetVertexConstants(m_vertex_constant_buffer.Get());
-  D3D::stateman->SetGeometryConstants(m_vertex_constant_buffer.Get());
-  D3D::stateman->SetPixelConstants(m_vertex_constant_buffer.Get());
+  UpdateConstantBuffer(m_utility_constant_buffer.Get(), uniforms, uniforms_size);
+  D3D::stateman->SetVertexConstants(m_utility_constant_buffer.Get());
+  D3D::stateman->SetGeometryConstants(m_utility_constant_buffer.Get());
+  D3D::stateman->SetPixelConstants(m_utility_constant_buffer.Get());
+}
+
+void VertexManager::UpdateGXConstantBuffer(ID3D11Buffer* buffer, const void* data, u32 data_size,
+                                           const UniformRange& changed_range)
+{
+  if (!m_context1)
+  {
+    UpdateConstantBuffer(buffer, data, data_size);
+    return;
+  }
+
+  // The rest of the buffer keeps its contents. Ranges are multiples of 16 bytes, as required.
+  const u32 begin = changed_range.offset;
+  const u32 end = changed_range.offset + changed_range.size;
+  const D3D11_BOX box = {begin, 0, 0, end, 1, 1};
+  m_context1->UpdateSubresource1(buffer, 0, &box, static_cast<const u8*>(data) + begin, 0, 0, 0);
+
+  ADDSTAT(g_stats.this_frame.bytes_uniform_streamed, changed_range.size);
 }
 
 bool VertexManager::MapTexelBuffer(u32 required_size, D3D11_MAPPED_SUBRESOURCE& sr)
@@ -263,28 +303,29 @@ void VertexManager::CommitBuffer(u32 num_vertices, u32 vertex_stride, u32 num_in
 void VertexManager::UploadUniforms()
 {
   auto& system = Core::System::GetInstance();
+  const ChangedUniforms changed = UpdateUniformTrackers();
 
   auto& vertex_shader_manager = system.GetVertexShaderManager();
   if (vertex_shader_manager.dirty)
   {
-    UpdateConstantBuffer(m_vertex_constant_buffer.Get(), &vertex_shader_manager.constants,
-                         sizeof(VertexShaderConstants));
+    UpdateGXConstantBuffer(m_vertex_constant_buffer.Get(), &vertex_shader_manager.constants,
+                           sizeof(VertexShaderConstants), changed.vertex);
     vertex_shader_manager.dirty = false;
   }
 
   auto& geometry_shader_manager = system.GetGeometryShaderManager();
   if (geometry_shader_manager.dirty)
   {
-    UpdateConstantBuffer(m_geometry_constant_buffer.Get(), &geometry_shader_manager.constants,
-                         sizeof(GeometryShaderConstants));
+    UpdateGXConstantBuffer(m_geometry_constant_buffer.Get(), &geometry_shader_manager.constants,
+                           sizeof(GeometryShaderConstants), changed.geometry);
     geometry_shader_manager.dirty = false;
   }
 
   auto& pixel_shader_manager = system.GetPixelShaderManager();
   if (pixel_shader_manager.dirty)
   {
-    UpdateConstantBuffer(m_pixel_constant_buffer.Get(), &pixel_shader_manager.constants,
-                         sizeof(PixelShaderConstants));
+    UpdateGXConstantBuffer(m_pixel_constant_buffer.Get(), &pixel_shader_manager.constants,
+                           sizeof(PixelShaderConstants), changed.pixel);
     pixel_shader_manager.dirty = false;
   }
 
@@ -59,6 +59,8 @@ private:
       (VERTEX_STREAM_BUFFER_SIZE + INDEX_STREAM_BUFFER_SIZE) / BUFFER_COUNT;
 
   bool MapTexelBuffer(u32 required_size, D3D11_MAPPED_SUBRESOURCE& sr);
+  void UpdateGXConstantBuffer(ID3D11Buffer* buffer, const void* data, u32 data_size,
+                              const UniformRange& changed_range);
 
   ComPtr<ID3D11Buffer> m_buffers[BUFFER_COUNT] = {};
   u32 m_current_buffer = 0;
@@ -67,6 +69,10 @@ private:
   ComPtr<ID3D11Buffer> m_vertex_constant_buffer = nullptr;
   ComPtr<ID3D11Buffer> m_geometry_constant_buffer = nullptr;
   ComPtr<ID3D11Buffer> m_pixel_constant_buffer = nullptr;
+  ComPtr<ID3D11Buffer> m_utility_constant_buffer = nullptr;
+
+  // Only set if the driver supports partial constant buffer updates.
+  ComPtr<ID3D11DeviceContext1> m_context1 = nullptr;
 
   ComPtr<ID3D11Buffer> m_custom_constant_buffer = nullptr;
   std::size_t m_last_custom_buffer_size = 0;
@@ -10,11 +10,14 @@
 #include "Common/GL/GLExtensions/GLExtensions.h"
 #include "Common/GL/GLUtil.h"
 
+#include "Core/System.h"
+
 #include "VideoBackends/OGL/OGLGfx.h"
 #include "VideoBackends/OGL/OGLStreamBuffer.h"
 #include "VideoBackends/OGL/ProgramShaderCache.h"
 
 #include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VideoConfig.h"
@@ -94,6 +97,9 @@ void VertexManager::UploadUtilityUniforms(const void* uniforms, u32 uniforms_siz
 {
   InvalidateConstants();
   ProgramShaderCache::UploadConstants(uniforms, uniforms_size);
+
+  // Utility uniforms are bound to every block, including the custom pixel shader constants.
+  Core::System::GetInstance().GetPixelShaderManager().custom_constants_dirty = true;
 }
 
 bool VertexManager::UploadTexelBuffer(const void* data, u32 data_size, TexelBufferFormat format,
@@ -187,6 +193,7 @@ void VertexManager::CommitBuffer(u32 num_vertices, u32 vertex_stride, u32 num_in
 
 void VertexManager::UploadUniforms()
 {
+  UpdateUniformTrackers();
   ProgramShaderCache::UploadConstants();
 }
 }  // namespace OGL
@@ -4,18 +4,30 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Thread.h"
+
+#include "Core/Config/GraphicsSettings.h"
 
 #include "VideoBackends/Software/NativeVertexFormat.h"
+#include "VideoBackends/Software/SWBoundingBox.h"
 #include "VideoBackends/Software/SWEfbInterface.h"
 #include "VideoBackends/Software/Tev.h"
 #include "VideoCommon/BPFunctions.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/PerfQueryBase.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/XFMemory.h"
@@ -95,21 +107,117 @@ struct Slope
   }
 };
 
+// Everything needed to rasterize one triangle against one scissor rectangle. This is computed on
+// the GPU thread, after which the pixels can be drawn by any of the rasterizer threads.
+struct TriangleSetup
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  // Half-edge constants and 28.4 fixed-point deltas
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+
+  // Bounding rectangle, clipped to the scissor rectangle
+  s32 minx, maxx, miny, maxy;
+};
+
+// Pixel pipeline state. There is one of these for every thread that draws pixels.
+struct RasterContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+};
+
+// When rasterizer threads are in use, the EFB is split into horizontal bands. Triangles are queued
+// for every band they touch, and each band is drawn by a single thread in submission order, so the
+// result is identical to drawing everything on the GPU thread.
+static constexpr s32 BAND_HEIGHT = 16;
+static constexpr u32 NUM_BANDS = (EFB_HEIGHT + BAND_HEIGHT - 1) / BAND_HEIGHT;
+static_assert(BAND_HEIGHT % BLOCK_SIZE == 0, "Blocks must not straddle bands");
+
+// Draw the queued triangles early once this many are pending, to bound memory usage.
+static constexpr size_t MAX_QUEUED_TRIANGLES = 4096;
+
 static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
 
-static Tev tev;
-static RasterBlock rasterBlock;
+// The first context is used by the GPU thread.
+static std::vector<std::unique_ptr<RasterContext>> s_contexts;
+static TriangleSetup s_triangle;
+
+static std::vector<TriangleSetup> s_queued_triangles;
+static std::array<std::vector<u32>, NUM_BANDS> s_band_triangles;
+static std::atomic<u32> s_next_band;
+
+static std::vector<std::thread> s_worker_threads;
+static std::mutex s_work_lock;
+static std::condition_variable s_work_wake;
+static std::condition_variable s_work_done;
+static u64 s_work_generation = 0;
+static u32 s_busy_workers = 0;
+static bool s_exit_workers = false;
 
 static std::vector<BPFunctions::ScissorRect> scissors;
 
+static void WorkerThreadRun(RasterContext* context, u64 generation);
+
+static u32 GetNumWorkerThreads()
+{
+  const int threads = Config::Get(Config::GFX_SW_RASTERIZER_THREADS);
+  if (threads >= 0)
+    return static_cast<u32>(threads);
+
+  // Automatic: leave a core for the CPU thread, the GPU thread also draws.
+  return static_cast<u32>(std::max(cpu_info.num_cores - 2, 0));
+}
+
+static void StartWorkerThreads(u32 num_worker_threads)
+{
+  s_contexts.clear();
+  for (u32 i = 0; i <= num_worker_threads; i++)
+    s_contexts.push_back(std::make_unique<RasterContext>());
+
+  // The workers are given the current generation rather than reading it once they've started,
+  // since by then the GPU thread may already have handed out work that they would miss.
+  std::lock_guard guard(s_work_lock);
+  s_exit_workers = false;
+  for (u32 i = 0; i < num_worker_threads; i++)
+    s_worker_threads.emplace_back(WorkerThreadRun, s_contexts[i + 1].get(), s_work_generation);
+}
+
+static void StopWorkerThreads()
+{
+  {
+    std::lock_guard guard(s_work_lock);
+    s_exit_workers = true;
+  }
+  s_work_wake.notify_all();
+
+  for (std::thread& thread : s_worker_threads)
+    thread.join();
+  s_worker_threads.clear();
+}
+
 void Init()
 {
   // The other slopes are set each for each primitive drawn, but zfreeze means that the z slope
   // needs to be set to an (untested) default value.
   ZSlope = Slope();
+
+  StopWorkerThreads();
+  StartWorkerThreads(GetNumWorkerThreads());
+}
+
+void Shutdown()
+{
+  StopWorkerThreads();
+  s_contexts.clear();
+  s_queued_triangles.clear();
+  for (std::vector<u32>& band : s_band_triangles)
+    band.clear();
 }
 
 void ScissorChanged()
@@ -141,31 +249,35 @@ static inline int iround(float x)
   return t;
 }
 
-void SetTevKonstColors()
+void SetTevState()
 {
-  tev.SetKonstColors();
+  const Tev::Program* program = Tev::GetProgram();
+  for (const auto& context : s_contexts)
+    context->tev.SetBatchState(program);
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(const TriangleSetup& tri, RasterContext& context, s32 x, s32 y, s32 xi, s32 yi)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  Tev& tev = context.tev;
+  tev.counters.rasterized_pixels++;
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
+  s32 z = (s32)std::clamp<float>(tri.ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
 
   if (bpmem.GetEmulatedZ() == EmulatedZ::Early)
   {
     // TODO: Test if perf regs are incremented even if test is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
+    tev.counters.perf_pixels[PQ_ZCOMP_INPUT_ZCOMPLOC]++;
     if (bpmem.zmode.test_enable)
     {
       // early z
       if (!EfbInterface::ZCompare(x, y, z))
         return;
     }
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
+    tev.counters.perf_pixels[PQ_ZCOMP_OUTPUT_ZCOMPLOC]++;
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  const RasterBlock& rasterBlock = context.rasterBlock;
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -176,7 +288,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      const float color = ColorSlopes[i][comp].GetValue(x, y);
+      const float color = tri.ColorSlopes[i][comp].GetValue(x, y);
       tev.Color[i][comp] = (u8)std::clamp<float>(color, 0.0f, 255.0f);
     }
   }
@@ -204,7 +316,8 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   tev.Draw();
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -215,9 +328,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
 
   float sDelta, tDelta;
 
-  float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
-  float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
-  float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
+  const float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
+  const float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
+  const float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
   float dudx = fabsf(uv00[0] - uv10[0]);
   float dvdx = fabsf(uv00[1] - uv10[1]);
@@ -255,7 +368,8 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(const TriangleSetup& tri, RasterBlock& rasterBlock, s32 blockX,
+                       s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -266,19 +380,19 @@ static void BuildBlock(s32 blockX, s32 blockY)
       s32 x = xi + blockX;
       s32 y = yi + blockY;
 
-      float invW = 1.0f / WSlope.GetValue(x, y);
+      float invW = 1.0f / tri.WSlope.GetValue(x, y);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(x, y) * invW;
+        float q = tri.TexSlopes[i][2].GetValue(x, y) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(x, y) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(x, y) * projection;
+        pixel.Uv[i][0] = tri.TexSlopes[i][0].GetValue(x, y) * projection;
+        pixel.Uv[i][1] = tri.TexSlopes[i][1].GetValue(x, y) * projection;
       }
     }
   }
@@ -288,7 +402,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texmap = bpmem.tevindref.getTexMap(i);
     u32 texcoord = bpmem.tevindref.getTexCoord(i);
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -300,51 +415,31 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
 
-void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
-                  const OutputVertexData* v2, s32 x_off, s32 y_off)
+// Draws the rows [miny, maxy) of a triangle. miny must be the triangle's own miny or a multiple of
+// BLOCK_SIZE, so that the blocks visited are the same no matter how the triangle is split.
+static void RasterizeTriangle(const TriangleSetup& tri, RasterContext& context, s32 miny,
+                              s32 maxy)
 {
-  if (!bpmem.genMode.zfreeze)
-  {
-    const s32 X1 = iround(16.0f * (v0->screenPosition.x - x_off)) - 9;
-    const s32 Y1 = iround(16.0f * (v0->screenPosition.y - y_off)) - 9;
-    const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, x_off, y_off);
-    ZSlope = Slope(v0->screenPosition.z, v1->screenPosition.z, v2->screenPosition.z, ctx);
-  }
-}
+  const s32 minx = tri.minx;
+  const s32 maxx = tri.maxx;
 
-static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
-                                  const OutputVertexData* v2,
-                                  const BPFunctions::ScissorRect& scissor)
-{
-  // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
-  // zfreeze depends on it
-  UpdateZSlope(v0, v1, v2, scissor.x_off, scissor.y_off);
-
-  // adapted from http://devmaster.net/posts/6145/advanced-rasterization
-
-  // 28.4 fixed-point coordinates. rounded to nearest and adjusted to match hardware output
-  // could also take floor and adjust -8
-  const s32 Y1 = iround(16.0f * (v0->screenPosition.y - scissor.y_off)) - 9;
-  const s32 Y2 = iround(16.0f * (v1->screenPosition.y - scissor.y_off)) - 9;
-  const s32 Y3 = iround(16.0f * (v2->screenPosition.y - scissor.y_off)) - 9;
+  const s32 C1 = tri.C1;
+  const s32 C2 = tri.C2;
+  const s32 C3 = tri.C3;
 
-  const s32 X1 = iround(16.0f * (v0->screenPosition.x - scissor.x_off)) - 9;
-  const s32 X2 = iround(16.0f * (v1->screenPosition.x - scissor.x_off)) - 9;
-  const s32 X3 = iround(16.0f * (v2->screenPosition.x - scissor.x_off)) - 9;
-
-  // Deltas
-  const s32 DX12 = X1 - X2;
-  const s32 DX23 = X2 - X3;
-  const s32 DX31 = X3 - X1;
+  const s32 DX12 = tri.DX12;
+  const s32 DX23 = tri.DX23;
+  const s32 DX31 = tri.DX31;
 
-  const s32 DY12 = Y1 - Y2;
-  const s32 DY23 = Y2 - Y3;
-  const s32 DY31 = Y3 - Y1;
+  const s32 DY12 = tri.DY12;
+  const s32 DY23 = tri.DY23;
+  const s32 DY31 = tri.DY31;
 
   // Fixed-point deltas
   const s32 FDX12 = DX12 * 16;
@@ -355,63 +450,6 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   const s32 FDY23 = DY23 * 16;
   const s32 FDY31 = DY31 * 16;
 
-  // Bounding rectangle
-  s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
-  s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
-  s32 miny = (std::min(std::min(Y1, Y2), Y3) + 0xF) >> 4;
-  s32 maxy = (std::max(std::max(Y1, Y2), Y3) + 0xF) >> 4;
-
-  // scissor
-  ASSERT(scissor.rect.left >= 0);
-  ASSERT(scissor.rect.right <= static_cast<int>(EFB_WIDTH));
-  ASSERT(scissor.rect.top >= 0);
-  ASSERT(scissor.rect.bottom <= static_cast<int>(EFB_HEIGHT));
-
-  minx = std::max(minx, scissor.rect.left);
-  maxx = std::min(maxx, scissor.rect.right);
-  miny = std::max(miny, scissor.rect.top);
-  maxy = std::min(maxy, scissor.rect.bottom);
-
-  if (minx >= maxx || miny >= maxy)
-    return;
-
-  // Set up the remaining slopes
-  const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
-                         scissor.y_off);
-
-  float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
-                1.0f / v2->projectedPosition.w};
-  WSlope = Slope(w[0], w[1], w[2], ctx);
-
-  for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
-  {
-    for (int comp = 0; comp < 4; comp++)
-      ColorSlopes[i][comp] = Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
-  }
-
-  for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
-  {
-    TexSlopes[i][0] =
-        Slope(v0->texCoords[i].x * w[0], v1->texCoords[i].x * w[1], v2->texCoords[i].x * w[2], ctx);
-    TexSlopes[i][1] =
-        Slope(v0->texCoords[i].y * w[0], v1->texCoords[i].y * w[1], v2->texCoords[i].y * w[2], ctx);
-    TexSlopes[i][2] =
-        Slope(v0->texCoords[i].z * w[0], v1->texCoords[i].z * w[1], v2->texCoords[i].z * w[2], ctx);
-  }
-
-  // Half-edge constants
-  s32 C1 = DY12 * X1 - DX12 * Y1;
-  s32 C2 = DY23 * X2 - DX23 * Y2;
-  s32 C3 = DY31 * X3 - DX31 * Y3;
-
-  // Correct for fill convention
-  if (DY12 < 0 || (DY12 == 0 && DX12 > 0))
-    C1++;
-  if (DY23 < 0 || (DY23 == 0 && DX23 > 0))
-    C2++;
-  if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
-    C3++;
-
   // Start in corner of 2x2 block
   s32 block_minx = minx & ~(BLOCK_SIZE - 1);
   s32 block_miny = miny & ~(BLOCK_SIZE - 1);
@@ -453,7 +491,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(tri, context.rasterBlock, x, y);
 
       // Accept whole block when totally covered
       // We still need to check min/max x/y because of the scissor
@@ -463,7 +501,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
         {
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            Draw(tri, context, x + ix, y + iy, ix, iy);
           }
         }
       }
@@ -486,7 +524,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
               // This check enforces the scissor rectangle, since it might not be aligned with the
               // blocks
               if (x + ix >= minx && x + ix < maxx && y + iy >= miny && y + iy < maxy)
-                Draw(x + ix, y + iy, ix, iy);
+                Draw(tri, context, x + ix, y + iy, ix, iy);
             }
 
             CX1 -= FDY12;
@@ -503,9 +541,228 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   }
 }
 
+static void DrawBands(RasterContext& context)
+{
+  for (u32 band = s_next_band++; band < NUM_BANDS; band = s_next_band++)
+  {
+    const s32 band_top = static_cast<s32>(band) * BAND_HEIGHT;
+    const s32 band_bottom = std::min(band_top + BAND_HEIGHT, static_cast<s32>(EFB_HEIGHT));
+
+    for (const u32 index : s_band_triangles[band])
+    {
+      const TriangleSetup& tri = s_queued_triangles[index];
+      RasterizeTriangle(tri, context, std::max(tri.miny, band_top),
+                        std::min(tri.maxy, band_bottom));
+    }
+  }
+}
+
+static void WorkerThreadRun(RasterContext* context, u64 generation)
+{
+  Common::SetCurrentThreadName("SW Rasterizer Worker");
+
+  std::unique_lock lock(s_work_lock);
+  while (true)
+  {
+    s_work_wake.wait(lock, [&] { return s_exit_workers || s_work_generation != generation; });
+    if (s_exit_workers)
+      return;
+
+    generation = s_work_generation;
+    lock.unlock();
+    DrawBands(*context);
+    lock.lock();
+
+    if (--s_busy_workers == 0)
+      s_work_done.notify_one();
+  }
+}
+
+static void DrawQueuedTriangles()
+{
+  if (s_queued_triangles.empty())
+    return;
+
+  s_next_band.store(0);
+  {
+    std::lock_guard guard(s_work_lock);
+    s_busy_workers = static_cast<u32>(s_worker_threads.size());
+    s_work_generation++;
+  }
+  s_work_wake.notify_all();
+
+  DrawBands(*s_contexts[0]);
+
+  {
+    std::unique_lock lock(s_work_lock);
+    s_work_done.wait(lock, [] { return s_busy_workers == 0; });
+  }
+
+  s_queued_triangles.clear();
+  for (std::vector<u32>& band : s_band_triangles)
+    band.clear();
+}
+
+static void MergeCounters(Tev::Counters& counters)
+{
+  ADDSTAT(g_stats.this_frame.rasterized_pixels, counters.rasterized_pixels);
+  ADDSTAT(g_stats.this_frame.tev_pixels_in, counters.tev_pixels_in);
+  ADDSTAT(g_stats.this_frame.tev_pixels_out, counters.tev_pixels_out);
+
+  for (u32 i = 0; i < PQ_NUM_MEMBERS; i++)
+  {
+    if (counters.perf_pixels[i] != 0)
+      EfbInterface::IncPerfCounterQuadCount(static_cast<PerfQueryType>(i), counters.perf_pixels[i]);
+  }
+
+  if (counters.tev_pixels_out != 0)
+  {
+    BBoxManager::Update(counters.bbox_left, counters.bbox_right, counters.bbox_top,
+                        counters.bbox_bottom);
+  }
+
+  counters = {};
+}
+
+void Flush()
+{
+  StageTimers::ScopedStageTimer timer(StageTimers::Stage::Rasterization);
+
+  DrawQueuedTriangles();
+
+  for (const auto& context : s_contexts)
+    MergeCounters(context->tev.counters);
+}
+
+void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
+                  const OutputVertexData* v2, s32 x_off, s32 y_off)
+{
+  if (!bpmem.genMode.zfreeze)
+  {
+    const s32 X1 = iround(16.0f * (v0->screenPosition.x - x_off)) - 9;
+    const s32 Y1 = iround(16.0f * (v0->screenPosition.y - y_off)) - 9;
+    const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, x_off, y_off);
+    ZSlope = Slope(v0->screenPosition.z, v1->screenPosition.z, v2->screenPosition.z, ctx);
+  }
+}
+
+static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
+                                  const OutputVertexData* v2,
+                                  const BPFunctions::ScissorRect& scissor)
+{
+  // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
+  // zfreeze depends on it
+  UpdateZSlope(v0, v1, v2, scissor.x_off, scissor.y_off);
+
+  // adapted from http://devmaster.net/posts/6145/advanced-rasterization
+
+  // 28.4 fixed-point coordinates. rounded to nearest and adjusted to match hardware output
+  // could also take floor and adjust -8
+  const s32 Y1 = iround(16.0f * (v0->screenPosition.y - scissor.y_off)) - 9;
+  const s32 Y2 = iround(16.0f * (v1->screenPosition.y - scissor.y_off)) - 9;
+  const s32 Y3 = iround(16.0f * (v2->screenPosition.y - scissor.y_off)) - 9;
+
+  const s32 X1 = iround(16.0f * (v0->screenPosition.x - scissor.x_off)) - 9;
+  const s32 X2 = iround(16.0f * (v1->screenPosition.x - scissor.x_off)) - 9;
+  const s32 X3 = iround(16.0f * (v2->screenPosition.x - scissor.x_off)) - 9;
+
+  // Bounding rectangle
+  s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
+  s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
+  s32 miny = (std::min(std::min(Y1, Y2), Y3) + 0xF) >> 4;
+  s32 maxy = (std::max(std::max(Y1, Y2), Y3) + 0xF) >> 4;
+
+  // scissor
+  ASSERT(scissor.rect.left >= 0);
+  ASSERT(scissor.rect.right <= static_cast<int>(EFB_WIDTH));
+  ASSERT(scissor.rect.top >= 0);
+  ASSERT(scissor.rect.bottom <= static_cast<int>(EFB_HEIGHT));
+
+  minx = std::max(minx, scissor.rect.left);
+  maxx = std::min(maxx, scissor.rect.right);
+  miny = std::max(miny, scissor.rect.top);
+  maxy = std::min(maxy, scissor.rect.bottom);
+
+  if (minx >= maxx || miny >= maxy)
+    return;
+
+  const bool threaded = !s_worker_threads.empty();
+  TriangleSetup& tri = threaded ? s_queued_triangles.emplace_back() : s_triangle;
+
+  tri.minx = minx;
+  tri.maxx = maxx;
+  tri.miny = miny;
+  tri.maxy = maxy;
+  tri.ZSlope = ZSlope;
+
+  // Set up the remaining slopes
+  const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
+                         scissor.y_off);
+
+  float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
+                1.0f / v2->projectedPosition.w};
+  tri.WSlope = Slope(w[0], w[1], w[2], ctx);
+
+  for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
+  {
+    for (int comp = 0; comp < 4; comp++)
+    {
+      tri.ColorSlopes[i][comp] =
+          Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    }
+  }
+
+  for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
+  {
+    tri.TexSlopes[i][0] =
+        Slope(v0->texCoords[i].x * w[0], v1->texCoords[i].x * w[1], v2->texCoords[i].x * w[2], ctx);
+    tri.TexSlopes[i][1] =
+        Slope(v0->texCoords[i].y * w[0], v1->texCoords[i].y * w[1], v2->texCoords[i].y * w[2], ctx);
+    tri.TexSlopes[i][2] =
+        Slope(v0->texCoords[i].z * w[0], v1->texCoords[i].z * w[1], v2->texCoords[i].z * w[2], ctx);
+  }
+
+  // Deltas
+  tri.DX12 = X1 - X2;
+  tri.DX23 = X2 - X3;
+  tri.DX31 = X3 - X1;
+
+  tri.DY12 = Y1 - Y2;
+  tri.DY23 = Y2 - Y3;
+  tri.DY31 = Y3 - Y1;
+
+  // Half-edge constants
+  tri.C1 = tri.DY12 * X1 - tri.DX12 * Y1;
+  tri.C2 = tri.DY23 * X2 - tri.DX23 * Y2;
+  tri.C3 = tri.DY31 * X3 - tri.DX31 * Y3;
+
+  // Correct for fill convention
+  if (tri.DY12 < 0 || (tri.DY12 == 0 && tri.DX12 > 0))
+    tri.C1++;
+  if (tri.DY23 < 0 || (tri.DY23 == 0 && tri.DX23 > 0))
+    tri.C2++;
+  if (tri.DY31 < 0 || (tri.DY31 == 0 && tri.DX31 > 0))
+    tri.C3++;
+
+  if (!threaded)
+  {
+    RasterizeTriangle(tri, *s_contexts[0], miny, maxy);
+    return;
+  }
+
+  const u32 index = static_cast<u32>(s_queued_triangles.size() - 1);
+  for (s32 band = miny / BAND_HEIGHT; band <= (maxy - 1) / BAND_HEIGHT; band++)
+    s_band_triangles[band].push_back(index);
+
+  if (s_queued_triangles.size() >= MAX_QUEUED_TRIANGLES)
+    DrawQueuedTriangles();
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
+  StageTimers::ScopedStageTimer timer(StageTimers::Stage::Rasterization);
+
   INCSTAT(g_stats.this_frame.num_triangles_drawn);
 
   for (const auto& scissor : scissors)
@@ -4,20 +4,22 @@
 #include "VideoBackends/Software/Tev.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstring>
+#include <map>
+#include <memory>
+#include <utility>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 
 #include "Core/System.h"
 
-#include "VideoBackends/Software/SWBoundingBox.h"
 #include "VideoBackends/Software/SWEfbInterface.h"
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include "VideoCommon/PixelShaderManager.h"
-#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/XFMemory.h"
 
@@ -384,24 +386,11 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
   }
 }
 
-void Tev::Draw()
+bool Tev::DrawStages(u8 output[4])
 {
-  ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
-  ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
-
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
-
-  auto& system = Core::System::GetInstance();
-  auto& pixel_shader_manager = system.GetPixelShaderManager();
-
   // initial color values
   for (int i = 0; i < 4; i++)
-  {
-    Reg[static_cast<TevOutput>(i)].r = pixel_shader_manager.constants.colors[i][0];
-    Reg[static_cast<TevOutput>(i)].g = pixel_shader_manager.constants.colors[i][1];
-    Reg[static_cast<TevOutput>(i)].b = pixel_shader_manager.constants.colors[i][2];
-    Reg[static_cast<TevOutput>(i)].a = pixel_shader_manager.constants.colors[i][3];
-  }
+    Reg[static_cast<TevOutput>(i)] = InitialRegs[i];
 
   for (unsigned int stageNum = 0; stageNum < bpmem.genMode.numindstages; stageNum++)
   {
@@ -424,7 +413,7 @@ void Tev::Draw()
 
     TextureSampler::Sample(Uv[texcoordSel].s >> scaleS, Uv[texcoordSel].t >> scaleT,
                            IndirectLod[stageNum], IndirectLinear[stageNum], texmap,
-                           IndirectTex[stageNum]);
+                           IndirectTex[stageNum], m_texel_cache);
   }
 
   for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
@@ -456,7 +445,7 @@ void Tev::Draw()
       if (bpmem.genMode.numtexgens > 0)
       {
         TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stageNum],
-                               TextureLinear[stageNum], texmap, texel);
+                               TextureLinear[stageNum], texmap, texel, m_texel_cache);
       }
       else
       {
@@ -541,10 +530,477 @@ void Tev::Draw()
   // regardless of the used destination register - TODO: Verify!
   const auto& color_index = bpmem.combiners[bpmem.genMode.numtevstages].colorC.dest;
   const auto& alpha_index = bpmem.combiners[bpmem.genMode.numtevstages].alphaC.dest;
-  u8 output[4] = {(u8)Reg[alpha_index].a, (u8)Reg[color_index].b, (u8)Reg[color_index].g,
-                  (u8)Reg[color_index].r};
+  output[ALP_C] = (u8)Reg[alpha_index].a;
+  output[BLU_C] = (u8)Reg[color_index].b;
+  output[GRN_C] = (u8)Reg[color_index].g;
+  output[RED_C] = (u8)Reg[color_index].r;
+
+  return TevAlphaTest(output[ALP_C]);
+}
+
+struct Tev::StageProgram
+{
+  u8 tex_coord;
+  u8 tex_map;
+  bool tex_enable;
+  // tevind for this stage is zero, which passes the tex coord through unmodified
+  bool direct;
+  std::array<u8, 4> tex_swap;
+
+  RasColorChan ras_chan;
+  std::array<u8, 4> ras_swap;
+
+  KonstSel konst_color;
+  KonstSel konst_alpha;
+
+  std::array<TevColorArg, 4> color_inputs;
+  std::array<TevAlphaArg, 4> alpha_inputs;
+  TevOutput color_dest;
+  TevOutput alpha_dest;
+  s16 color_bias;
+  s16 alpha_bias;
+  CombineFunc combine_color;
+  CombineFunc combine_alpha;
+};
+
+struct Tev::Program
+{
+  struct IndirectStage
+  {
+    u8 tex_coord;
+    u8 tex_map;
+    u8 scale_s;
+    u8 scale_t;
+  };
+
+  u32 num_texgens;
+  u32 num_ind_stages;
+  u32 num_tev_stages;
+  std::array<IndirectStage, 4> ind_stages;
+  std::array<StageProgram, 16> stages;
+  TevOutput output_color;
+  TevOutput output_alpha;
+  std::array<bool, 256> alpha_test;
+};
+
+template <TevOp op, TevScale scale, bool clamp>
+void Tev::CombineColorRegular(const InputRegType inputs[4], const StageProgram& stage)
+{
+  TevColor& dest = Reg[stage.color_dest];
+  for (int i = BLU_C; i <= RED_C; i++)
+  {
+    const InputRegType& InputReg = inputs[i];
+
+    const u16 c = InputReg.c + (InputReg.c >> 7);
+
+    s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
+    temp <<= s_ScaleLShiftLUT[scale];
+    temp += (scale == TevScale::Divide2) ? 0 : (op == TevOp::Sub) ? 127 : 128;
+    temp >>= 8;
+    temp = op == TevOp::Sub ? -temp : temp;
+
+    s32 result = ((InputReg.d + stage.color_bias) << s_ScaleLShiftLUT[scale]) + temp;
+    result = result >> s_ScaleRShiftLUT[scale];
+
+    dest[i] = result;
+    dest[i] = clamp ? Clamp255(dest[i]) : Clamp1024(dest[i]);
+  }
+}
+
+template <TevComparison comparison, TevCompareMode mode, bool clamp>
+void Tev::CombineColorCompare(const InputRegType inputs[4], const StageProgram& stage)
+{
+  TevColor& dest = Reg[stage.color_dest];
+  for (int i = BLU_C; i <= RED_C; i++)
+  {
+    u32 a, b;
+    if constexpr (mode == TevCompareMode::R8)
+    {
+      a = inputs[RED_C].a;
+      b = inputs[RED_C].b;
+    }
+    else if constexpr (mode == TevCompareMode::GR16)
+    {
+      a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+      b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+    }
+    else if constexpr (mode == TevCompareMode::BGR24)
+    {
+      a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+      b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+    }
+    else
+    {
+      a = inputs[i].a;
+      b = inputs[i].b;
+    }
+
+    const bool pass = comparison == TevComparison::GT ? (a > b) : (a == b);
+    dest[i] = inputs[i].d + (pass ? inputs[i].c : 0);
+    dest[i] = clamp ? Clamp255(dest[i]) : Clamp1024(dest[i]);
+  }
+}
+
+template <TevOp op, TevScale scale, bool clamp>
+void Tev::CombineAlphaRegular(const InputRegType inputs[4], const StageProgram& stage)
+{
+  const InputRegType& InputReg = inputs[ALP_C];
+
+  const u16 c = InputReg.c + (InputReg.c >> 7);
+
+  s32 temp = InputReg.a * (256 - c) + (InputReg.b * c);
+  temp <<= s_ScaleLShiftLUT[scale];
+  temp += (scale == TevScale::Divide2) ? 0 : (op == TevOp::Sub) ? 127 : 128;
+  temp = op == TevOp::Sub ? (-temp >> 8) : (temp >> 8);
+
+  s32 result = ((InputReg.d + stage.alpha_bias) << s_ScaleLShiftLUT[scale]) + temp;
+  result = result >> s_ScaleRShiftLUT[scale];
+
+  s16& dest = Reg[stage.alpha_dest].a;
+  dest = result;
+  dest = clamp ? Clamp255(dest) : Clamp1024(dest);
+}
+
+template <TevComparison comparison, TevCompareMode mode, bool clamp>
+void Tev::CombineAlphaCompare(const InputRegType inputs[4], const StageProgram& stage)
+{
+  u32 a, b;
+  if constexpr (mode == TevCompareMode::R8)
+  {
+    a = inputs[RED_C].a;
+    b = inputs[RED_C].b;
+  }
+  else if constexpr (mode == TevCompareMode::GR16)
+  {
+    a = (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+    b = (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+  }
+  else if constexpr (mode == TevCompareMode::BGR24)
+  {
+    a = (inputs[BLU_C].a << 16) | (inputs[GRN_C].a << 8) | inputs[RED_C].a;
+    b = (inputs[BLU_C].b << 16) | (inputs[GRN_C].b << 8) | inputs[RED_C].b;
+  }
+  else
+  {
+    a = inputs[ALP_C].a;
+    b = inputs[ALP_C].b;
+  }
+
+  const bool pass = comparison == TevComparison::GT ? (a > b) : (a == b);
+  s16& dest = Reg[stage.alpha_dest].a;
+  dest = inputs[ALP_C].d + (pass ? inputs[ALP_C].c : 0);
+  dest = clamp ? Clamp255(dest) : Clamp1024(dest);
+}
+
+namespace
+{
+// Combiner tables are indexed by (op << 3) | (scale << 1) | clamp for regular combiners and by
+// (comparison << 3) | (compare_mode << 1) | clamp for compare combiners.
+template <typename Combiner>
+u32 GetCombinerIndex(const Combiner& combiner)
+{
+  return (static_cast<u32>(combiner.op.Value()) << 3) |
+         (static_cast<u32>(combiner.scale.Value()) << 1) | static_cast<u32>(combiner.clamp.Value());
+}
+
+struct ProgramKey
+{
+  u32 gen_mode;
+  u32 tevindref;
+  u32 alpha_test;
+  std::array<u32, 2> texscale;
+  std::array<u32, 8> tevorders;
+  std::array<u32, 8> tevksel;
+  std::array<u32, 16> tevind;
+  std::array<u32, 32> combiners;
+
+  bool operator<(const ProgramKey& other) const
+  {
+    return std::memcmp(this, &other, sizeof(*this)) < 0;
+  }
+};
 
-  if (!TevAlphaTest(output[ALP_C]))
+// Bounds memory usage in games that cycle through many TEV configurations.
+constexpr size_t MAX_CACHED_PROGRAMS = 1024;
+
+std::map<ProgramKey, std::unique_ptr<const Tev::Program>> s_programs;
+}  // namespace
+
+Tev::CombineFunc Tev::GetColorCombiner(const TevStageCombiner::ColorCombiner& cc)
+{
+  static constexpr auto regular = []<size_t... i>(std::index_sequence<i...>) {
+    return std::array<CombineFunc, sizeof...(i)>{
+        &Tev::CombineColorRegular<static_cast<TevOp>(i >> 3), static_cast<TevScale>((i >> 1) & 3),
+                                  (i & 1) != 0>...};
+  }(std::make_index_sequence<16>());
+  static constexpr auto compare = []<size_t... i>(std::index_sequence<i...>) {
+    return std::array<CombineFunc, sizeof...(i)>{
+        &Tev::CombineColorCompare<static_cast<TevComparison>(i >> 3),
+                                  static_cast<TevCompareMode>((i >> 1) & 3), (i & 1) != 0>...};
+  }(std::make_index_sequence<16>());
+
+  if (cc.bias == TevBias::Compare)
+    return compare[GetCombinerIndex(cc)];
+  return regular[GetCombinerIndex(cc)];
+}
+
+Tev::CombineFunc Tev::GetAlphaCombiner(const TevStageCombiner::AlphaCombiner& ac)
+{
+  static constexpr auto regular = []<size_t... i>(std::index_sequence<i...>) {
+    return std::array<CombineFunc, sizeof...(i)>{
+        &Tev::CombineAlphaRegular<static_cast<TevOp>(i >> 3), static_cast<TevScale>((i >> 1) & 3),
+                                  (i & 1) != 0>...};
+  }(std::make_index_sequence<16>());
+  static constexpr auto compare = []<size_t... i>(std::index_sequence<i...>) {
+    return std::array<CombineFunc, sizeof...(i)>{
+        &Tev::CombineAlphaCompare<static_cast<TevComparison>(i >> 3),
+                                  static_cast<TevCompareMode>((i >> 1) & 3), (i & 1) != 0>...};
+  }(std::make_index_sequence<16>());
+
+  if (ac.bias == TevBias::Compare)
+    return compare[GetCombinerIndex(ac)];
+  return regular[GetCombinerIndex(ac)];
+}
+
+static std::array<u8, 4> GetSwapIndices(u32 swap_table)
+{
+  const auto swap = bpmem.tevksel.GetSwapTable(swap_table);
+  return {static_cast<u8>(swap[ColorChannel::Red]), static_cast<u8>(swap[ColorChannel::Green]),
+          static_cast<u8>(swap[ColorChannel::Blue]), static_cast<u8>(swap[ColorChannel::Alpha])};
+}
+
+const Tev::Program* Tev::GetProgram()
+{
+  ProgramKey key;
+  key.gen_mode = bpmem.genMode.hex;
+  key.tevindref = bpmem.tevindref.hex;
+  key.alpha_test = bpmem.alpha_test.hex;
+  for (size_t i = 0; i < key.texscale.size(); i++)
+    key.texscale[i] = bpmem.texscale[i].hex;
+  for (size_t i = 0; i < key.tevorders.size(); i++)
+    key.tevorders[i] = bpmem.tevorders[i].hex;
+  for (size_t i = 0; i < key.tevksel.size(); i++)
+    key.tevksel[i] = bpmem.tevksel.ksel[i].hex;
+  for (size_t i = 0; i < key.tevind.size(); i++)
+    key.tevind[i] = bpmem.tevind[i].hex;
+  for (size_t i = 0; i < 16; i++)
+  {
+    key.combiners[i * 2] = bpmem.combiners[i].colorC.hex;
+    key.combiners[i * 2 + 1] = bpmem.combiners[i].alphaC.hex;
+  }
+
+  auto iter = s_programs.find(key);
+  if (iter != s_programs.end())
+    return iter->second.get();
+
+  if (s_programs.size() >= MAX_CACHED_PROGRAMS)
+    s_programs.clear();
+
+  const u32 num_texgens = bpmem.genMode.numtexgens;
+  const u32 num_tev_stages = bpmem.genMode.numtevstages + 1;
+
+  // Invalid ras color channels raise a panic alert for every pixel in the generic path; keep that
+  // behavior rather than duplicating it here.
+  for (u32 stage_num = 0; stage_num < num_tev_stages; stage_num++)
+  {
+    const RasColorChan chan = bpmem.tevorders[stage_num >> 1].getColorChan(stage_num & 1);
+    if (chan != RasColorChan::Color0 && chan != RasColorChan::Color1 &&
+        chan != RasColorChan::AlphaBump && chan != RasColorChan::NormalizedAlphaBump &&
+        chan != RasColorChan::Zero)
+    {
+      return s_programs.emplace(key, nullptr).first->second.get();
+    }
+  }
+
+  auto program = std::make_unique<Program>();
+  program->num_texgens = num_texgens;
+  program->num_ind_stages = bpmem.genMode.numindstages;
+  program->num_tev_stages = num_tev_stages;
+
+  for (u32 stage_num = 0; stage_num < program->num_ind_stages; stage_num++)
+  {
+    Program::IndirectStage& stage = program->ind_stages[stage_num];
+
+    // Same tex coord quirk as in DrawStages
+    const u32 tex_coord = bpmem.tevindref.getTexCoord(stage_num);
+    const TEXSCALE& texscale = bpmem.texscale[stage_num >> 1];
+    stage.tex_coord = static_cast<u8>(tex_coord < num_texgens ? tex_coord : 0);
+    stage.tex_map = static_cast<u8>(bpmem.tevindref.getTexMap(stage_num));
+    stage.scale_s = static_cast<u8>((stage_num & 1) ? texscale.ss1 : texscale.ss0);
+    stage.scale_t = static_cast<u8>((stage_num & 1) ? texscale.ts1 : texscale.ts0);
+  }
+
+  for (u32 stage_num = 0; stage_num < num_tev_stages; stage_num++)
+  {
+    StageProgram& stage = program->stages[stage_num];
+    const int stage_odd = stage_num & 1;
+    const TwoTevStageOrders& order = bpmem.tevorders[stage_num >> 1];
+    const TevStageCombiner::ColorCombiner& cc = bpmem.combiners[stage_num].colorC;
+    const TevStageCombiner::AlphaCombiner& ac = bpmem.combiners[stage_num].alphaC;
+
+    const u32 tex_coord = order.getTexCoord(stage_odd);
+    stage.tex_coord = static_cast<u8>(tex_coord < num_texgens ? tex_coord : 0);
+    stage.tex_map = static_cast<u8>(order.getTexMap(stage_odd));
+    stage.tex_enable = order.getEnable(stage_odd);
+    stage.direct = bpmem.tevind[stage_num].hex == 0;
+    stage.tex_swap = GetSwapIndices(ac.tswap);
+
+    stage.ras_chan = order.getColorChan(stage_odd);
+    stage.ras_swap = GetSwapIndices(ac.rswap);
+
+    stage.konst_color = bpmem.tevksel.GetKonstColor(stage_num);
+    stage.konst_alpha = bpmem.tevksel.GetKonstAlpha(stage_num);
+
+    stage.color_inputs = {cc.a, cc.b, cc.c, cc.d};
+    stage.alpha_inputs = {ac.a, ac.b, ac.c, ac.d};
+    stage.color_dest = cc.dest;
+    stage.alpha_dest = ac.dest;
+    stage.color_bias = s_BiasLUT[cc.bias];
+    stage.alpha_bias = s_BiasLUT[ac.bias];
+    stage.combine_color = GetColorCombiner(cc);
+    stage.combine_alpha = GetAlphaCombiner(ac);
+  }
+
+  program->output_color = bpmem.combiners[num_tev_stages - 1].colorC.dest;
+  program->output_alpha = bpmem.combiners[num_tev_stages - 1].alphaC.dest;
+
+  for (u32 alpha = 0; alpha < program->alpha_test.size(); alpha++)
+    program->alpha_test[alpha] = TevAlphaTest(alpha);
+
+  return s_programs.emplace(key, std::move(program)).first->second.get();
+}
+
+bool Tev::DrawProgram(const Program& program, u8 output[4])
+{
+  for (int i = 0; i < 4; i++)
+    Reg[static_cast<TevOutput>(i)] = InitialRegs[i];
+
+  for (u32 stage_num = 0; stage_num < program.num_ind_stages; stage_num++)
+  {
+    const Program::IndirectStage& stage = program.ind_stages[stage_num];
+    TextureSampler::Sample(Uv[stage.tex_coord].s >> stage.scale_s,
+                           Uv[stage.tex_coord].t >> stage.scale_t, IndirectLod[stage_num],
+                           IndirectLinear[stage_num], stage.tex_map, IndirectTex[stage_num],
+                           m_texel_cache);
+  }
+
+  for (u32 stage_num = 0; stage_num < program.num_tev_stages; stage_num++)
+  {
+    const StageProgram& stage = program.stages[stage_num];
+    const TextureCoordinateType& uv = Uv[stage.tex_coord];
+
+    if (stage.direct)
+    {
+      TexCoord.s = uv.s;
+      TexCoord.t = uv.t;
+      AlphaBump = 0;
+    }
+    else
+    {
+      Indirect(stage_num, uv.s, uv.t);
+    }
+
+    // sample texture
+    if (stage.tex_enable)
+    {
+      // RGBA
+      u8 texel[4];
+
+      if (program.num_texgens > 0)
+      {
+        TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stage_num],
+                               TextureLinear[stage_num], stage.tex_map, texel, m_texel_cache);
+      }
+      else
+      {
+        std::memset(texel, 0, 4);
+      }
+
+      RawTexColor.r = texel[u32(ColorChannel::Red)];
+      RawTexColor.g = texel[u32(ColorChannel::Green)];
+      RawTexColor.b = texel[u32(ColorChannel::Blue)];
+      RawTexColor.a = texel[u32(ColorChannel::Alpha)];
+
+      TexColor.r = texel[stage.tex_swap[0]];
+      TexColor.g = texel[stage.tex_swap[1]];
+      TexColor.b = texel[stage.tex_swap[2]];
+      TexColor.a = texel[stage.tex_swap[3]];
+    }
+
+    StageKonst.r = m_KonstLUT[stage.konst_color].r;
+    StageKonst.g = m_KonstLUT[stage.konst_color].g;
+    StageKonst.b = m_KonstLUT[stage.konst_color].b;
+    StageKonst.a = m_KonstLUT[stage.konst_alpha].a;
+
+    switch (stage.ras_chan)
+    {
+    case RasColorChan::Color0:
+    case RasColorChan::Color1:
+    {
+      const u8* color = Color[stage.ras_chan == RasColorChan::Color1];
+      RasColor.r = color[stage.ras_swap[0]];
+      RasColor.g = color[stage.ras_swap[1]];
+      RasColor.b = color[stage.ras_swap[2]];
+      RasColor.a = color[stage.ras_swap[3]];
+      break;
+    }
+    case RasColorChan::AlphaBump:
+      RasColor = TevColor::All(AlphaBump);
+      break;
+    case RasColorChan::NormalizedAlphaBump:
+      RasColor = TevColor::All(AlphaBump | AlphaBump >> 5);
+      break;
+    default:
+      RasColor = TevColor::All(0);
+      break;
+    }
+
+    // combine inputs
+    const TevColorRef& color_a = m_ColorInputLUT[stage.color_inputs[0]];
+    const TevColorRef& color_b = m_ColorInputLUT[stage.color_inputs[1]];
+    const TevColorRef& color_c = m_ColorInputLUT[stage.color_inputs[2]];
+    const TevColorRef& color_d = m_ColorInputLUT[stage.color_inputs[3]];
+
+    InputRegType inputs[4];
+    inputs[BLU_C].a = color_a.b;
+    inputs[BLU_C].b = color_b.b;
+    inputs[BLU_C].c = color_c.b;
+    inputs[BLU_C].d = color_d.b;
+    inputs[GRN_C].a = color_a.g;
+    inputs[GRN_C].b = color_b.g;
+    inputs[GRN_C].c = color_c.g;
+    inputs[GRN_C].d = color_d.g;
+    inputs[RED_C].a = color_a.r;
+    inputs[RED_C].b = color_b.r;
+    inputs[RED_C].c = color_c.r;
+    inputs[RED_C].d = color_d.r;
+    inputs[ALP_C].a = m_AlphaInputLUT[stage.alpha_inputs[0]].a;
+    inputs[ALP_C].b = m_AlphaInputLUT[stage.alpha_inputs[1]].a;
+    inputs[ALP_C].c = m_AlphaInputLUT[stage.alpha_inputs[2]].a;
+    inputs[ALP_C].d = m_AlphaInputLUT[stage.alpha_inputs[3]].a;
+
+    (this->*stage.combine_color)(inputs, stage);
+    (this->*stage.combine_alpha)(inputs, stage);
+  }
+
+  output[ALP_C] = (u8)Reg[program.output_alpha].a;
+  output[BLU_C] = (u8)Reg[program.output_color].b;
+  output[GRN_C] = (u8)Reg[program.output_color].g;
+  output[RED_C] = (u8)Reg[program.output_color].r;
+
+  return program.alpha_test[output[ALP_C]];
+}
+
+void Tev::Draw()
+{
+  ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
+  ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
+
+  counters.tev_pixels_in++;
+
+  u8 output[4];
+  const bool alpha_test_passed = m_program ? DrawProgram(*m_program, output) : DrawStages(output);
+  if (!alpha_test_passed)
     return;
 
   // z texture
@@ -663,32 +1119,42 @@ void Tev::Draw()
   if (bpmem.GetEmulatedZ() == EmulatedZ::Late)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    counters.perf_pixels[PQ_ZCOMP_INPUT]++;
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    counters.perf_pixels[PQ_ZCOMP_OUTPUT]++;
   }
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
+  counters.bbox_left = std::min(counters.bbox_left, static_cast<u16>(Position[0] & ~1));
+  counters.bbox_right = std::max(counters.bbox_right, static_cast<u16>(Position[0] | 1));
+  counters.bbox_top = std::min(counters.bbox_top, static_cast<u16>(Position[1] & ~1));
+  counters.bbox_bottom = std::max(counters.bbox_bottom, static_cast<u16>(Position[1] | 1));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  counters.tev_pixels_out++;
+  counters.perf_pixels[PQ_BLEND_INPUT]++;
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
 
-void Tev::SetKonstColors()
+void Tev::SetBatchState(const Program* program)
 {
   auto& system = Core::System::GetInstance();
   auto& pixel_shader_manager = system.GetPixelShaderManager();
 
+  m_program = program;
+  m_texel_cache.Invalidate();
+
   for (int i = 0; i < 4; i++)
   {
+    InitialRegs[i].r = pixel_shader_manager.constants.colors[i][0];
+    InitialRegs[i].g = pixel_shader_manager.constants.colors[i][1];
+    InitialRegs[i].b = pixel_shader_manager.constants.colors[i][2];
+    InitialRegs[i].a = pixel_shader_manager.constants.colors[i][3];
+
     KonstantColors[i].r = pixel_shader_manager.constants.kcolors[i][0];
     KonstantColors[i].g = pixel_shader_manager.constants.kcolors[i][1];
     KonstantColors[i].b = pixel_shader_manager.constants.kcolors[i][2];
@@ -6,7 +6,9 @@
 #include <array>
 
 #include "Common/EnumMap.h"
+#include "VideoBackends/Software/TextureSampler.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -213,6 +215,24 @@ class Tev
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
+  bool DrawStages(u8 output[4]);
+
+  // Specialized stage program path, see GetProgram()
+  struct StageProgram;
+  using CombineFunc = void (Tev::*)(const InputRegType inputs[4], const StageProgram& stage);
+
+  template <TevOp op, TevScale scale, bool clamp>
+  void CombineColorRegular(const InputRegType inputs[4], const StageProgram& stage);
+  template <TevComparison comparison, TevCompareMode mode, bool clamp>
+  void CombineColorCompare(const InputRegType inputs[4], const StageProgram& stage);
+  template <TevOp op, TevScale scale, bool clamp>
+  void CombineAlphaRegular(const InputRegType inputs[4], const StageProgram& stage);
+  template <TevComparison comparison, TevCompareMode mode, bool clamp>
+  void CombineAlphaCompare(const InputRegType inputs[4], const StageProgram& stage);
+
+  static CombineFunc GetColorCombiner(const TevStageCombiner::ColorCombiner& cc);
+  static CombineFunc GetAlphaCombiner(const TevStageCombiner::AlphaCombiner& ac);
+
 public:
   s32 Position[3]{};
   u8 Color[2][4]{};  // must be RGBA for correct swap table ordering
@@ -230,6 +250,39 @@ public:
     RED_C
   };
 
-  void SetKonstColors();
+  // Statistics, perf query and bounding box updates made while drawing. These are accumulated
+  // per instance so that several instances can draw at the same time, and are merged into the
+  // global state by the rasterizer once a batch is done.
+  struct Counters
+  {
+    u32 rasterized_pixels = 0;
+    u32 tev_pixels_in = 0;
+    u32 tev_pixels_out = 0;
+    std::array<u32, PQ_NUM_MEMBERS> perf_pixels{};
+    u16 bbox_left = 0xffff;
+    u16 bbox_right = 0;
+    u16 bbox_top = 0xffff;
+    u16 bbox_bottom = 0;
+  };
+  Counters counters;
+
+  // BP state used by Draw(), decoded once per batch into a flat per-stage description with the
+  // combiner arithmetic specialized on the stage's op, scale and clamp settings.
+  struct Program;
+
+  // Returns the program for the current BP state, or nullptr if the state contains values only
+  // the generic path handles. Programs are cached by the BP registers they were built from.
+  static const Program* GetProgram();
+
+  // Latches the konst colors, initial register values and program for the current batch, and
+  // drops texels decoded for the previous one.
+  void SetBatchState(const Program* program);
   void Draw();
+
+private:
+  bool DrawProgram(const Program& program, u8 output[4]);
+
+  std::array<TevColor, 4> InitialRegs;
+  const Program* m_program = nullptr;
+  TextureSampler::TexelCache m_texel_cache;
 };
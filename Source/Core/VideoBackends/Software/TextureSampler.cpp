@@ -4,8 +4,16 @@
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include <algorithm>
+#include <cstring>
 #include <span>
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+#include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
 #include "Common/SpanUtils.h"
@@ -69,7 +77,131 @@ static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
   outTexel[3] += inTexel[3] * fract;
 }
 
-void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
+// Weights the four RGBA texels of a bilinear footprint by (128 - fractS/fractT) and fractS/fractT
+// respectively and sums them; exactly the same integer arithmetic as SetTexel/AddTexel.
+static inline void BilinearFilter(const u8* texel00, const u8* texel10, const u8* texel01,
+                                  const u8* texel11, u32 fractS, u32 fractT, u8* sample)
+{
+  const u32 weight00 = (128 - fractS) * (128 - fractT);
+  const u32 weight10 = fractS * (128 - fractT);
+  const u32 weight01 = (128 - fractS) * fractT;
+  const u32 weight11 = fractS * fractT;
+
+#if defined(_M_X86_64)
+  u32 t00, t10, t01, t11;
+  std::memcpy(&t00, texel00, sizeof(u32));
+  std::memcpy(&t10, texel10, sizeof(u32));
+  std::memcpy(&t01, texel01, sizeof(u32));
+  std::memcpy(&t11, texel11, sizeof(u32));
+
+  // Interleave the channels of horizontally adjacent texels and widen them to 16 bits, so that
+  // madd computes texel0 * weight0 + texel1 * weight1 per channel. The weights are at most
+  // 128 * 128, which fits in a signed 16-bit lane.
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i top =
+      _mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128(t00), _mm_cvtsi32_si128(t10)), zero);
+  const __m128i bottom =
+      _mm_unpacklo_epi8(_mm_unpacklo_epi8(_mm_cvtsi32_si128(t01), _mm_cvtsi32_si128(t11)), zero);
+  const __m128i top_weights = _mm_set1_epi32(static_cast<int>(weight00 | (weight10 << 16)));
+  const __m128i bottom_weights = _mm_set1_epi32(static_cast<int>(weight01 | (weight11 << 16)));
+
+  __m128i sum =
+      _mm_add_epi32(_mm_madd_epi16(top, top_weights), _mm_madd_epi16(bottom, bottom_weights));
+  sum = _mm_srli_epi32(sum, 14);
+  sum = _mm_packs_epi32(sum, sum);
+  sum = _mm_packus_epi16(sum, sum);
+
+  const u32 result = static_cast<u32>(_mm_cvtsi128_si32(sum));
+  std::memcpy(sample, &result, sizeof(u32));
+#elif defined(_M_ARM_64)
+  u32 t00, t10, t01, t11;
+  std::memcpy(&t00, texel00, sizeof(u32));
+  std::memcpy(&t10, texel10, sizeof(u32));
+  std::memcpy(&t01, texel01, sizeof(u32));
+  std::memcpy(&t11, texel11, sizeof(u32));
+
+  const uint16x4_t c00 = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(t00))));
+  const uint16x4_t c10 = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(t10))));
+  const uint16x4_t c01 = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(t01))));
+  const uint16x4_t c11 = vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(t11))));
+
+  uint32x4_t sum = vmull_n_u16(c00, static_cast<u16>(weight00));
+  sum = vmlal_n_u16(sum, c10, static_cast<u16>(weight10));
+  sum = vmlal_n_u16(sum, c01, static_cast<u16>(weight01));
+  sum = vmlal_n_u16(sum, c11, static_cast<u16>(weight11));
+
+  const uint16x4_t narrow = vmovn_u32(vshrq_n_u32(sum, 14));
+  const uint8x8_t result = vmovn_u16(vcombine_u16(narrow, narrow));
+  vst1_lane_u32(reinterpret_cast<u32*>(sample), vreinterpret_u32_u8(result), 0);
+#else
+  u32 texel[4];
+  SetTexel(texel00, texel, weight00);
+  AddTexel(texel10, texel, weight10);
+  AddTexel(texel01, texel, weight01);
+  AddTexel(texel11, texel, weight11);
+
+  sample[0] = (u8)(texel[0] >> 14);
+  sample[1] = (u8)(texel[1] >> 14);
+  sample[2] = (u8)(texel[2] >> 14);
+  sample[3] = (u8)(texel[3] >> 14);
+#endif
+}
+
+void TexelCache::Invalidate()
+{
+  if (++m_generation != 0)
+    return;
+
+  // The generation counter wrapped around, make sure no tile looks valid
+  for (auto& levels : m_levels)
+  {
+    for (Level& level : levels)
+    {
+      level.generation = 0;
+      std::fill(level.tile_generations.begin(), level.tile_generations.end(), 0);
+    }
+  }
+  m_generation = 1;
+}
+
+const u8* TexelCache::Level::GetTexel(int s, int t, u32 cache_generation)
+{
+  const u32 tile = static_cast<u32>(t >> 2) * tiles_wide + static_cast<u32>(s >> 2);
+  u32* tile_texels = &texels[tile * 16];
+
+  if (tile_generations[tile] != cache_generation)
+  {
+    DecodeTile(static_cast<u32>(s) & ~3u, static_cast<u32>(t) & ~3u, tile_texels);
+    tile_generations[tile] = cache_generation;
+  }
+
+  return reinterpret_cast<const u8*>(&tile_texels[(t & 3) * 4 + (s & 3)]);
+}
+
+void TexelCache::Level::DecodeTile(u32 tile_s, u32 tile_t, u32* tile_texels) const
+{
+  const u32 end_s = std::min<u32>(tile_s + 4, static_cast<u32>(width_minus_1) + 1);
+  const u32 end_t = std::min<u32>(tile_t + 4, static_cast<u32>(height_minus_1) + 1);
+
+  for (u32 t = tile_t; t < end_t; t++)
+  {
+    for (u32 s = tile_s; s < end_s; s++)
+    {
+      u8* texel = reinterpret_cast<u8*>(&tile_texels[(t & 3) * 4 + (s & 3)]);
+      if (rgba8_from_tmem)
+      {
+        TexDecoder_DecodeTexelRGBA8FromTmem(texel, image_src, image_src_odd, s, t,
+                                            width_minus_1);
+      }
+      else
+      {
+        TexDecoder_DecodeTexel(texel, image_src, s, t, width_minus_1, format, tlut, tlut_format);
+      }
+    }
+  }
+}
+
+void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample, TexelCache& cache)
 {
   int baseMip = 0;
   bool mipLinear = false;
@@ -96,10 +228,10 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
     u8 sampledTex[4];
     u32 texel[4];
 
-    SampleMip(s, t, baseMip, linear, texmap, sampledTex);
+    SampleMip(s, t, baseMip, linear, texmap, sampledTex, cache);
     SetTexel(sampledTex, texel, (16 - lodFract));
 
-    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex);
+    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex, cache);
     AddTexel(sampledTex, texel, lodFract);
 
     sample[0] = (u8)(texel[0] >> 4);
@@ -110,19 +242,16 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
   else
 #endif
   {
-    SampleMip(s, t, baseMip, linear, texmap, sample);
+    SampleMip(s, t, baseMip, linear, texmap, sample, cache);
   }
 }
 
-void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
+// Sets up a cache level for the texture currently bound to texmap at the given mip level
+static void SetupLevel(TexelCache::Level& level, const TexUnit& texUnit, s32 mip)
 {
-  auto texUnit = bpmem.tex.GetUnit(texmap);
-
-  const TexMode0& tm0 = texUnit.texMode0;
   const TexImage0& ti0 = texUnit.texImage0;
   const TexTLUT& texTlut = texUnit.texTlut;
   const TextureFormat texfmt = ti0.format;
-  const TLUTFormat tlutfmt = texTlut.tlut_format;
 
   std::span<const u8> image_src;
   std::span<const u8> image_src_odd;
@@ -144,10 +273,7 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
   int image_width_minus_1 = ti0.width;
   int image_height_minus_1 = ti0.height;
 
-  const int tlutAddress = texTlut.tmem_offset << 9;
-  const std::span<const u8> tlut = TexDecoder_GetTmemSpan(tlutAddress);
-
-  // reduce sample location and texture size to mip level
+  // reduce texture size to mip level
   // move texture pointer to mip location
   if (mip)
   {
@@ -160,8 +286,6 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
 
     image_width_minus_1 >>= mip;
     image_height_minus_1 >>= mip;
-    s >>= mip;
-    t >>= mip;
 
     while (mip)
     {
@@ -176,6 +300,50 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     }
   }
 
+  const int tlutAddress = texTlut.tmem_offset << 9;
+
+  level.image_src = image_src;
+  level.image_src_odd = image_src_odd;
+  level.tlut = TexDecoder_GetTmemSpan(tlutAddress);
+  level.format = texfmt;
+  level.tlut_format = texTlut.tlut_format;
+  level.rgba8_from_tmem =
+      texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed;
+  level.width_minus_1 = image_width_minus_1;
+  level.height_minus_1 = image_height_minus_1;
+
+  // Only ever grow the storage; new tiles start out with generation 0, which is never current.
+  level.tiles_wide = static_cast<u32>(image_width_minus_1 + 4) / 4;
+  const u32 tiles_high = static_cast<u32>(image_height_minus_1 + 4) / 4;
+  const size_t num_tiles = static_cast<size_t>(level.tiles_wide) * tiles_high;
+  if (level.tile_generations.size() < num_tiles)
+  {
+    level.tile_generations.resize(num_tiles);
+    level.texels.resize(num_tiles * 16);
+  }
+}
+
+void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample, TexelCache& cache)
+{
+  auto texUnit = bpmem.tex.GetUnit(texmap);
+  const TexMode0& tm0 = texUnit.texMode0;
+
+  ASSERT(mip >= 0 && mip < static_cast<s32>(TexelCache::MAX_MIP_LEVELS));
+  TexelCache::Level& level = cache.GetLevel(texmap, mip);
+  const u32 generation = cache.GetGeneration();
+  if (level.generation != generation)
+  {
+    SetupLevel(level, texUnit, mip);
+    level.generation = generation;
+  }
+
+  const int image_width_minus_1 = level.width_minus_1;
+  const int image_height_minus_1 = level.height_minus_1;
+
+  // reduce sample location to mip level
+  s >>= mip;
+  t >>= mip;
+
   if (linear)
   {
     // offset linear sampling
@@ -193,55 +361,15 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
-
     WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
     WrapCoord(&imageSPlus1, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageTPlus1, tm0.wrap_t, image_height_minus_1 + 1);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
-    {
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageS, imageT, image_width_minus_1, texfmt,
-                             tlut, tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageSPlus1, imageT, image_width_minus_1,
-                             texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageS, imageTPlus1, image_width_minus_1,
-                             texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageSPlus1, imageTPlus1, image_width_minus_1,
-                             texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
-    else
-    {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageS, imageT,
-                                          image_width_minus_1);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageSPlus1, imageT,
-                                          image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageS, imageTPlus1,
-                                          image_width_minus_1);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageSPlus1,
-                                          imageTPlus1, image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
-    }
-
-    sample[0] = (u8)(texel[0] >> 14);
-    sample[1] = (u8)(texel[1] >> 14);
-    sample[2] = (u8)(texel[2] >> 14);
-    sample[3] = (u8)(texel[3] >> 14);
+    BilinearFilter(level.GetTexel(imageS, imageT, generation),
+                   level.GetTexel(imageSPlus1, imageT, generation),
+                   level.GetTexel(imageS, imageTPlus1, generation),
+                   level.GetTexel(imageSPlus1, imageTPlus1, generation), fractS, fractT, sample);
   }
   else
   {
@@ -253,16 +381,7 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
-    {
-      TexDecoder_DecodeTexel(sample, image_src, imageS, imageT, image_width_minus_1, texfmt, tlut,
-                             tlutfmt);
-    }
-    else
-    {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sample, image_src, image_src_odd, imageS, imageT,
-                                          image_width_minus_1);
-    }
+    std::memcpy(sample, level.GetTexel(imageS, imageT, generation), 4);
   }
 }
 }  // namespace TextureSampler
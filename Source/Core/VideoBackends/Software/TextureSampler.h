@@ -3,13 +3,62 @@
 
 #pragma once
 
+#include <array>
+#include <span>
+#include <vector>
+
 #include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
 
 namespace TextureSampler
 {
-void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample);
+// Holds texels decoded on demand in 4x4 tiles, so that a texel shared by neighbouring pixels or
+// bilinear taps is only decoded once. Texture state and memory can't change while a batch is
+// being drawn, so the cache is only valid for one batch and must be invalidated between batches.
+// A cache must not be shared between threads.
+class TexelCache
+{
+public:
+  // Mip levels 0 to 15, plus the level above for trilinear filtering
+  static constexpr u32 MAX_MIP_LEVELS = 17;
+
+  struct Level
+  {
+    u32 generation = 0;
+
+    std::span<const u8> image_src;
+    std::span<const u8> image_src_odd;
+    std::span<const u8> tlut;
+    TextureFormat format{};
+    TLUTFormat tlut_format{};
+    bool rgba8_from_tmem = false;
+    int width_minus_1 = 0;
+    int height_minus_1 = 0;
+
+    u32 tiles_wide = 0;
+    std::vector<u32> texels;
+    std::vector<u32> tile_generations;
+
+    // s and t must be inside the level
+    const u8* GetTexel(int s, int t, u32 cache_generation);
+
+  private:
+    void DecodeTile(u32 tile_s, u32 tile_t, u32* tile_texels) const;
+  };
+
+  void Invalidate();
+
+  u32 GetGeneration() const { return m_generation; }
+  Level& GetLevel(u8 texmap, s32 mip) { return m_levels[texmap][mip]; }
+
+private:
+  u32 m_generation = 1;
+  std::array<std::array<Level, MAX_MIP_LEVELS>, 8> m_levels;
+};
+
+void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample, TexelCache& cache);
 
-void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample);
+void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample, TexelCache& cache);
 
 enum
 {
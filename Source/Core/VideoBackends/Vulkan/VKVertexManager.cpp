@@ -193,6 +193,9 @@ void VertexManager::CommitBuffer(u32 num_vertices, u32 vertex_stride, u32 num_in
 
 void VertexManager::UploadUniforms()
 {
+  // Constants are streamed, so a changed block has to be written out in full, but blocks that are
+  // flagged dirty without any of their contents changing don't need a new copy or binding.
+  UpdateUniformTrackers();
   UpdateVertexShaderConstants();
   UpdateGeometryShaderConstants();
   UpdatePixelShaderConstants();
@@ -3,6 +3,13 @@
 
 #include "VideoCommon/FrameDumper.h"
 
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+#include <fmt/format.h>
+
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/Image.h"
@@ -27,10 +34,22 @@ static bool DumpFrameToPNG(const FrameData& frame, const std::string& file_name)
                                             Config::Get(Config::GFX_PNG_COMPRESSION_LEVEL));
 }
 
+// Frames that can be waiting to be encoded before the video thread has to wait for the encoders.
+// Bounds the memory used when the encoders can't keep up.
+static constexpr u32 MAX_QUEUED_FRAMES = 8;
+
+static u32 GetNumPNGEncodeThreads()
+{
+  return std::clamp(std::thread::hardware_concurrency() / 2, 1u, 8u);
+}
+
 FrameDumper::FrameDumper()
 {
-  m_frame_end_handle =
-      GetVideoEvents().after_frame_event.Register([this](Core::System&) { FlushFrameDump(); });
+  m_frame_end_handle = GetVideoEvents().after_frame_event.Register([this](Core::System&) {
+    // Shutdown frame dumping if it is no longer active.
+    if (!IsFrameDumping() && (m_num_pending_readbacks != 0 || m_frame_dump_thread_running.IsSet()))
+      ShutdownFrameDumping();
+  });
 }
 
 FrameDumper::~FrameDumper()
@@ -61,13 +80,31 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  // Only wait for the oldest copy once every readback texture is in use.
+  if (m_num_pending_readbacks == NUM_READBACK_TEXTURES)
+    QueueOldestReadback();
+
+  Readback& readback =
+      m_readbacks[(m_first_readback + m_num_pending_readbacks) % NUM_READBACK_TEXTURES];
+  if (!CheckFrameDumpReadbackTexture(readback, target_width, target_height))
+  {
+    std::lock_guard lk(m_queue_lock);
+    ++m_stats.frames_dropped;
     return;
+  }
+
+  readback.texture->CopyFromTexture(src_texture, copy_rect, 0, 0, readback.texture->GetRect());
+  readback.state = m_ffmpeg_dump.FetchState(ticks, frame_number);
+  readback.dump_frame = Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES);
+  readback.screenshot_name.clear();
+  if (m_screenshot_request.TestAndClear())
+  {
+    std::lock_guard<std::mutex> lk(m_screenshot_lock);
+    readback.screenshot_name = std::move(m_screenshot_name);
+    m_screenshot_name.clear();
+  }
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_ffmpeg_dump.FetchState(ticks, frame_number);
-  m_frame_dump_needs_flush = true;
+  ++m_num_pending_readbacks;
 }
 
 bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -98,9 +135,10 @@ bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_heigh
   return true;
 }
 
-bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+bool FrameDumper::CheckFrameDumpReadbackTexture(Readback& readback, u32 target_width,
+                                                u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
+  std::unique_ptr<AbstractStagingTexture>& rbtex = readback.texture;
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
@@ -117,156 +155,212 @@ bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_hei
 
 void FrameDumper::FlushFrameDump()
 {
-  if (!m_frame_dump_needs_flush)
-    return;
+  while (m_num_pending_readbacks != 0)
+    QueueOldestReadback();
+}
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
+void FrameDumper::QueueOldestReadback()
+{
+  Readback& readback = m_readbacks[m_first_readback];
+  m_first_readback = (m_first_readback + 1) % NUM_READBACK_TEXTURES;
+  --m_num_pending_readbacks;
 
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  // Frame dumping may have been turned off since the copy was made.
+  if (!readback.dump_frame && readback.screenshot_name.empty())
+    return;
 
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
-  {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
-  }
-  else
+  AbstractStagingTexture* const texture = readback.texture.get();
+  texture->Flush();
+  if (!texture->Map())
   {
     ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+    std::lock_guard lk(m_queue_lock);
+    ++m_stats.frames_dropped;
+    return;
   }
 
-  m_frame_dump_needs_flush = false;
-
-  // Shutdown frame dumping if it is no longer active.
-  if (!IsFrameDumping())
-    ShutdownFrameDumping();
-}
-
-void FrameDumper::ShutdownFrameDumping()
-{
-  // Ensure the last queued readback has been sent to the encoder.
-  FlushFrameDump();
-
   if (!m_frame_dump_thread_running.IsSet())
-    return;
+  {
+    m_dump_to_ffmpeg = !Config::Get(Config::GFX_DUMP_FRAMES_AS_IMAGES);
+    m_frame_dump_started = false;
+    m_frame_dump_start_failed = false;
 
-  // Ensure previous frame has been encoded.
-  FinishFrameData();
+// If Dolphin was compiled without ffmpeg, we only support dumping to images.
+#if !defined(HAVE_FFMPEG)
+    if (m_dump_to_ffmpeg)
+    {
+      WARN_LOG_FMT(VIDEO, "FrameDump: Dolphin was not compiled with FFmpeg, using fallback option. "
+                          "Frames will be saved as PNG images instead.");
+      m_dump_to_ffmpeg = false;
+    }
+#endif
 
-  // Wake thread up, and wait for it to exit.
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
-  if (m_frame_dump_thread.joinable())
-    m_frame_dump_thread.join();
-  m_frame_dump_render_framebuffer.reset();
-  m_frame_dump_render_texture.reset();
+    {
+      std::lock_guard lk(m_queue_lock);
+      m_stats = {};
+    }
+
+    m_frame_dump_thread.Reset("FrameDumping", [this](QueuedFrame frame) {
+      DumpQueuedFrame(std::move(frame));
+    });
+    m_frame_dump_thread_running.Set();
+  }
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+  QueuedFrame frame;
+  frame.width = texture->GetConfig().width;
+  frame.height = texture->GetConfig().height;
+  frame.stride = static_cast<int>(texture->GetMappedStride());
+  frame.state = readback.state;
+  frame.dump_frame = readback.dump_frame;
+  frame.screenshot_name = std::move(readback.screenshot_name);
+
+  // Copy the frame out so the staging texture can be reused right away, no matter how long
+  // encoding takes.
+  WaitForQueueSpace();
+  frame.data = AcquireFrameBuffer(static_cast<size_t>(frame.stride) * frame.height);
+  std::memcpy(frame.data.data(), texture->GetMappedPointer(), frame.data.size());
+  texture->Unmap();
+
+  m_frame_dump_thread.Push(std::move(frame));
 }
 
-void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
+void FrameDumper::WaitForQueueSpace()
 {
-  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state};
-
-  if (!m_frame_dump_thread_running.IsSet())
+  std::unique_lock lk(m_queue_lock);
+  if (m_queue_depth >= MAX_QUEUED_FRAMES)
   {
-    if (m_frame_dump_thread.joinable())
-      m_frame_dump_thread.join();
-    m_frame_dump_thread_running.Set();
-    m_frame_dump_thread = std::thread(&FrameDumper::FrameDumpThreadFunc, this);
+    const TimePoint start = Clock::now();
+    m_frame_encoded.wait(lk, [this] { return m_queue_depth < MAX_QUEUED_FRAMES; });
+    ++m_stats.stalls;
+    m_stats.stall_time += Clock::now() - start;
   }
 
-  // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
+  ++m_queue_depth;
+  ++m_stats.frames_queued;
+  m_stats.max_queue_depth = std::max(m_stats.max_queue_depth, m_queue_depth);
 }
 
-void FrameDumper::FinishFrameData()
+void FrameDumper::OnFrameEncoded(std::vector<u8> buffer)
 {
-  if (!m_frame_dump_frame_running)
-    return;
+  std::lock_guard lk(m_queue_lock);
+  --m_queue_depth;
+  if (m_free_frame_buffers.size() < MAX_QUEUED_FRAMES)
+    m_free_frame_buffers.push_back(std::move(buffer));
+  m_frame_encoded.notify_one();
+}
 
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+std::vector<u8> FrameDumper::AcquireFrameBuffer(size_t size)
+{
+  std::vector<u8> buffer;
+  {
+    std::lock_guard lk(m_queue_lock);
+    if (!m_free_frame_buffers.empty())
+    {
+      buffer = std::move(m_free_frame_buffers.back());
+      m_free_frame_buffers.pop_back();
+    }
+  }
 
-  m_frame_dump_output_texture->Unmap();
+  buffer.resize(size);
+  return buffer;
 }
 
-void FrameDumper::FrameDumpThreadFunc()
+FrameDumper::Stats FrameDumper::GetStats() const
 {
-  Common::SetCurrentThreadName("FrameDumping");
+  std::lock_guard lk(m_queue_lock);
+  return m_stats;
+}
 
-  bool dump_to_ffmpeg = !Config::Get(Config::GFX_DUMP_FRAMES_AS_IMAGES);
-  bool frame_dump_started = false;
+void FrameDumper::ShutdownFrameDumping()
+{
+  // Ensure the queued readbacks have been sent to the encoder.
+  FlushFrameDump();
 
-// If Dolphin was compiled without ffmpeg, we only support dumping to images.
-#if !defined(HAVE_FFMPEG)
-  if (dump_to_ffmpeg)
+  if (m_frame_dump_thread_running.IsSet())
   {
-    WARN_LOG_FMT(VIDEO, "FrameDump: Dolphin was not compiled with FFmpeg, using fallback option. "
-                        "Frames will be saved as PNG images instead.");
-    dump_to_ffmpeg = false;
+    // Encode the remaining frames, and wait for the threads to exit. The PNG encoders are fed by
+    // the frame dump thread, so they must be stopped after it.
+    m_frame_dump_thread.Shutdown();
+    for (auto& thread : m_png_encode_threads)
+      thread->Shutdown();
+    m_png_encode_threads.clear();
+    m_next_png_encode_thread = 0;
+
+    if (m_frame_dump_started)
+    {
+      // No additional cleanup is needed when dumping to images.
+      if (m_dump_to_ffmpeg)
+        StopFrameDumpToFFMPEG();
+      m_frame_dump_started = false;
+    }
+    m_frame_dump_thread_running.Clear();
+
+    const Stats stats = GetStats();
+    INFO_LOG_FMT(VIDEO,
+                 "FrameDump: {} frames queued, {} dropped, {} stalls ({:.1f} ms), "
+                 "max queue depth {}",
+                 stats.frames_queued, stats.frames_dropped, stats.stalls,
+                 DT_ms(stats.stall_time).count(), stats.max_queue_depth);
   }
-#endif
 
-  while (true)
-  {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
+  m_frame_dump_render_framebuffer.reset();
+  m_frame_dump_render_texture.reset();
 
-    auto frame = m_frame_dump_data;
+  for (Readback& readback : m_readbacks)
+    readback.texture.reset();
 
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
-    {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
+  std::lock_guard lk(m_queue_lock);
+  m_free_frame_buffers.clear();
+}
 
-      if (DumpFrameToPNG(frame, m_screenshot_name))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+void FrameDumper::DumpQueuedFrame(QueuedFrame frame)
+{
+  const FrameData frame_data{frame.data.data(), frame.width, frame.height, frame.stride,
+                             frame.state};
 
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
-    }
+  // Save screenshot
+  if (!frame.screenshot_name.empty())
+  {
+    if (DumpFrameToPNG(frame_data, frame.screenshot_name))
+      OSD::AddMessage("Screenshot saved to " + frame.screenshot_name);
 
-    if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
+    m_screenshot_completed.Set();
+  }
+
+  // Whether to dump was decided when the frame was read back, so frames that were already queued
+  // when frame dumping got turned off are still written.
+  if (frame.dump_frame && !m_frame_dump_start_failed)
+  {
+    if (!m_frame_dump_started)
     {
-      if (!frame_dump_started)
+      if (m_dump_to_ffmpeg)
+        m_frame_dump_started = StartFrameDumpToFFMPEG(frame_data);
+      else
+        m_frame_dump_started = StartFrameDumpToImage(frame_data);
+
+      // Stop frame dumping if we fail to start, and don't retry for the frames already queued.
+      if (!m_frame_dump_started)
       {
-        if (dump_to_ffmpeg)
-          frame_dump_started = StartFrameDumpToFFMPEG(frame);
-        else
-          frame_dump_started = StartFrameDumpToImage(frame);
-
-        // Stop frame dumping if we fail to start.
-        if (!frame_dump_started)
-          Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+        m_frame_dump_start_failed = true;
+        Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
       }
+    }
 
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
+    // If we failed to start frame dumping, don't write a frame.
+    if (m_frame_dump_started)
+    {
+      if (!m_dump_to_ffmpeg)
       {
-        if (dump_to_ffmpeg)
-          DumpFrameToFFMPEG(frame);
-        else
-          DumpFrameToImage(frame);
+        // The PNG encoder threads release the frame once it has been saved.
+        DumpFrameToImage(std::move(frame));
+        return;
       }
-    }
 
-    m_frame_dump_done.Set();
+      DumpFrameToFFMPEG(frame_data);
+    }
   }
 
-  if (frame_dump_started)
-  {
-    // No additional cleanup is needed when dumping to images.
-    if (dump_to_ffmpeg)
-      StopFrameDumpToFFMPEG();
-  }
+  OnFrameEncoded(std::move(frame.data));
 }
 
 #if defined(HAVE_FFMPEG)
@@ -332,12 +426,32 @@ bool FrameDumper::StartFrameDumpToImage(const FrameData&)
   return true;
 }
 
-void FrameDumper::DumpFrameToImage(const FrameData& frame)
+void FrameDumper::DumpFrameToImage(QueuedFrame frame)
 {
-  DumpFrameToPNG(frame, GetFrameDumpNextImageFileName());
+  if (m_png_encode_threads.empty())
+  {
+    const u32 num_threads = GetNumPNGEncodeThreads();
+    for (u32 i = 0; i < num_threads; i++)
+    {
+      m_png_encode_threads.push_back(std::make_unique<Common::WorkQueueThread<PNGFrame>>(
+          "FrameDumpPNG", [this](PNGFrame png_frame) { EncodePNG(std::move(png_frame)); }));
+    }
+  }
+
+  PNGFrame png_frame{std::move(frame.data), frame.width, frame.height, frame.stride,
+                     GetFrameDumpNextImageFileName()};
+  m_png_encode_threads[m_next_png_encode_thread]->Push(std::move(png_frame));
+  m_next_png_encode_thread = (m_next_png_encode_thread + 1) % m_png_encode_threads.size();
   m_frame_dump_image_counter++;
 }
 
+void FrameDumper::EncodePNG(PNGFrame frame)
+{
+  const FrameData frame_data{frame.data.data(), frame.width, frame.height, frame.stride, {}};
+  DumpFrameToPNG(frame_data, frame.file_name);
+  OnFrameEncoded(std::move(frame.data));
+}
+
 void FrameDumper::SaveScreenshot(std::string filename)
 {
   std::lock_guard<std::mutex> lk(m_screenshot_lock);
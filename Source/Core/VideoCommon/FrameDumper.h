@@ -3,11 +3,19 @@
 
 #pragma once
 
+#include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
 #include "Common/Thread.h"
+#include "Common/WorkQueueThread.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
 #include "VideoCommon/VideoEvents.h"
@@ -19,13 +27,24 @@ class AbstractFramebuffer;
 class FrameDumper
 {
 public:
+  struct Stats
+  {
+    u64 frames_queued = 0;
+    // Frames that were rendered but never reached the encoder, e.g. because readback failed
+    u64 frames_dropped = 0;
+    // Times the video thread had to wait because the encoders fell behind
+    u64 stalls = 0;
+    DT stall_time{};
+    u32 max_queue_depth = 0;
+  };
+
   FrameDumper();
   ~FrameDumper();
 
   // Ensures all rendered frames are queued for encoding.
   void FlushFrameDump();
 
-  // Fills the frame dump staging texture with the current XFB texture.
+  // Copies the current XFB texture into the next free frame dump staging texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect,
                         const MathUtil::Rectangle<int>& target_rect, u64 ticks, int frame_number);
@@ -35,58 +54,104 @@ public:
   bool IsFrameDumping() const;
   int GetRequiredResolutionLeastCommonMultiple() const;
 
+  Stats GetStats() const;
+
   void DoState(PointerWrap& p);
 
 private:
+  // A frame read back from the GPU, waiting to be encoded
+  struct QueuedFrame
+  {
+    std::vector<u8> data;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+    FrameState state;
+    bool dump_frame = false;
+    std::string screenshot_name;
+  };
+
+  struct PNGFrame
+  {
+    std::vector<u8> data;
+    int width = 0;
+    int height = 0;
+    int stride = 0;
+    std::string file_name;
+  };
+
+  // A staging texture that a frame has been copied into. It is only mapped once the GPU has had
+  // a few more frames to finish the copy, so that dumping doesn't wait on the GPU every frame.
+  struct Readback
+  {
+    std::unique_ptr<AbstractStagingTexture> texture;
+    FrameState state;
+    bool dump_frame = false;
+    std::string screenshot_name;
+  };
+
+  static constexpr u32 NUM_READBACK_TEXTURES = 3;
+
   // NOTE: The methods below are called on the framedumping thread.
-  void FrameDumpThreadFunc();
+  void DumpQueuedFrame(QueuedFrame frame);
   bool StartFrameDumpToFFMPEG(const FrameData&);
   void DumpFrameToFFMPEG(const FrameData&);
   void StopFrameDumpToFFMPEG();
   std::string GetFrameDumpNextImageFileName() const;
   bool StartFrameDumpToImage(const FrameData&);
-  void DumpFrameToImage(const FrameData&);
+  void DumpFrameToImage(QueuedFrame frame);
+
+  // Called on the PNG encoder threads.
+  void EncodePNG(PNGFrame frame);
 
   void ShutdownFrameDumping();
 
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
+  // Checks that the given readback texture exists and is the correct size.
+  bool CheckFrameDumpReadbackTexture(Readback& readback, u32 target_width, u32 target_height);
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  // Maps the oldest readback texture and queues its frame for encoding.
+  void QueueOldestReadback();
 
-  // Ensures all encoded frames have been written to the output file.
-  void FinishFrameData();
+  // Blocks while too many frames are waiting to be encoded.
+  void WaitForQueueSpace();
+  void OnFrameEncoded(std::vector<u8> buffer);
 
-  std::thread m_frame_dump_thread;
-  Common::Flag m_frame_dump_thread_running;
+  std::vector<u8> AcquireFrameBuffer(size_t size);
 
-  // Used to kick frame dump thread.
-  Common::Event m_frame_dump_start;
+  // Encodes frames in order. Runs the FFmpeg encoder and saves screenshots itself, and hands
+  // images off to the PNG encoder threads.
+  Common::WorkQueueThread<QueuedFrame> m_frame_dump_thread;
+  Common::Flag m_frame_dump_thread_running;
 
-  // Set by frame dump thread on frame completion.
-  Common::Event m_frame_dump_done;
+  // PNG encoding is the bottleneck when dumping frames as images, and every image is encoded
+  // independently, so images are spread over several threads. The file names are assigned by
+  // m_frame_dump_thread, so the output stays in order.
+  std::vector<std::unique_ptr<Common::WorkQueueThread<PNGFrame>>> m_png_encode_threads;
+  size_t m_next_png_encode_thread = 0;
 
-  // Holds emulation state during the last swap when dumping.
-  FrameState m_last_frame_state;
+  // Only accessed from m_frame_dump_thread while it is running.
+  bool m_dump_to_ffmpeg = false;
+  bool m_frame_dump_started = false;
+  bool m_frame_dump_start_failed = false;
 
-  // Communication of frame between video and dump threads.
-  FrameData m_frame_dump_data;
+  // Frames that have been read back but not encoded yet, and their buffers once they are free.
+  mutable std::mutex m_queue_lock;
+  std::condition_variable m_frame_encoded;
+  u32 m_queue_depth = 0;
+  std::vector<std::vector<u8>> m_free_frame_buffers;
+  Stats m_stats;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
-  bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
+  // Ring of readback textures, oldest first starting at m_first_readback.
+  std::array<Readback, NUM_READBACK_TEXTURES> m_readbacks;
+  u32 m_first_readback = 0;
+  u32 m_num_pending_readbacks = 0;
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
@@ -3,8 +3,10 @@
 
 #include "VideoCommon/FramebufferManager.h"
 
+#include <array>
 #include <fmt/format.h>
 #include <memory>
+#include <xxhash.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
@@ -22,6 +24,7 @@
 #include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/Present.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -292,6 +295,7 @@ bool FramebufferManager::CreateEFBFramebuffer(int efb_scale)
   // Clear the renderable textures out.
   g_gfx->SetAndClearFramebuffer(m_efb_framebuffer.get(), {{0.0f, 0.0f, 0.0f, 0.0f}},
                                 g_backend_info.bSupportsReversedDepthRange ? 1.0f : 0.0f);
+  InvalidateEFBContentHash();
 
   // Pixel Shader uses EFB scale as a constant, dirty that in case it changed
   Core::System::GetInstance().GetPixelShaderManager().Dirty();
@@ -385,6 +389,8 @@ bool FramebufferManager::ReinterpretPixelData(EFBReinterpretType convtype)
   if (!m_format_conversion_pipelines[static_cast<u32>(convtype)])
     return false;
 
+  InvalidateEFBContentHash();
+
   // Draw to the secondary framebuffer.
   // We don't discard here because discarding the framebuffer also throws away the depth
   // buffer, which we want to preserve. If we find this to be hindering performance in the
@@ -481,17 +487,7 @@ u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
   if (g_backend_info.bUsesLowerLeftOrigin)
     y = EFB_HEIGHT - 1 - y;
 
-  u32 tile_index;
-  if (!IsEFBCacheTilePresent(false, x, y, &tile_index))
-    PopulateEFBCache(false, tile_index);
-
-  m_efb_color_cache.tiles[tile_index].frame_access_mask |= 1;
-
-  if (m_efb_color_cache.needs_flush)
-  {
-    m_efb_color_cache.readback_texture->Flush();
-    m_efb_color_cache.needs_flush = false;
-  }
+  AccessEFBCacheTile(false, x, y);
 
   u32 value;
   m_efb_color_cache.readback_texture->ReadTexel(x, y, &value);
@@ -504,21 +500,53 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
   if (g_backend_info.bUsesLowerLeftOrigin)
     y = EFB_HEIGHT - 1 - y;
 
+  AccessEFBCacheTile(true, x, y);
+
+  float value;
+  m_efb_depth_cache.readback_texture->ReadTexel(x, y, &value);
+  return value;
+}
+
+u32 FramebufferManager::AccessEFBCacheTile(bool depth, u32 x, u32 y)
+{
+  EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+
+  // Only a miss or a pending flush waits for the GPU, so hits aren't timed.
+  std::optional<TimePoint> stall_start;
+
   u32 tile_index;
-  if (!IsEFBCacheTilePresent(true, x, y, &tile_index))
-    PopulateEFBCache(true, tile_index);
+  if (!IsEFBCacheTilePresent(depth, x, y, &tile_index))
+  {
+    stall_start = Clock::now();
+    PopulateEFBCache(depth, tile_index);
+    INCSTAT(g_stats.this_frame.num_efb_peek_cache_misses);
 
-  m_efb_depth_cache.tiles[tile_index].frame_access_mask |= 1;
+    // Give tiles whose prefetches were all being wasted another chance.
+    EFBCacheTile& tile = data.tiles[tile_index];
+    tile.prefetch_confidence = std::max<u8>(tile.prefetch_confidence, 1);
+  }
 
-  if (m_efb_depth_cache.needs_flush)
+  EFBCacheTile& tile = data.tiles[tile_index];
+  tile.frame_access_mask |= 1;
+  if (tile.prefetched)
   {
-    m_efb_depth_cache.readback_texture->Flush();
-    m_efb_depth_cache.needs_flush = false;
+    tile.prefetched = false;
+    tile.prefetch_confidence =
+        std::min<u8>(tile.prefetch_confidence + 2, MAX_PREFETCH_CONFIDENCE);
+    INCSTAT(g_stats.this_frame.num_efb_peek_prefetch_hits);
   }
 
-  float value;
-  m_efb_depth_cache.readback_texture->ReadTexel(x, y, &value);
-  return value;
+  if (data.needs_flush)
+  {
+    if (!stall_start)
+      stall_start = Clock::now();
+    data.readback_texture->Flush();
+    data.needs_flush = false;
+  }
+
+  if (stall_start)
+    ADDSTAT(g_stats.this_frame.efb_peek_stall_ms, DT_ms(Clock::now() - *stall_start).count());
+  return tile_index;
 }
 
 void FramebufferManager::SetEFBCacheTileSize(u32 size)
@@ -541,17 +569,25 @@ void FramebufferManager::RefreshPeekCache()
     return;
   }
 
+  const auto should_prefetch = [](const EFBCacheTile& tile) {
+    return tile.frame_access_mask != 0 && tile.prefetch_confidence != 0 && !tile.present;
+  };
+
   bool flush_command_buffer = false;
   for (u32 i = 0; i < m_efb_color_cache.tiles.size(); i++)
   {
-    if (m_efb_color_cache.tiles[i].frame_access_mask != 0 && !m_efb_color_cache.tiles[i].present)
+    if (should_prefetch(m_efb_color_cache.tiles[i]))
     {
       PopulateEFBCache(false, i, true);
+      m_efb_color_cache.tiles[i].prefetched = true;
+      INCSTAT(g_stats.this_frame.num_efb_peek_prefetches);
       flush_command_buffer = true;
     }
-    if (m_efb_depth_cache.tiles[i].frame_access_mask != 0 && !m_efb_depth_cache.tiles[i].present)
+    if (should_prefetch(m_efb_depth_cache.tiles[i]))
     {
       PopulateEFBCache(true, i, true);
+      m_efb_depth_cache.tiles[i].prefetched = true;
+      INCSTAT(g_stats.this_frame.num_efb_peek_prefetches);
       flush_command_buffer = true;
     }
   }
@@ -568,35 +604,33 @@ void FramebufferManager::RefreshPeekCache()
 void FramebufferManager::InvalidatePeekCache(bool forced)
 {
   if (forced || m_efb_color_cache.out_of_date)
-  {
-    if (m_efb_color_cache.has_active_tiles)
-    {
-      for (u32 i = 0; i < m_efb_color_cache.tiles.size(); i++)
-      {
-        m_efb_color_cache.tiles[i].present = false;
-      }
-
-      m_efb_color_cache.needs_refresh = true;
-    }
-
-    m_efb_color_cache.has_active_tiles = false;
-    m_efb_color_cache.out_of_date = false;
-  }
+    InvalidateEFBCacheTiles(m_efb_color_cache);
   if (forced || m_efb_depth_cache.out_of_date)
+    InvalidateEFBCacheTiles(m_efb_depth_cache);
+}
+
+void FramebufferManager::InvalidateEFBCacheTiles(EFBCacheData& data)
+{
+  if (data.has_active_tiles)
   {
-    if (m_efb_depth_cache.has_active_tiles)
+    for (EFBCacheTile& tile : data.tiles)
     {
-      for (u32 i = 0; i < m_efb_depth_cache.tiles.size(); i++)
+      if (tile.prefetched)
       {
-        m_efb_depth_cache.tiles[i].present = false;
+        // Read back for nothing.
+        tile.prefetched = false;
+        if (tile.prefetch_confidence > 0)
+          tile.prefetch_confidence--;
+        INCSTAT(g_stats.this_frame.num_efb_peek_prefetches_wasted);
       }
-
-      m_efb_depth_cache.needs_refresh = true;
+      tile.present = false;
     }
 
-    m_efb_depth_cache.has_active_tiles = false;
-    m_efb_depth_cache.out_of_date = false;
+    data.needs_refresh = true;
   }
+
+  data.has_active_tiles = false;
+  data.out_of_date = false;
 }
 
 void FramebufferManager::FlagPeekCacheAsOutOfDate()
@@ -617,6 +651,11 @@ void FramebufferManager::EndOfFrame()
     m_efb_color_cache.tiles[i].frame_access_mask <<= 1;
     m_efb_depth_cache.tiles[i].frame_access_mask <<= 1;
   }
+
+  // The frame has been rendered, so start reading back the tiles the game is likely to peek at
+  // before it draws anything else.
+  InvalidatePeekCache(false);
+  RefreshPeekCache();
 }
 
 bool FramebufferManager::CompileReadbackPipelines()
@@ -763,9 +802,9 @@ bool FramebufferManager::CreateReadbackFramebuffer()
   }
 
   m_efb_color_cache.tiles.resize(total_tiles);
-  std::ranges::fill(m_efb_color_cache.tiles, EFBCacheTile{false, 0});
+  std::ranges::fill(m_efb_color_cache.tiles, EFBCacheTile{});
   m_efb_depth_cache.tiles.resize(total_tiles);
-  std::ranges::fill(m_efb_depth_cache.tiles, EFBCacheTile{false, 0});
+  std::ranges::fill(m_efb_depth_cache.tiles, EFBCacheTile{});
 
   return true;
 }
@@ -880,6 +919,44 @@ void FramebufferManager::ClearEFB(const MathUtil::Rectangle<int>& rc, bool color
   }
 
   g_gfx->ClearRegion(target_rc, color_enable, alpha_enable, z_enable, color, z);
+
+  struct
+  {
+    s32 rc[4];
+    u32 enable_mask;
+    u32 color;
+    u32 z;
+    u32 pixel_format;
+  } clear = {{rc.left, rc.top, rc.right, rc.bottom},
+             (color_enable ? 1u : 0u) | (alpha_enable ? 2u : 0u) | (z_enable ? 4u : 0u),
+             color,
+             z,
+             static_cast<u32>(pixel_format)};
+
+  // Nothing drawn before a full clear is visible afterwards.
+  const bool full_clear = color_enable && alpha_enable && z_enable && rc.left <= 0 &&
+                          rc.top <= 0 && rc.right >= static_cast<int>(EFB_WIDTH) &&
+                          rc.bottom >= static_cast<int>(EFB_HEIGHT);
+  if (full_clear)
+  {
+    clear.rc[0] = clear.rc[1] = clear.rc[2] = clear.rc[3] = 0;
+    m_efb_content_hash = XXH3_64bits(&clear, sizeof(clear));
+  }
+  else
+  {
+    m_efb_content_hash = XXH3_64bits_withSeed(&clear, sizeof(clear), m_efb_content_hash);
+  }
+}
+
+void FramebufferManager::AddDrawToEFBContentHash(u64 draw_hash)
+{
+  m_efb_content_hash = XXH3_64bits_withSeed(&draw_hash, sizeof(draw_hash), m_efb_content_hash);
+}
+
+void FramebufferManager::InvalidateEFBContentHash()
+{
+  const std::array<u64, 2> invalidation = {m_efb_content_hash, ++m_efb_content_invalidation_count};
+  m_efb_content_hash = XXH3_64bits(invalidation.data(), sizeof(invalidation));
 }
 
 bool FramebufferManager::CompileClearPipelines()
@@ -944,6 +1021,8 @@ AbstractPipeline* FramebufferManager::GetClearPipeline(bool colorEnable, bool al
 
 void FramebufferManager::PokeEFBColor(u32 x, u32 y, u32 color)
 {
+  InvalidateEFBContentHash();
+
   // Flush if we exceeded the number of vertices per batch.
   if ((m_color_poke_vertices.size() + 6) > MAX_POKE_VERTICES)
     FlushEFBPokes();
@@ -962,6 +1041,8 @@ void FramebufferManager::PokeEFBColor(u32 x, u32 y, u32 color)
 
 void FramebufferManager::PokeEFBDepth(u32 x, u32 y, float depth)
 {
+  InvalidateEFBContentHash();
+
   // Flush if we exceeded the number of vertices per batch.
   if ((m_depth_poke_vertices.size() + 6) > MAX_POKE_VERTICES)
     FlushEFBPokes();
@@ -1138,6 +1219,7 @@ void FramebufferManager::DoLoadState(PointerWrap& p)
 {
   // Invalidate any peek cache tiles.
   InvalidatePeekCache(true);
+  InvalidateEFBContentHash();
 
   // Deserialize the color and depth textures. This could fail.
   auto color_tex = g_texture_cache->DeserializeTexture(p);
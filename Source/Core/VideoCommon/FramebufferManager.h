@@ -128,6 +128,14 @@ public:
   void PokeEFBDepth(u32 x, u32 y, float depth);
   void FlushEFBPokes();
 
+  // Identifies the current EFB contents, for EFB copy deduplication. Draws are only hashed when
+  // deduplication is enabled. The hash is reset by full clears, so a frame which renders the same
+  // way as the last one ends up with the same hash.
+  u64 GetEFBContentHash() const { return m_efb_content_hash; }
+  void AddDrawToEFBContentHash(u64 draw_hash);
+  // Ensures no later EFB contents can match the current hash, for changes that can't be hashed.
+  void InvalidateEFBContentHash();
+
   // Save state load/save.
   void DoState(PointerWrap& p);
 
@@ -139,10 +147,19 @@ protected:
   };
   static_assert(std::is_standard_layout<EFBPokeVertex>::value, "EFBPokeVertex is standard-layout");
 
+  // Tiles that were accessed in recent frames are read back ahead of time, at synchronization
+  // points and at the end of each frame. A tile's confidence drops when its prefetched contents
+  // are thrown away without being read, and rises when they are used, so tiles which are only
+  // read at some points in the frame stop being prefetched at every other point.
+  static constexpr u8 MAX_PREFETCH_CONFIDENCE = 8;
+
   struct EFBCacheTile
   {
-    bool present;
-    u8 frame_access_mask;
+    bool present = false;
+    // Set when the tile was read back ahead of time and hasn't been peeked since.
+    bool prefetched = false;
+    u8 frame_access_mask = 0;
+    u8 prefetch_confidence = MAX_PREFETCH_CONFIDENCE;
   };
 
   // EFB cache - for CPU EFB access
@@ -182,6 +199,9 @@ protected:
   bool IsEFBCacheTilePresent(bool depth, u32 x, u32 y, u32* tile_index) const;
   MathUtil::Rectangle<int> GetEFBCacheTileRect(u32 tile_index) const;
   void PopulateEFBCache(bool depth, u32 tile_index, bool async = false);
+  // Ensures the tile containing (x, y) has been read back, and returns its index.
+  u32 AccessEFBCacheTile(bool depth, u32 x, u32 y);
+  void InvalidateEFBCacheTiles(EFBCacheData& data);
 
   void CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x, u32 y, float z,
                           u32 color);
@@ -227,6 +247,9 @@ protected:
   EFBCacheData m_efb_color_cache = {};
   EFBCacheData m_efb_depth_cache = {};
 
+  u64 m_efb_content_hash = 0;
+  u64 m_efb_content_invalidation_count = 0;
+
   // EFB clear pipelines
   // Indexed by [color_write_enabled][alpha_write_enabled][depth_write_enabled]
   std::array<std::array<std::array<std::unique_ptr<AbstractPipeline>, 2>, 2>, 2> m_clear_pipelines;
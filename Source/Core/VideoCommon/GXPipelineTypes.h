@@ -77,6 +77,12 @@ struct SerializedGXPipelineUid
   u32 rasterization_state_bits = 0;
   u32 depth_state_bits = 0;
   u32 blending_state_bits = 0;
+
+  // The structure is packed, so there are no padding bytes to take into account.
+  bool operator<(const SerializedGXPipelineUid& rhs) const
+  {
+    return std::memcmp(this, &rhs, sizeof(*this)) < 0;
+  }
 };
 struct SerializedGXUberPipelineUid
 {
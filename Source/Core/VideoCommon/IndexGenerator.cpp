@@ -3,9 +3,18 @@
 
 #include "VideoCommon/IndexGenerator.h"
 
+#include <array>
+#include <cstddef>
 #include <cstring>
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 #include "Common/CommonTypes.h"
+#include "Common/Inline.h"
 #include "Common/Logging/Log.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/VideoConfig.h"
@@ -14,6 +23,124 @@ namespace
 {
 constexpr u16 s_primitive_restart = UINT16_MAX;
 
+// Most primitive types produce a repeating sequence of indices, which we write a whole
+// repetition at a time using 8-wide vector stores. Each lane of a pattern is either an offset from
+// the first vertex of the repetition, the centre vertex of a fan, or a primitive restart index.
+constexpr int CENTER = -1;
+constexpr int RESTART = -2;
+
+template <size_t N>
+struct IndexPattern
+{
+  static_assert(N % 8 == 0, "Patterns must fill whole vectors");
+
+  std::array<u16, N> offsets{};
+  std::array<u16, N> vertex_mask{};
+  std::array<u16, N> center_mask{};
+};
+
+template <size_t N>
+constexpr IndexPattern<N> MakePattern(const std::array<int, N>& lanes)
+{
+  IndexPattern<N> pattern;
+  for (size_t i = 0; i < N; ++i)
+  {
+    if (lanes[i] == RESTART)
+    {
+      pattern.offsets[i] = s_primitive_restart;
+    }
+    else if (lanes[i] == CENTER)
+    {
+      pattern.center_mask[i] = UINT16_MAX;
+    }
+    else
+    {
+      pattern.offsets[i] = static_cast<u16>(lanes[i]);
+      pattern.vertex_mask[i] = UINT16_MAX;
+    }
+  }
+  return pattern;
+}
+
+template <size_t N>
+DOLPHIN_FORCE_INLINE u16* WritePattern(u16* index_ptr, const IndexPattern<N>& pattern, u32 first,
+                                       u32 center = 0)
+{
+#if defined(_M_X86_64)
+  const __m128i first_vec = _mm_set1_epi16(static_cast<s16>(first));
+  const __m128i center_vec = _mm_set1_epi16(static_cast<s16>(center));
+  for (size_t i = 0; i < N; i += 8)
+  {
+    const auto load = [i](const std::array<u16, N>& lanes) {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes.data() + i));
+    };
+    const __m128i vertices = _mm_and_si128(first_vec, load(pattern.vertex_mask));
+    const __m128i centers = _mm_and_si128(center_vec, load(pattern.center_mask));
+    const __m128i indices = _mm_add_epi16(_mm_or_si128(vertices, centers), load(pattern.offsets));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(index_ptr + i), indices);
+  }
+#elif defined(_M_ARM_64)
+  const uint16x8_t first_vec = vdupq_n_u16(static_cast<u16>(first));
+  const uint16x8_t center_vec = vdupq_n_u16(static_cast<u16>(center));
+  for (size_t i = 0; i < N; i += 8)
+  {
+    const uint16x8_t vertices = vandq_u16(first_vec, vld1q_u16(pattern.vertex_mask.data() + i));
+    const uint16x8_t centers = vandq_u16(center_vec, vld1q_u16(pattern.center_mask.data() + i));
+    const uint16x8_t indices =
+        vaddq_u16(vorrq_u16(vertices, centers), vld1q_u16(pattern.offsets.data() + i));
+    vst1q_u16(index_ptr + i, indices);
+  }
+#else
+  for (size_t i = 0; i < N; ++i)
+  {
+    index_ptr[i] = static_cast<u16>(((first & pattern.vertex_mask[i]) |
+                                     (center & pattern.center_mask[i])) +
+                                    pattern.offsets[i]);
+  }
+#endif
+  return index_ptr + N;
+}
+
+// clang-format off
+constexpr auto s_sequential_8 = MakePattern(std::to_array({0, 1, 2, 3, 4, 5, 6, 7}));
+constexpr auto s_sequential_24 = MakePattern(std::to_array({
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11,
+   12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23}));
+
+// 2 triangles
+constexpr auto s_list_pr = MakePattern(std::to_array({0, 1, 2, RESTART, 3, 4, 5, RESTART}));
+
+// 8 triangles, alternating winding
+constexpr auto s_strip = MakePattern(std::to_array({
+    0, 1, 2,  1, 3, 2,  2, 3, 4,  3, 5, 4,
+    4, 5, 6,  5, 7, 6,  6, 7, 8,  7, 9, 8}));
+
+// 4 groups of 3 triangles
+constexpr auto s_fan_pr = MakePattern(std::to_array({
+    0, 1, CENTER, 2,  3, RESTART,  3,  4, CENTER,  5,  6, RESTART,
+    6, 7, CENTER, 8,  9, RESTART,  9, 10, CENTER, 11, 12, RESTART}));
+
+// 8 triangles
+constexpr auto s_fan = MakePattern(std::to_array({
+    CENTER, 0, 1,  CENTER, 1, 2,  CENTER, 2, 3,  CENTER, 3, 4,
+    CENTER, 4, 5,  CENTER, 5, 6,  CENTER, 6, 7,  CENTER, 7, 8}));
+
+// 8 quads
+constexpr auto s_quads_pr = MakePattern(std::to_array({
+     1,  2,  0,  3, RESTART,   5,  6,  4,  7, RESTART,
+     9, 10,  8, 11, RESTART,  13, 14, 12, 15, RESTART,
+    17, 18, 16, 19, RESTART,  21, 22, 20, 23, RESTART,
+    25, 26, 24, 27, RESTART,  29, 30, 28, 31, RESTART}));
+
+// 4 quads
+constexpr auto s_quads = MakePattern(std::to_array({
+     0,  1,  2,   0,  2,  3,   4,  5,  6,   4,  6,  7,
+     8,  9, 10,   8, 10, 11,  12, 13, 14,  12, 14, 15}));
+
+// 4 lines
+constexpr auto s_line_strip = MakePattern(std::to_array({0, 1, 1, 2, 2, 3, 3, 4}));
+// clang-format on
+
 template <bool pr>
 u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 {
@@ -28,7 +155,19 @@ u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 template <bool pr>
 u16* AddList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 2; i < num_verts; i += 3)
+  u32 i = 2;
+  if constexpr (pr)
+  {
+    for (; i + 4 <= num_verts; i += 6)
+      index_ptr = WritePattern(index_ptr, s_list_pr, index + i - 2);
+  }
+  else
+  {
+    for (; i + 22 <= num_verts; i += 24)
+      index_ptr = WritePattern(index_ptr, s_sequential_24, index + i - 2);
+  }
+
+  for (; i < num_verts; i += 3)
   {
     index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - 1, index + i);
   }
@@ -40,7 +179,10 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
   if constexpr (pr)
   {
-    for (u32 i = 0; i < num_verts; ++i)
+    u32 i = 0;
+    for (; i + 8 <= num_verts; i += 8)
+      index_ptr = WritePattern(index_ptr, s_sequential_8, index + i);
+    for (; i < num_verts; ++i)
     {
       *index_ptr++ = index + i;
     }
@@ -48,8 +190,13 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
   }
   else
   {
+    // Each repetition of the pattern is an even number of triangles, so the winding is unchanged.
+    u32 i = 2;
+    for (; i + 8 <= num_verts; i += 8)
+      index_ptr = WritePattern(index_ptr, s_strip, index + i - 2);
+
     bool wind = false;
-    for (u32 i = 2; i < num_verts; ++i)
+    for (; i < num_verts; ++i)
     {
       index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - !wind, index + i - wind);
 
@@ -85,6 +232,9 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
 
   if constexpr (pr)
   {
+    for (; i + 12 <= num_verts; i += 12)
+      index_ptr = WritePattern(index_ptr, s_fan_pr, index + i - 1, index);
+
     for (; i + 3 <= num_verts; i += 3)
     {
       *index_ptr++ = index + i - 1;
@@ -104,6 +254,11 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
       *index_ptr++ = s_primitive_restart;
     }
   }
+  else
+  {
+    for (; i + 8 <= num_verts; i += 8)
+      index_ptr = WritePattern(index_ptr, s_fan, index + i - 1, index);
+  }
 
   for (; i < num_verts; ++i)
   {
@@ -133,6 +288,17 @@ template <bool pr>
 u16* AddQuads(u16* index_ptr, u32 num_verts, u32 index)
 {
   u32 i = 3;
+  if constexpr (pr)
+  {
+    for (; i + 29 <= num_verts; i += 32)
+      index_ptr = WritePattern(index_ptr, s_quads_pr, index + i - 3);
+  }
+  else
+  {
+    for (; i + 13 <= num_verts; i += 16)
+      index_ptr = WritePattern(index_ptr, s_quads, index + i - 3);
+  }
+
   for (; i < num_verts; i += 4)
   {
     if constexpr (pr)
@@ -168,7 +334,11 @@ u16* AddQuads_nonstandard(u16* index_ptr, u32 num_verts, u32 index)
 
 u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; i += 2)
+  u32 i = 1;
+  for (; i + 7 <= num_verts; i += 8)
+    index_ptr = WritePattern(index_ptr, s_sequential_8, index + i - 1);
+
+  for (; i < num_verts; i += 2)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -180,7 +350,11 @@ u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 // so converting them to lists
 u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; ++i)
+  u32 i = 1;
+  for (; i + 4 <= num_verts; i += 4)
+    index_ptr = WritePattern(index_ptr, s_line_strip, index + i - 1);
+
+  for (; i < num_verts; ++i)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -223,7 +397,11 @@ u16* AddLines_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
 
 u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 0; i != num_verts; ++i)
+  u32 i = 0;
+  for (; i + 8 <= num_verts; i += 8)
+    index_ptr = WritePattern(index_ptr, s_sequential_8, index + i);
+
+  for (; i != num_verts; ++i)
   {
     *index_ptr++ = index + i;
   }
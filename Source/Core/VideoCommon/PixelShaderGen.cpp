@@ -3,6 +3,8 @@
 
 #include "VideoCommon/PixelShaderGen.h"
 
+#include <cmath>
+
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
@@ -319,8 +321,77 @@ void ClearUnusedPixelShaderUidBits(APIType api_type, const ShaderHostConfig& hos
   uid_data->bounding_box &= host_config.bounding_box && host_config.backend_bbox;
 }
 
+std::optional<PixelShaderSpecialization>
+GetPixelShaderSpecialization(const pixel_shader_uid_data* uid_data,
+                             const PixelShaderConstants& constants)
+{
+  PixelShaderSpecialization specialization{};
+
+  // Konst colors are only read by stages that select one of them.
+  const u32 num_stages = uid_data->genMode_numtevstages + 1;
+  for (u32 i = 0; i < num_stages; i++)
+  {
+    if (u32(uid_data->stagehash[i].tevksel_kc) > 7 || u32(uid_data->stagehash[i].tevksel_ka) > 7)
+    {
+      specialization.kcolors = constants.kcolors;
+      break;
+    }
+  }
+
+  const bool alpha_test = uid_data->Pretest == AlphaTestResult::Undetermined ||
+                          (uid_data->Pretest == AlphaTestResult::Fail &&
+                           uid_data->ztest == EmulatedZ::Late);
+  if (alpha_test || uid_data->useDstAlpha)
+    specialization.alpha = constants.alpha;
+
+  if (uid_data->fog_fsel != FogType::Off)
+  {
+    specialization.fogcolor = constants.fogcolor;
+    specialization.fogi = constants.fogi;
+    specialization.fogf = constants.fogf;
+    specialization.fogrange = constants.fogrange;
+
+    // There are no literals for infinities or NaNs.
+    for (const float4& values : {specialization.fogf, specialization.fogrange[0],
+                                 specialization.fogrange[1], specialization.fogrange[2]})
+    {
+      for (const float value : values)
+      {
+        if (!std::isfinite(value))
+          return std::nullopt;
+      }
+    }
+  }
+
+  return specialization;
+}
+
+static void WriteFoldedConstants(ShaderCode& out, const PixelShaderSpecialization& specialization)
+{
+  const auto int4_literal = [](const int4& v) {
+    return fmt::format("int4({}, {}, {}, {})", v[0], v[1], v[2], v[3]);
+  };
+  // Nine significant digits are enough to represent every float exactly.
+  const auto float4_literal = [](const float4& v) {
+    return fmt::format("float4({:.8e}, {:.8e}, {:.8e}, {:.8e})", v[0], v[1], v[2], v[3]);
+  };
+
+  out.Write("// Uniforms folded into this shader\n");
+  out.Write("const int4 " I_KCOLORS "[4] = int4[4]({}, {}, {}, {});\n",
+            int4_literal(specialization.kcolors[0]), int4_literal(specialization.kcolors[1]),
+            int4_literal(specialization.kcolors[2]), int4_literal(specialization.kcolors[3]));
+  out.Write("const int4 " I_ALPHA " = {};\n", int4_literal(specialization.alpha));
+  out.Write("const int4 " I_FOGCOLOR " = {};\n", int4_literal(specialization.fogcolor));
+  out.Write("const int4 " I_FOGI " = {};\n", int4_literal(specialization.fogi));
+  out.Write("const float4 " I_FOGF " = {};\n", float4_literal(specialization.fogf));
+  out.Write("const float4 " I_FOGRANGE "[3] = float4[3]({}, {}, {});\n\n",
+            float4_literal(specialization.fogrange[0]), float4_literal(specialization.fogrange[1]),
+            float4_literal(specialization.fogrange[2]));
+}
+
 void WritePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
-                                  const ShaderHostConfig& host_config, bool bounding_box)
+                                  const ShaderHostConfig& host_config, bool bounding_box,
+                                  bool folded_constants)
 {
   // dot product for integer vectors
   out.Write("int idot(int3 x, int3 y)\n"
@@ -346,17 +417,19 @@ void WritePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
 
   out.Write("UBO_BINDING(std140, 1) uniform PSBlock {{\n");
 
+  // Folded uniforms are replaced by constants of the same name, so the block members are renamed.
+  const std::string_view folded_prefix = folded_constants ? "folded_" : "";
   out.Write("\tint4 " I_COLORS "[4];\n"
-            "\tint4 " I_KCOLORS "[4];\n"
-            "\tint4 " I_ALPHA ";\n"
+            "\tint4 {0}" I_KCOLORS "[4];\n"
+            "\tint4 {0}" I_ALPHA ";\n"
             "\tint4 " I_TEXDIMS "[8];\n"
             "\tint4 " I_ZBIAS "[2];\n"
             "\tint4 " I_INDTEXSCALE "[2];\n"
             "\tint4 " I_INDTEXMTX "[6];\n"
-            "\tint4 " I_FOGCOLOR ";\n"
-            "\tint4 " I_FOGI ";\n"
-            "\tfloat4 " I_FOGF ";\n"
-            "\tfloat4 " I_FOGRANGE "[3];\n"
+            "\tint4 {0}" I_FOGCOLOR ";\n"
+            "\tint4 {0}" I_FOGI ";\n"
+            "\tfloat4 {0}" I_FOGF ";\n"
+            "\tfloat4 {0}" I_FOGRANGE "[3];\n"
             "\tfloat4 " I_ZSLOPE ";\n"
             "\tfloat2 " I_EFBSCALE ";\n"
             "\tuint  bpmem_genmode;\n"
@@ -382,7 +455,8 @@ void WritePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
             "\tbool  logic_op_enable;\n"
             "\tuint  logic_op_mode;\n"
             "\tuint  time_ms;\n"
-            "}};\n\n");
+            "}};\n\n",
+            folded_prefix);
   out.Write("#define bpmem_combiners(i) (bpmem_pack1[(i)].xy)\n"
             "#define bpmem_tevind(i) (bpmem_pack1[(i)].z)\n"
             "#define bpmem_iref(i) (bpmem_pack1[(i)].w)\n"
@@ -747,7 +821,8 @@ static void WriteFragmentDefinitions(APIType api_type, const ShaderHostConfig& h
 
 ShaderCode GeneratePixelShaderCode(APIType api_type, const ShaderHostConfig& host_config,
                                    const pixel_shader_uid_data* uid_data,
-                                   CustomPixelContents custom_contents)
+                                   CustomPixelContents custom_contents,
+                                   const PixelShaderSpecialization* specialization)
 {
   ShaderCode out;
 
@@ -764,7 +839,10 @@ ShaderCode GeneratePixelShaderCode(APIType api_type, const ShaderHostConfig& hos
   // Stuff that is shared between ubershaders and pixelgen.
   WriteBitfieldExtractHeader(out, api_type, host_config);
 
-  WritePixelShaderCommonHeader(out, api_type, host_config, uid_data->bounding_box);
+  WritePixelShaderCommonHeader(out, api_type, host_config, uid_data->bounding_box,
+                               specialization != nullptr);
+  if (specialization)
+    WriteFoldedConstants(out, *specialization);
 
   out.Write("\n#define sampleTextureWrapper(texmap, uv, layer) "
             "sampleTexture(texmap, samp[texmap], uv, layer)\n");
@@ -3,7 +3,12 @@
 
 #pragma once
 
+#include <array>
+#include <cstring>
+#include <optional>
+
 #include "Common/CommonTypes.h"
+#include "VideoCommon/ConstantManager.h"
 #include "VideoCommon/LightingShaderGen.h"
 #include "VideoCommon/ShaderGenCommon.h"
 
@@ -164,11 +169,36 @@ struct CustomPixelContents
   std::string_view uniforms = "";
 };
 
+// Pixel shader constants that can be folded into a specialized shader. These are often the same
+// for whole scenes. Values that the shader doesn't read are zeroed, so that they don't cause
+// additional variants.
+struct PixelShaderSpecialization
+{
+  std::array<int4, 4> kcolors;
+  int4 alpha;
+  int4 fogcolor;
+  int4 fogi;
+  float4 fogf;
+  std::array<float4, 3> fogrange;
+
+  bool operator<(const PixelShaderSpecialization& other) const
+  {
+    return std::memcmp(this, &other, sizeof(*this)) < 0;
+  }
+};
+
+// Returns an empty optional if the constants can't be written as shader literals.
+std::optional<PixelShaderSpecialization>
+GetPixelShaderSpecialization(const pixel_shader_uid_data* uid_data,
+                             const PixelShaderConstants& constants);
+
 ShaderCode GeneratePixelShaderCode(APIType api_type, const ShaderHostConfig& host_config,
                                    const pixel_shader_uid_data* uid_data,
-                                   CustomPixelContents custom_contents);
+                                   CustomPixelContents custom_contents,
+                                   const PixelShaderSpecialization* specialization = nullptr);
 void WritePixelShaderCommonHeader(ShaderCode& out, APIType api_type,
-                                  const ShaderHostConfig& host_config, bool bounding_box);
+                                  const ShaderHostConfig& host_config, bool bounding_box,
+                                  bool folded_constants = false);
 void WriteFragmentBody(APIType api_type, const ShaderHostConfig& host_config,
                        const pixel_shader_uid_data* uid_data, ShaderCode& out);
 void ClearUnusedPixelShaderUidBits(APIType api_type, const ShaderHostConfig& host_config,
@@ -3,11 +3,20 @@
 
 #include "VideoCommon/ShaderCache.h"
 
+#include <cstring>
+#include <set>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include <fmt/format.h>
 
 #include "Common/Assert.h"
+#include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
 #include "Core/ConfigManager.h"
 
 #include "VideoCommon/AbstractGfx.h"
@@ -29,6 +38,103 @@ std::unique_ptr<VideoCommon::ShaderCache> g_shader_cache;
 
 namespace VideoCommon
 {
+namespace
+{
+constexpr u32 UID_CACHE_FILE_MAGIC = 0x44495550;  // PUID
+constexpr size_t UID_CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
+
+// Cache types used for the cross-game store. These files do not include the game ID in their
+// name, and are shared by every game using the same API and host config.
+constexpr const char* SHARED_VS_CACHE_TYPE = "shared-vs";
+constexpr const char* SHARED_PS_CACHE_TYPE = "shared-ps";
+constexpr const char* SHARED_PIPELINE_CACHE_TYPE = "shared-pipeline";
+
+// Orders keys by their raw bytes. Disk keys are always zero-padded before being written, so this
+// is equivalent to comparing the keys as they were appended to the cache.
+template <typename K>
+struct RawKeyLess
+{
+  bool operator()(const K& lhs, const K& rhs) const
+  {
+    return std::memcmp(&lhs, &rhs, sizeof(K)) < 0;
+  }
+};
+
+template <typename K>
+using RawKeySet = std::set<K, RawKeyLess<K>>;
+
+struct SharedCacheReferences
+{
+  RawKeySet<VertexShaderUid> vs_uids;
+  RawKeySet<PixelShaderUid> ps_uids;
+  RawKeySet<SerializedGXPipelineUid> pipeline_uids;
+};
+
+template <typename K>
+class CacheEntryCollector final : public Common::LinearDiskCacheReader<K, u8>
+{
+public:
+  void Read(const K& key, const u8* value, u32 value_size) override
+  {
+    entries.emplace_back(key, std::vector<u8>(value, value + value_size));
+  }
+
+  std::vector<std::pair<K, std::vector<u8>>> entries;
+};
+
+// Returns true if the cross-game cache file holds a usable copy of the entry already.
+template <typename Map, typename K>
+bool HasUsableStoredEntry(const Map& stored_entries, const K& key)
+{
+  const auto it = stored_entries.find(key);
+  return it != stored_entries.end() && it->second.usable;
+}
+
+void CountCreatedShader(ShaderStage stage)
+{
+  switch (stage)
+  {
+  case ShaderStage::Vertex:
+    INCSTAT(g_stats.num_vertex_shaders_created);
+    INCSTAT(g_stats.num_vertex_shaders_alive);
+    break;
+  case ShaderStage::Pixel:
+    INCSTAT(g_stats.num_pixel_shaders_created);
+    INCSTAT(g_stats.num_pixel_shaders_alive);
+    break;
+  default:
+    break;
+  }
+}
+
+// Adds the entries which the given pipeline UID cache refers to. Returns false if the file
+// couldn't be read, in which case it's unknown which entries the game needs.
+bool ReadSharedCacheReferences(const std::string& filename, SharedCacheReferences* references)
+{
+  File::IOFile file(filename, "rb");
+  if (!file)
+    return false;
+
+  u32 magic;
+  u32 version;
+  if (!file.ReadBytes(&magic, sizeof(magic)) || !file.ReadBytes(&version, sizeof(version)) ||
+      magic != UID_CACHE_FILE_MAGIC || version != GX_PIPELINE_UID_VERSION)
+  {
+    WARN_LOG_FMT(VIDEO, "Outdated or invalid UID cache '{}'", filename);
+    return false;
+  }
+
+  SerializedGXPipelineUid uid;
+  while (file.ReadBytes(&uid, sizeof(uid)))
+  {
+    references->vs_uids.insert(uid.vs_uid);
+    references->ps_uids.insert(uid.ps_uid);
+    references->pipeline_uids.insert(uid);
+  }
+  return true;
+}
+}  // namespace
+
 ShaderCache::ShaderCache() : m_api_type{APIType::Nothing}
 {
 }
@@ -47,8 +153,11 @@ bool ShaderCache::Initialize()
     return false;
 
   m_async_shader_compiler = g_gfx->CreateAsyncShaderCompiler();
-  m_frame_end_handler = GetVideoEvents().after_frame_event.Register(
-      [this](Core::System&) { RetrieveAsyncShaders(); });
+  m_frame_end_handler =
+      GetVideoEvents().after_frame_event.Register([this](Core::System&) {
+        RetrieveAsyncShaders();
+        PruneSpecializationCandidates();
+      });
   return true;
 }
 
@@ -128,7 +237,17 @@ const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
-    pipeline = g_gfx->CreatePipeline(*pipeline_config);
+  {
+    const std::vector<u8> stored_data = ReadStoredGXPipelineData(uid);
+    if (!stored_data.empty())
+    {
+      pipeline = g_gfx->CreatePipeline(*pipeline_config, stored_data.data(), stored_data.size());
+      if (!pipeline)
+        DiscardStoredGXPipelineData(uid);
+    }
+    if (!pipeline)
+      pipeline = g_gfx->CreatePipeline(*pipeline_config);
+  }
   if (g_ActiveConfig.bShaderCache && !exists_in_cache)
     AppendGXPipelineUID(uid);
   return InsertGXPipeline(uid, std::move(pipeline));
@@ -151,6 +270,41 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
   return {};
 }
 
+const AbstractPipeline* ShaderCache::GetSpecializedPipeline(const GXPipelineUid& uid,
+                                                            const PixelShaderConstants& constants)
+{
+  // Compiling these on the GPU thread would defeat the purpose.
+  if (!m_async_shader_compiler->HasWorkerThreads())
+    return nullptr;
+
+  const std::optional<PixelShaderSpecialization> specialization =
+      GetPixelShaderSpecialization(uid.ps_uid.GetUidData(), constants);
+  if (!specialization)
+    return nullptr;
+
+  const SpecializedPipelineKey key{uid, *specialization};
+  SpecializedPipeline& entry = m_specialized_pipelines[key];
+  if (entry.queued)
+    return entry.pending ? nullptr : entry.pipeline.get();
+
+  if (++entry.draws >= SPECIALIZATION_DRAW_THRESHOLD &&
+      m_num_specialized_pipelines_queued < MAX_SPECIALIZED_PIPELINES)
+  {
+    QueueSpecializedPipelineCompile(key);
+  }
+
+  return nullptr;
+}
+
+void ShaderCache::PruneSpecializationCandidates()
+{
+  if (++m_frames_since_specialization_prune < SPECIALIZATION_WINDOW_FRAMES)
+    return;
+
+  m_frames_since_specialization_prune = 0;
+  std::erase_if(m_specialized_pipelines, [](const auto& it) { return !it.second.queued; });
+}
+
 const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineUid& uid)
 {
   auto it = m_gx_uber_pipeline_cache.find(uid);
@@ -230,43 +384,50 @@ static void UnserializePipelineUid(const SerializedUidType& uid, UidType& real_u
 }
 
 template <ShaderStage stage, typename K, typename T>
-void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid)
+void ShaderCache::LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid,
+                                  const std::function<bool(const K&)>& is_referenced)
 {
   class CacheReader : public Common::LinearDiskCacheReader<K, u8>
   {
   public:
-    CacheReader(T& cache_) : cache(cache_) {}
+    CacheReader(T& cache_, const std::function<bool(const K&)>& is_referenced_)
+        : cache(cache_), is_referenced(is_referenced_)
+    {
+    }
+    void ReadAt(const K& key, const u8* value, u32 value_size, u64 value_offset) override
+    {
+      // Remember where every entry of a cross-game cache is, so the shaders that aren't created
+      // now can be found by their UID when a game needs them. Later entries replace earlier ones.
+      if (is_referenced)
+        cache.stored_entries.insert_or_assign(key, StoredCacheEntry{value_offset, value_size});
+      Read(key, value, value_size);
+    }
     void Read(const K& key, const u8* value, u32 value_size) override
     {
+      if (is_referenced && !is_referenced(key))
+        return;
+
       auto shader = g_gfx->CreateShaderFromBinary(stage, value, value_size);
       if (shader)
       {
         auto& entry = cache.shader_map[key];
         entry.shader = std::move(shader);
         entry.pending = false;
-
-        switch (stage)
-        {
-        case ShaderStage::Vertex:
-          INCSTAT(g_stats.num_vertex_shaders_created);
-          INCSTAT(g_stats.num_vertex_shaders_alive);
-          break;
-        case ShaderStage::Pixel:
-          INCSTAT(g_stats.num_pixel_shaders_created);
-          INCSTAT(g_stats.num_pixel_shaders_alive);
-          break;
-        default:
-          break;
-        }
+        CountCreatedShader(stage);
+      }
+      else if (is_referenced)
+      {
+        cache.stored_entries[key].usable = false;
       }
     }
 
   private:
     T& cache;
+    const std::function<bool(const K&)>& is_referenced;
   };
 
   std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
-  CacheReader reader(cache);
+  CacheReader reader(cache, is_referenced);
   u32 count = cache.disk_cache.OpenAndRead(filename, reader);
   INFO_LOG_FMT(VIDEO, "Loaded {} cached shaders from {}", count, filename);
 }
@@ -277,19 +438,94 @@ void ShaderCache::ClearShaderCache(T& cache)
   cache.disk_cache.Sync();
   cache.disk_cache.Close();
   cache.shader_map.clear();
+  cache.stored_entries.clear();
+}
+
+template <ShaderStage stage, typename T, typename K>
+const AbstractShader* ShaderCache::LoadStoredShader(T& cache, const K& uid)
+{
+  auto stored = cache.stored_entries.find(uid);
+  if (stored == cache.stored_entries.end() || !stored->second.usable)
+    return nullptr;
+
+  // If the binary can't be used, the shader is compiled instead, and the new binary is appended.
+  stored->second.usable = false;
+  std::vector<u8> binary(stored->second.size);
+  if (!cache.disk_cache.ReadValue(stored->second.offset, binary.data(), stored->second.size))
+    return nullptr;
+
+  auto shader = g_gfx->CreateShaderFromBinary(stage, binary.data(), binary.size());
+  if (!shader)
+    return nullptr;
+
+  stored->second.usable = true;
+  auto& entry = cache.shader_map[uid];
+  entry.shader = std::move(shader);
+  entry.pending = false;
+  CountCreatedShader(stage);
+  return entry.shader.get();
+}
+
+std::vector<u8> ShaderCache::ReadStoredGXPipelineData(const GXPipelineUid& uid)
+{
+  SerializedGXPipelineUid disk_uid;
+  SerializePipelineUid(uid, disk_uid);
+  auto stored = m_gx_pipeline_stored_entries.find(disk_uid);
+  if (stored == m_gx_pipeline_stored_entries.end() || !stored->second.usable)
+    return {};
+
+  std::vector<u8> data(stored->second.size);
+  if (!m_gx_pipeline_disk_cache.ReadValue(stored->second.offset, data.data(),
+                                          stored->second.size))
+  {
+    stored->second.usable = false;
+    return {};
+  }
+  return data;
+}
+
+void ShaderCache::DiscardStoredGXPipelineData(const GXPipelineUid& uid)
+{
+  SerializedGXPipelineUid disk_uid;
+  SerializePipelineUid(uid, disk_uid);
+  auto stored = m_gx_pipeline_stored_entries.find(disk_uid);
+  if (stored != m_gx_pipeline_stored_entries.end())
+    stored->second.usable = false;
 }
 
 template <typename KeyType, typename DiskKeyType, typename T>
 void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyType, u8>& disk_cache,
-                                    APIType api_type, const char* type, bool include_gameid)
+                                    APIType api_type, const char* type, bool include_gameid,
+                                    const std::function<bool(const DiskKeyType&)>& is_referenced)
 {
   class CacheReader : public Common::LinearDiskCacheReader<DiskKeyType, u8>
   {
   public:
-    CacheReader(ShaderCache* this_ptr_, T& cache_) : this_ptr(this_ptr_), cache(cache_) {}
+    CacheReader(ShaderCache* this_ptr_, T& cache_,
+                const std::function<bool(const DiskKeyType&)>& is_referenced_)
+        : this_ptr(this_ptr_), cache(cache_), is_referenced(is_referenced_)
+    {
+    }
     bool AnyFailed() const { return failed; }
+    void ReadAt(const DiskKeyType& key, const u8* value, u32 value_size,
+                u64 value_offset) override
+    {
+      // Only the GX pipelines are kept in a cross-game cache.
+      if constexpr (std::is_same_v<DiskKeyType, SerializedGXPipelineUid>)
+      {
+        if (is_referenced)
+        {
+          this_ptr->m_gx_pipeline_stored_entries.insert_or_assign(
+              key, StoredCacheEntry{value_offset, value_size});
+        }
+      }
+      Read(key, value, value_size);
+    }
     void Read(const DiskKeyType& key, const u8* value, u32 value_size) override
     {
+      if (is_referenced && !is_referenced(key))
+        return;
+
       KeyType real_uid;
       UnserializePipelineUid(key, real_uid);
 
@@ -304,8 +540,12 @@ void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyTyp
       auto pipeline = g_gfx->CreatePipeline(*config, value, value_size);
       if (!pipeline)
       {
-        // If any of the pipelines fail to create, consider the cache stale.
-        failed = true;
+        // If any of the pipelines fail to create, consider the cache stale. A cross-game cache
+        // also holds pipelines of other games though, so only this entry is skipped there.
+        if (!is_referenced)
+          failed = true;
+        else if constexpr (std::is_same_v<DiskKeyType, SerializedGXPipelineUid>)
+          this_ptr->m_gx_pipeline_stored_entries[key].usable = false;
         return;
       }
 
@@ -317,11 +557,12 @@ void ShaderCache::LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyTyp
   private:
     ShaderCache* this_ptr;
     T& cache;
+    const std::function<bool(const DiskKeyType&)>& is_referenced;
     bool failed = false;
   };
 
   std::string filename = GetDiskShaderCacheFileName(api_type, type, include_gameid, true);
-  CacheReader reader(this, cache);
+  CacheReader reader(this, cache, is_referenced);
   const u32 count = disk_cache.OpenAndRead(filename, reader);
   INFO_LOG_FMT(VIDEO, "Loaded {} cached pipelines from {}", count, filename);
 
@@ -355,6 +596,25 @@ void ShaderCache::ClearPipelineCache(T& cache, Y& disk_cache)
 
 void ShaderCache::LoadCaches()
 {
+  const bool shared = g_ActiveConfig.bSharedShaderCache;
+
+  // The cross-game caches hold the shaders of every game, so only the ones this game's pipeline
+  // UID cache refers to are created up front. The others are created from the files by their UID
+  // once the game first uses them, which is what lets a game's first run benefit from the store.
+  SharedCacheReferences references;
+  if (shared)
+  {
+    ReadSharedCacheReferences(
+        File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache",
+        &references);
+  }
+  const std::function<bool(const VertexShaderUid&)> is_vs_referenced =
+      [&](const VertexShaderUid& uid) { return references.vs_uids.contains(uid); };
+  const std::function<bool(const PixelShaderUid&)> is_ps_referenced =
+      [&](const PixelShaderUid& uid) { return references.ps_uids.contains(uid); };
+  const std::function<bool(const SerializedGXPipelineUid&)> is_pipeline_referenced =
+      [&](const SerializedGXPipelineUid& uid) { return references.pipeline_uids.contains(uid); };
+
   // Ubershader caches, if present.
   if (g_backend_info.bSupportsShaderBinaries)
   {
@@ -368,17 +628,38 @@ void ShaderCache::LoadCaches()
       LoadShaderCache<ShaderStage::Geometry, GeometryShaderUid>(m_gs_cache, m_api_type, "gs",
                                                                 false);
 
-    // Specialized shaders, gameid-specific.
-    LoadShaderCache<ShaderStage::Vertex, VertexShaderUid>(m_vs_cache, m_api_type, "specialized-vs",
-                                                          true);
-    LoadShaderCache<ShaderStage::Pixel, PixelShaderUid>(m_ps_cache, m_api_type, "specialized-ps",
-                                                        true);
+    // Specialized shaders, gameid-specific. When the shared cache is enabled, these are stored in
+    // a single cross-game file instead, and the game's pipeline UID cache is the list of entries
+    // it references.
+    if (shared)
+    {
+      LoadShaderCache<ShaderStage::Vertex, VertexShaderUid>(
+          m_vs_cache, m_api_type, SHARED_VS_CACHE_TYPE, false, is_vs_referenced);
+      LoadShaderCache<ShaderStage::Pixel, PixelShaderUid>(
+          m_ps_cache, m_api_type, SHARED_PS_CACHE_TYPE, false, is_ps_referenced);
+    }
+    else
+    {
+      LoadShaderCache<ShaderStage::Vertex, VertexShaderUid>(m_vs_cache, m_api_type,
+                                                            "specialized-vs", true);
+      LoadShaderCache<ShaderStage::Pixel, PixelShaderUid>(m_ps_cache, m_api_type,
+                                                          "specialized-ps", true);
+    }
   }
 
   if (g_backend_info.bSupportsPipelineCacheData)
   {
-    LoadPipelineCache<GXPipelineUid, SerializedGXPipelineUid>(
-        m_gx_pipeline_cache, m_gx_pipeline_disk_cache, m_api_type, "specialized-pipeline", true);
+    if (shared)
+    {
+      LoadPipelineCache<GXPipelineUid, SerializedGXPipelineUid>(
+          m_gx_pipeline_cache, m_gx_pipeline_disk_cache, m_api_type, SHARED_PIPELINE_CACHE_TYPE,
+          false, is_pipeline_referenced);
+    }
+    else
+    {
+      LoadPipelineCache<GXPipelineUid, SerializedGXPipelineUid>(
+          m_gx_pipeline_cache, m_gx_pipeline_disk_cache, m_api_type, "specialized-pipeline", true);
+    }
     LoadPipelineCache<GXUberPipelineUid, SerializedGXUberPipelineUid>(
         m_gx_uber_pipeline_cache, m_gx_uber_pipeline_disk_cache, m_api_type, "uber-pipeline",
         false);
@@ -387,7 +668,13 @@ void ShaderCache::LoadCaches()
 
 void ShaderCache::ClearCaches()
 {
+  // Specialized pipelines reference the regular shaders, so they have to go first.
+  m_specialized_pipelines.clear();
+  m_num_specialized_pipelines_queued = 0;
+  SETSTAT(g_stats.num_specialized_pipelines, 0);
+
   ClearPipelineCache(m_gx_pipeline_cache, m_gx_pipeline_disk_cache);
+  m_gx_pipeline_stored_entries.clear();
   ClearShaderCache(m_vs_cache);
   ClearShaderCache(m_gs_cache);
   ClearShaderCache(m_ps_cache);
@@ -474,7 +761,8 @@ const AbstractShader* ShaderCache::InsertVertexShader(const VertexShaderUid& uid
 
   if (shader && !entry.shader)
   {
-    if (g_ActiveConfig.bShaderCache && g_backend_info.bSupportsShaderBinaries)
+    if (g_ActiveConfig.bShaderCache && g_backend_info.bSupportsShaderBinaries &&
+        !HasUsableStoredEntry(m_vs_cache.stored_entries, uid))
     {
       auto binary = shader->GetBinary();
       if (!binary.empty())
@@ -518,7 +806,8 @@ const AbstractShader* ShaderCache::InsertPixelShader(const PixelShaderUid& uid,
 
   if (shader && !entry.shader)
   {
-    if (g_ActiveConfig.bShaderCache && g_backend_info.bSupportsShaderBinaries)
+    if (g_ActiveConfig.bShaderCache && g_backend_info.bSupportsShaderBinaries &&
+        !HasUsableStoredEntry(m_ps_cache.stored_entries, uid))
     {
       auto binary = shader->GetBinary();
       if (!binary.empty())
@@ -616,7 +905,7 @@ ShaderCache::GetGXPipelineConfig(const GXPipelineUid& config_in)
   auto vs_iter = m_vs_cache.shader_map.find(config.vs_uid);
   if (vs_iter != m_vs_cache.shader_map.end() && !vs_iter->second.pending)
     vs = vs_iter->second.shader.get();
-  else
+  else if (!(vs = LoadStoredShader<ShaderStage::Vertex>(m_vs_cache, config.vs_uid)))
     vs = InsertVertexShader(config.vs_uid, CompileVertexShader(config.vs_uid));
 
   PixelShaderUid ps_uid = config.ps_uid;
@@ -626,7 +915,7 @@ ShaderCache::GetGXPipelineConfig(const GXPipelineUid& config_in)
   auto ps_iter = m_ps_cache.shader_map.find(ps_uid);
   if (ps_iter != m_ps_cache.shader_map.end() && !ps_iter->second.pending)
     ps = ps_iter->second.shader.get();
-  else
+  else if (!(ps = LoadStoredShader<ShaderStage::Pixel>(m_ps_cache, ps_uid)))
     ps = InsertPixelShader(ps_uid, CompilePixelShader(ps_uid));
 
   if (!vs || !ps)
@@ -748,13 +1037,14 @@ const AbstractPipeline* ShaderCache::InsertGXPipeline(const GXPipelineUid& confi
   {
     entry.first = std::move(pipeline);
 
-    if (g_ActiveConfig.bShaderCache)
+    SerializedGXPipelineUid disk_uid;
+    SerializePipelineUid(config, disk_uid);
+    if (g_ActiveConfig.bShaderCache &&
+        !HasUsableStoredEntry(m_gx_pipeline_stored_entries, disk_uid))
     {
       auto cache_data = entry.first->GetCacheData();
       if (!cache_data.empty())
       {
-        SerializedGXPipelineUid disk_uid;
-        SerializePipelineUid(config, disk_uid);
         m_gx_pipeline_disk_cache.Append(disk_uid, cache_data.data(),
                                         static_cast<u32>(cache_data.size()));
       }
@@ -792,8 +1082,6 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
 
 void ShaderCache::LoadPipelineUIDCache()
 {
-  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
-  constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
   std::string filename =
       File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
   if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
@@ -804,15 +1092,16 @@ void ShaderCache::LoadPipelineUIDCache()
     bool uid_file_valid = false;
     if (m_gx_pipeline_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
         m_gx_pipeline_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
-        existing_magic == CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
+        existing_magic == UID_CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
     {
       // Ensure the expected size matches the actual size of the file. If it doesn't, it means
       // the cache file may be corrupted, and we should not proceed with loading potentially
       // garbage or invalid UIDs.
       const u64 file_size = m_gx_pipeline_uid_cache_file.GetSize();
       const size_t uid_count =
-          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
-      const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
+          static_cast<size_t>(file_size - UID_CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
+      const size_t expected_size =
+          uid_count * sizeof(SerializedGXPipelineUid) + UID_CACHE_HEADER_SIZE;
       uid_file_valid = file_size == expected_size;
       if (uid_file_valid)
       {
@@ -848,7 +1137,7 @@ void ShaderCache::LoadPipelineUIDCache()
     if (m_gx_pipeline_uid_cache_file.Open(filename, "wb"))
     {
       // Write the version identifier.
-      m_gx_pipeline_uid_cache_file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(GX_PIPELINE_UID_VERSION));
+      m_gx_pipeline_uid_cache_file.WriteBytes(&UID_CACHE_FILE_MAGIC, sizeof(UID_CACHE_FILE_MAGIC));
       m_gx_pipeline_uid_cache_file.WriteBytes(&GX_PIPELINE_UID_VERSION,
                                               sizeof(GX_PIPELINE_UID_VERSION));
 
@@ -897,6 +1186,105 @@ void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
   }
 }
 
+template <typename K, typename F>
+static void CompactSharedCacheFile(const std::string& filename, const F& is_referenced,
+                                   ShaderCache::SharedCacheCompactionResult* result)
+{
+  result->bytes_before += File::GetSize(filename);
+
+  CacheEntryCollector<K> collector;
+  Common::LinearDiskCache<K, u8> disk_cache;
+  disk_cache.OpenAndRead(filename, collector);
+  disk_cache.Close();
+
+  // Write the surviving entries to a new file, and replace the original once it is complete, so
+  // that an interrupted compaction can't leave a truncated cache behind.
+  const std::string temp_filename = filename + ".tmp";
+  File::Delete(temp_filename, File::IfAbsentBehavior::NoConsoleWarning);
+
+  CacheEntryCollector<K> unused;
+  disk_cache.OpenAndRead(temp_filename, unused);
+
+  RawKeySet<K> written_keys;
+  for (const auto& [key, value] : collector.entries)
+  {
+    // Duplicate entries can exist if two sessions compiled the same shader concurrently.
+    if (!is_referenced(key) || !written_keys.insert(key).second)
+    {
+      result->entries_removed++;
+      continue;
+    }
+
+    disk_cache.Append(key, value.data(), static_cast<u32>(value.size()));
+    result->entries_kept++;
+  }
+  disk_cache.Sync();
+  disk_cache.Close();
+
+  if (!File::RenameSync(temp_filename, filename))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to replace '{}' with compacted cache", filename);
+    File::Delete(temp_filename);
+    result->bytes_after += File::GetSize(filename);
+    return;
+  }
+
+  result->bytes_after += File::GetSize(filename);
+  result->files_processed++;
+}
+
+ShaderCache::SharedCacheCompactionResult ShaderCache::CompactSharedCaches()
+{
+  SharedCacheCompactionResult result;
+
+  // Every game's pipeline UID cache lists the pipelines it has used, which is the set of entries
+  // it references in the shared caches, regardless of which API or host config they were for.
+  // If any of them can't be read, the entries that game needs are unknown, so nothing is removed.
+  SharedCacheReferences references;
+  for (const std::string& filename :
+       Common::DoFileSearch(File::GetUserPath(D_CACHE_IDX), ".uidcache"))
+  {
+    if (!ReadSharedCacheReferences(filename, &references))
+    {
+      ERROR_LOG_FMT(VIDEO, "Not compacting the shared shader caches, since '{}' can't be read",
+                    filename);
+      result.skipped = true;
+      return result;
+    }
+  }
+
+  const auto has_type = [](const std::string& filename, const char* type) {
+    std::string name;
+    SplitPath(filename, nullptr, &name, nullptr);
+    return name.find(fmt::format("-{}-", type)) != std::string::npos;
+  };
+
+  for (const std::string& filename :
+       Common::DoFileSearch(File::GetUserPath(D_SHADERCACHE_IDX), ".cache"))
+  {
+    if (has_type(filename, SHARED_VS_CACHE_TYPE))
+    {
+      CompactSharedCacheFile<VertexShaderUid>(
+          filename, [&](const auto& uid) { return references.vs_uids.contains(uid); }, &result);
+    }
+    else if (has_type(filename, SHARED_PS_CACHE_TYPE))
+    {
+      CompactSharedCacheFile<PixelShaderUid>(
+          filename, [&](const auto& uid) { return references.ps_uids.contains(uid); }, &result);
+    }
+    else if (has_type(filename, SHARED_PIPELINE_CACHE_TYPE))
+    {
+      CompactSharedCacheFile<SerializedGXPipelineUid>(
+          filename, [&](const auto& uid) { return references.pipeline_uids.contains(uid); },
+          &result);
+    }
+  }
+
+  INFO_LOG_FMT(VIDEO, "Compacted {} shared shader cache files: kept {} entries, removed {}",
+               result.files_processed, result.entries_kept, result.entries_removed);
+  return result;
+}
+
 void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority)
 {
   class VertexShaderWorkItem final : public AsyncShaderCompiler::WorkItem
@@ -921,6 +1309,10 @@ void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 prior
     VertexShaderUid uid;
   };
 
+  // Shaders that the cross-game cache holds don't need to be compiled.
+  if (LoadStoredShader<ShaderStage::Vertex>(m_vs_cache, uid))
+    return;
+
   m_vs_cache.shader_map[uid].pending = true;
   auto wi = m_async_shader_compiler->CreateWorkItem<VertexShaderWorkItem>(this, uid);
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
@@ -979,6 +1371,10 @@ void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priorit
     PixelShaderUid uid;
   };
 
+  // Shaders that the cross-game cache holds don't need to be compiled.
+  if (LoadStoredShader<ShaderStage::Pixel>(m_ps_cache, uid))
+    return;
+
   m_ps_cache.shader_map[uid].pending = true;
   auto wi = m_async_shader_compiler->CreateWorkItem<PixelShaderWorkItem>(this, uid);
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
@@ -1024,7 +1420,11 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       // Check if all the stages required for this pipeline have been compiled.
       // If not, this work item becomes a no-op, and re-queues the pipeline for the next frame.
       if (SetStagesReady())
+      {
         config = shader_cache->GetGXPipelineConfig(uid);
+        if (config)
+          stored_data = shader_cache->ReadStoredGXPipelineData(uid);
+      }
     }
 
     bool SetStagesReady()
@@ -1033,25 +1433,34 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
 
       GXPipelineUid actual_uid = ApplyDriverBugs(uid);
 
+      // Queueing a shader that the cross-game cache holds creates it right away.
+      if (!shader_cache->m_vs_cache.shader_map.contains(actual_uid.vs_uid))
+        shader_cache->QueueVertexShaderCompile(actual_uid.vs_uid, priority);
       auto vs_it = shader_cache->m_vs_cache.shader_map.find(actual_uid.vs_uid);
       stages_ready &= vs_it != shader_cache->m_vs_cache.shader_map.end() && !vs_it->second.pending;
-      if (vs_it == shader_cache->m_vs_cache.shader_map.end())
-        shader_cache->QueueVertexShaderCompile(actual_uid.vs_uid, priority);
 
       PixelShaderUid ps_uid = actual_uid.ps_uid;
       ClearUnusedPixelShaderUidBits(shader_cache->m_api_type, shader_cache->m_host_config, &ps_uid);
 
+      if (!shader_cache->m_ps_cache.shader_map.contains(ps_uid))
+        shader_cache->QueuePixelShaderCompile(ps_uid, priority);
       auto ps_it = shader_cache->m_ps_cache.shader_map.find(ps_uid);
       stages_ready &= ps_it != shader_cache->m_ps_cache.shader_map.end() && !ps_it->second.pending;
-      if (ps_it == shader_cache->m_ps_cache.shader_map.end())
-        shader_cache->QueuePixelShaderCompile(ps_uid, priority);
 
       return stages_ready;
     }
 
     bool Compile() override
     {
-      if (config)
+      if (!config)
+        return true;
+
+      if (!stored_data.empty())
+      {
+        pipeline = g_gfx->CreatePipeline(*config, stored_data.data(), stored_data.size());
+        stored_data_failed = !pipeline;
+      }
+      if (!pipeline)
         pipeline = g_gfx->CreatePipeline(*config);
       return true;
     }
@@ -1060,6 +1469,8 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
     {
       if (stages_ready)
       {
+        if (stored_data_failed)
+          shader_cache->DiscardStoredGXPipelineData(uid);
         shader_cache->InsertGXPipeline(uid, std::move(pipeline));
       }
       else
@@ -1077,6 +1488,8 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
     GXPipelineUid uid;
     u32 priority;
     std::optional<AbstractPipelineConfig> config;
+    std::vector<u8> stored_data;
+    bool stored_data_failed = false;
     bool stages_ready;
   };
 
@@ -1085,6 +1498,71 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
   m_gx_pipeline_cache[uid].second = true;
 }
 
+void ShaderCache::QueueSpecializedPipelineCompile(const SpecializedPipelineKey& key)
+{
+  class SpecializedPipelineWorkItem final : public AsyncShaderCompiler::WorkItem
+  {
+  public:
+    SpecializedPipelineWorkItem(ShaderCache* shader_cache_, const SpecializedPipelineKey& key_)
+        : shader_cache(shader_cache_), key(key_)
+    {
+      // The pipeline has already been drawn with, so all of its shaders are available and only
+      // the pixel shader has to be compiled again.
+      config = shader_cache->GetGXPipelineConfig(key.uid);
+      ps_uid = ApplyDriverBugs(key.uid).ps_uid;
+      ClearUnusedPixelShaderUidBits(shader_cache->m_api_type, shader_cache->m_host_config,
+                                    &ps_uid);
+    }
+
+    bool Compile() override
+    {
+      if (!config)
+        return true;
+
+      const ShaderCode source_code =
+          GeneratePixelShaderCode(shader_cache->m_api_type, shader_cache->m_host_config,
+                                  ps_uid.GetUidData(), {}, &key.specialization);
+      pixel_shader = g_gfx->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
+      if (pixel_shader)
+      {
+        config->pixel_shader = pixel_shader.get();
+        pipeline = g_gfx->CreatePipeline(*config);
+      }
+      return true;
+    }
+
+    void Retrieve() override
+    {
+      // A failed compile leaves a null pipeline, so the regular one keeps being used.
+      SpecializedPipeline& entry = shader_cache->m_specialized_pipelines[key];
+      entry.queued = true;
+      entry.pending = false;
+      if (pipeline)
+      {
+        entry.pixel_shader = std::move(pixel_shader);
+        entry.pipeline = std::move(pipeline);
+        INCSTAT(g_stats.num_specialized_pipelines);
+      }
+    }
+
+  private:
+    ShaderCache* shader_cache;
+    SpecializedPipelineKey key;
+    PixelShaderUid ps_uid;
+    std::optional<AbstractPipelineConfig> config;
+    std::unique_ptr<AbstractShader> pixel_shader;
+    std::unique_ptr<AbstractPipeline> pipeline;
+  };
+
+  auto wi = m_async_shader_compiler->CreateWorkItem<SpecializedPipelineWorkItem>(this, key);
+  m_async_shader_compiler->QueueWorkItem(std::move(wi), COMPILE_PRIORITY_SPECIALIZED_PIPELINE);
+
+  SpecializedPipeline& entry = m_specialized_pipelines[key];
+  entry.queued = true;
+  entry.pending = true;
+  m_num_specialized_pipelines_queued++;
+}
+
 void ShaderCache::QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority)
 {
   class UberPipelineWorkItem final : public AsyncShaderCompiler::WorkItem
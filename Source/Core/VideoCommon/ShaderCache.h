@@ -6,12 +6,15 @@
 #include <array>
 #include <cstddef>
 #include <cstring>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
@@ -62,6 +65,22 @@ public:
   // Retrieves all pending shaders/pipelines from the async compiler.
   void RetrieveAsyncShaders();
 
+  struct SharedCacheCompactionResult
+  {
+    u32 files_processed = 0;
+    u32 entries_kept = 0;
+    u32 entries_removed = 0;
+    u64 bytes_before = 0;
+    u64 bytes_after = 0;
+    // Set if a game's pipeline UID cache couldn't be read, so nothing was removed.
+    bool skipped = false;
+  };
+
+  // Removes entries from the cross-game shader/pipeline caches which are no longer referenced by
+  // any game's pipeline UID cache. Does not require a video backend to be active. Nothing is
+  // removed if any game's pipeline UID cache can't be read.
+  static SharedCacheCompactionResult CompactSharedCaches();
+
   // Accesses ShaderGen shader caches
   const AbstractPipeline* GetPipelineForUid(const GXPipelineUid& uid);
   const AbstractPipeline* GetUberPipelineForUid(const GXUberPipelineUid& uid);
@@ -70,6 +89,12 @@ public:
   // The optional will be empty if this pipeline is now background compiling.
   std::optional<const AbstractPipeline*> GetPipelineForUidAsync(const GXPipelineUid& uid);
 
+  // Returns a variant of the pipeline with the current values of rarely changing pixel shader
+  // uniforms folded in, or null if there is none (yet). Variants are compiled in the background
+  // once a pipeline has been drawn with the same values often enough.
+  const AbstractPipeline* GetSpecializedPipeline(const GXPipelineUid& uid,
+                                                 const PixelShaderConstants& constants);
+
   // Shared shaders
   const AbstractShader* GetScreenQuadVertexShader() const
   {
@@ -170,14 +195,39 @@ private:
   void QueuePipelineCompile(const GXPipelineUid& uid, u32 priority);
   void QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority);
 
-  // Populating various caches.
+  // Pipeline specialization
+  struct SpecializedPipelineKey
+  {
+    GXPipelineUid uid;
+    PixelShaderSpecialization specialization;
+
+    bool operator<(const SpecializedPipelineKey& rhs) const
+    {
+      return std::tie(uid, specialization) < std::tie(rhs.uid, rhs.specialization);
+    }
+  };
+  void QueueSpecializedPipelineCompile(const SpecializedPipelineKey& key);
+  void PruneSpecializationCandidates();
+
+  // Populating various caches. If is_referenced is set, only the entries it returns true for are
+  // created, which is used for the cross-game caches.
   template <ShaderStage stage, typename K, typename T>
-  void LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid);
+  void LoadShaderCache(T& cache, APIType api_type, const char* type, bool include_gameid,
+                       const std::function<bool(const K&)>& is_referenced = {});
   template <typename T>
   void ClearShaderCache(T& cache);
+
+  // Creates a shader from its entry in the cross-game cache file, returning null if the file
+  // doesn't hold a usable binary for it.
+  template <ShaderStage stage, typename T, typename K>
+  const AbstractShader* LoadStoredShader(T& cache, const K& uid);
+  // Returns the data the cross-game cache file holds for a pipeline, or nothing if there is none.
+  std::vector<u8> ReadStoredGXPipelineData(const GXPipelineUid& uid);
+  void DiscardStoredGXPipelineData(const GXPipelineUid& uid);
   template <typename KeyType, typename DiskKeyType, typename T>
   void LoadPipelineCache(T& cache, Common::LinearDiskCache<DiskKeyType, u8>& disk_cache,
-                         APIType api_type, const char* type, bool include_gameid);
+                         APIType api_type, const char* type, bool include_gameid,
+                         const std::function<bool(const DiskKeyType&)>& is_referenced = {});
   template <typename T, typename Y>
   void ClearPipelineCache(T& cache, Y& disk_cache);
 
@@ -189,9 +239,17 @@ private:
   {
     COMPILE_PRIORITY_ONDEMAND_PIPELINE = 100,
     COMPILE_PRIORITY_UBERSHADER_PIPELINE = 200,
-    COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300
+    COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300,
+    COMPILE_PRIORITY_SPECIALIZED_PIPELINE = 400
   };
 
+  // A pipeline and constant combination is specialized once it has been drawn this many times
+  // within one window of frames. Combinations that don't get there are forgotten at the end of
+  // the window.
+  static constexpr u32 SPECIALIZATION_DRAW_THRESHOLD = 256;
+  static constexpr u32 SPECIALIZATION_WINDOW_FRAMES = 60;
+  static constexpr u32 MAX_SPECIALIZED_PIPELINES = 512;
+
   // Configuration bits.
   APIType m_api_type;
   ShaderHostConfig m_host_config = {};
@@ -206,6 +264,15 @@ private:
   std::unique_ptr<AbstractShader> m_texture_copy_pixel_shader;
   std::unique_ptr<AbstractShader> m_color_pixel_shader;
 
+  // Location of an entry in a cross-game cache file. These hold the shaders of every game, so
+  // entries are only created from them once a game needs them.
+  struct StoredCacheEntry
+  {
+    u64 offset;
+    u32 size;
+    bool usable = true;
+  };
+
   // GX Shader Caches
   template <typename Uid>
   struct ShaderModuleCache
@@ -217,6 +284,7 @@ private:
     };
     std::map<Uid, Shader> shader_map;
     Common::LinearDiskCache<Uid, u8> disk_cache;
+    std::map<Uid, StoredCacheEntry> stored_entries;
   };
   ShaderModuleCache<VertexShaderUid> m_vs_cache;
   ShaderModuleCache<GeometryShaderUid> m_gs_cache;
@@ -229,7 +297,21 @@ private:
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
   File::IOFile m_gx_pipeline_uid_cache_file;
+
+  // Specialized pipelines, and the candidates that are not hot enough yet.
+  struct SpecializedPipeline
+  {
+    std::unique_ptr<AbstractShader> pixel_shader;
+    std::unique_ptr<AbstractPipeline> pipeline;
+    u32 draws = 0;
+    bool queued = false;
+    bool pending = false;
+  };
+  std::map<SpecializedPipelineKey, SpecializedPipeline> m_specialized_pipelines;
+  u32 m_num_specialized_pipelines_queued = 0;
+  u32 m_frames_since_specialization_prune = 0;
   Common::LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
+  std::map<SerializedGXPipelineUid, StoredCacheEntry> m_gx_pipeline_stored_entries;
   Common::LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
 
   // EFB copy to VRAM/RAM pipelines
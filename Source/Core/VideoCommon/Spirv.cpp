@@ -3,15 +3,27 @@
 
 #include "VideoCommon/Spirv.h"
 
+#include <atomic>
 #include <fstream>
+#include <iterator>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <glslang/SPIRV/GlslangToSpv.h>
+#include <xxhash.h>
 
 #include "Common/FileUtil.h"
+#include "Common/LinearDiskCache.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Version.h"
+#include "Common/WorkQueueThread.h"
 
+#include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -19,21 +31,221 @@ namespace
 {
 bool InitializeGlslang()
 {
-  static bool glslang_initialized = false;
-  if (glslang_initialized)
+  // Shaders are compiled on the async shader compiler's worker threads, so the first compiles can
+  // race each other here. Once the process is initialized, glslang keeps all of its compilation
+  // state per thread, so compiles don't need to be serialized.
+  static const bool glslang_initialized = [] {
+    if (!glslang::InitializeProcess())
+    {
+      PanicAlertFmt("Failed to initialize glslang shader compiler");
+      return false;
+    }
+
+    std::atexit([] { glslang::FinalizeProcess(); });
     return true;
+  }();
+  return glslang_initialized;
+}
+
+// Everything which affects the SPIR-V generated for a shader. The source is identified by its
+// hash, as it is far too large to be stored in the key.
+struct SPIRVCacheKey
+{
+  u64 source_hash_low;
+  u64 source_hash_high;
+  u32 stage;
+  u32 api_type;
+  u32 language_version;
+  u32 debug_info;
 
-  if (!glslang::InitializeProcess())
+  bool operator==(const SPIRVCacheKey&) const = default;
+};
+
+struct SPIRVCacheKeyHash
+{
+  size_t operator()(const SPIRVCacheKey& key) const
   {
-    PanicAlertFmt("Failed to initialize glslang shader compiler");
-    return false;
+    return static_cast<size_t>(key.source_hash_low);
   }
+};
+
+// SPIR-V of every shader compiled so far, so that glslang only has to be run once for each
+// shader. Unlike the per-game shader caches, this is keyed on the source alone, so it is shared
+// by all games and host configs, and also covers the utility shaders which are created every
+// time the backend starts. It is only stored on disk while shader caching is enabled. Shaders
+// which use an includer are not cached, as the hash does not cover the included files.
+//
+// Lookups come from every shader compiler thread at once, so they only take a shared lock, and
+// new entries are written to disk by a separate thread.
+class SPIRVCache final : public Common::LinearDiskCacheReader<SPIRVCacheKey, SPIRV::CodeType>
+{
+public:
+  std::optional<SPIRV::CodeVector> Lookup(const SPIRVCacheKey& key)
+  {
+    if (!m_disk_cache_open.load(std::memory_order_acquire) && g_ActiveConfig.bShaderCache)
+      OpenDiskCache();
 
-  std::atexit([] { glslang::FinalizeProcess(); });
+    EntryPointer code;
+    {
+      std::shared_lock guard{m_lock};
+      const auto iter = m_entries.find(key);
+      if (iter != m_entries.end())
+        code = iter->second;
+    }
 
-  glslang_initialized = true;
-  return true;
-}
+    if (!code)
+    {
+      m_misses.fetch_add(1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return *code;
+  }
+
+  void Insert(const SPIRVCacheKey& key, const SPIRV::CodeVector& code)
+  {
+    auto entry = std::make_shared<const SPIRV::CodeVector>(code);
+    {
+      std::unique_lock guard{m_lock};
+
+      // Two threads may have compiled the same shader concurrently.
+      if (!m_entries.try_emplace(key, entry).second)
+        return;
+    }
+
+    if (m_disk_cache_open.load(std::memory_order_acquire))
+      m_disk_writer.EmplaceItem(key, std::move(entry));
+  }
+
+  void Read(const SPIRVCacheKey& key, const SPIRV::CodeType* value, u32 value_size) override
+  {
+    const auto [iter, inserted] = m_entries.try_emplace(
+        key, std::make_shared<const SPIRV::CodeVector>(value, value + value_size));
+    if (inserted)
+      m_load_order.push_back(key);
+  }
+
+  SPIRV::CacheStats GetStats() const
+  {
+    return {m_hits.load(std::memory_order_relaxed), m_misses.load(std::memory_order_relaxed)};
+  }
+
+  void ResetStats()
+  {
+    m_hits.store(0, std::memory_order_relaxed);
+    m_misses.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  using EntryPointer = std::shared_ptr<const SPIRV::CodeVector>;
+  using DiskCache = Common::LinearDiskCache<SPIRVCacheKey, SPIRV::CodeType>;
+
+  // The file is shared by every game and never invalidated, so it is trimmed back to half of this
+  // size whenever it is found to be larger on startup.
+  static constexpr u64 MAX_DISK_CACHE_SIZE = 128 * 1024 * 1024;
+
+  class NullReader final : public Common::LinearDiskCacheReader<SPIRVCacheKey, SPIRV::CodeType>
+  {
+  public:
+    void Read(const SPIRVCacheKey&, const SPIRV::CodeType*, u32) override {}
+  };
+
+  static u64 GetEntrySize(const SPIRV::CodeVector& code)
+  {
+    return sizeof(u32) + sizeof(SPIRVCacheKey) + code.size() * sizeof(SPIRV::CodeType);
+  }
+
+  void OpenDiskCache()
+  {
+    std::unique_lock guard{m_lock};
+    if (m_disk_cache_open.load(std::memory_order_relaxed))
+      return;
+
+    const std::string filename =
+        GetDiskShaderCacheFileName(APIType::Nothing, "SPIRV", false, false, false);
+    const u32 count = m_disk_cache.OpenAndRead(filename, *this);
+    INFO_LOG_FMT(VIDEO, "Loaded {} SPIR-V shaders from {}", count, filename);
+
+    if (File::GetSize(filename) > MAX_DISK_CACHE_SIZE)
+      CompactDiskCache(filename);
+    m_load_order.clear();
+    m_load_order.shrink_to_fit();
+
+    m_disk_writer.Reset("SPIR-V Cache Writer", [this](WriteItem item) {
+      m_disk_cache.Append(item.first, item.second->data(), static_cast<u32>(item.second->size()));
+      m_disk_cache.Sync();
+    });
+    m_disk_cache_open.store(true, std::memory_order_release);
+  }
+
+  // Drops the entries which were added to the file first, as those are the most likely to belong
+  // to games or versions which are no longer in use.
+  void CompactDiskCache(const std::string& filename)
+  {
+    m_disk_cache.Close();
+
+    u64 kept_size = 0;
+    auto first_kept = m_load_order.end();
+    while (first_kept != m_load_order.begin())
+    {
+      const u64 size = GetEntrySize(*m_entries.at(*std::prev(first_kept)));
+      if (kept_size + size > MAX_DISK_CACHE_SIZE / 2)
+        break;
+      kept_size += size;
+      --first_kept;
+    }
+
+    for (auto iter = m_load_order.begin(); iter != first_kept; ++iter)
+      m_entries.erase(*iter);
+
+    // Write the surviving entries to a new file, and replace the original once it is complete, so
+    // that an interrupted compaction can't leave a truncated cache behind.
+    const std::string temp_filename = filename + ".tmp";
+    File::Delete(temp_filename, File::IfAbsentBehavior::NoConsoleWarning);
+
+    NullReader null_reader;
+    DiskCache temp_cache;
+    temp_cache.OpenAndRead(temp_filename, null_reader);
+    for (auto iter = first_kept; iter != m_load_order.end(); ++iter)
+    {
+      const SPIRV::CodeVector& code = *m_entries.at(*iter);
+      temp_cache.Append(*iter, code.data(), static_cast<u32>(code.size()));
+    }
+    temp_cache.Sync();
+    temp_cache.Close();
+
+    if (!File::RenameSync(temp_filename, filename))
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to replace '{}' with compacted cache", filename);
+      File::Delete(temp_filename);
+    }
+    else
+    {
+      INFO_LOG_FMT(VIDEO, "Compacted {}: kept {} SPIR-V shaders, removed {}", filename,
+                   m_load_order.end() - first_kept, first_kept - m_load_order.begin());
+    }
+
+    m_disk_cache.OpenAndRead(filename, null_reader);
+  }
+
+  using WriteItem = std::pair<SPIRVCacheKey, EntryPointer>;
+
+  std::shared_mutex m_lock;
+  std::unordered_map<SPIRVCacheKey, EntryPointer, SPIRVCacheKeyHash> m_entries;
+  std::vector<SPIRVCacheKey> m_load_order;
+  std::atomic<bool> m_disk_cache_open{false};
+
+  // Only accessed by the writer thread once the file has been opened. The writer is declared last
+  // so that it finishes writing out its queue before anything else is destroyed.
+  DiskCache m_disk_cache;
+  Common::WorkQueueThread<WriteItem> m_disk_writer;
+
+  std::atomic<u64> m_hits{0};
+  std::atomic<u64> m_misses{0};
+};
+
+SPIRVCache s_spirv_cache;
 
 const TBuiltInResource* GetCompilerResourceLimits()
 {
@@ -181,7 +393,7 @@ CompileShaderToSPV(EShLanguage stage, APIType api_type,
   shader->setStringsWithLengths(&pass_source_code, &pass_source_code_length, 1);
 
   auto DumpBadShader = [&](const char* msg) {
-    static int counter = 0;
+    static std::atomic<int> counter = 0;
     std::string filename = VideoBackendBase::BadShaderFilename(stage_filename, counter++);
     std::ofstream stream;
     File::OpenFStream(stream, filename, std::ios_base::out);
@@ -272,6 +484,39 @@ CompileShaderToSPV(EShLanguage stage, APIType api_type,
 
   return out_code;
 }
+
+std::optional<SPIRV::CodeVector>
+CompileShaderToSPVCached(EShLanguage stage, APIType api_type,
+                         glslang::EShTargetLanguageVersion language_version,
+                         const char* stage_filename, std::string_view source,
+                         glslang::TShader::Includer* shader_includer)
+{
+  if (shader_includer)
+  {
+    StageTimers::ScopedStageTimer timer(StageTimers::Stage::SPIRVCompilation);
+    return CompileShaderToSPV(stage, api_type, language_version, stage_filename, source,
+                              shader_includer);
+  }
+
+  const XXH128_hash_t source_hash = XXH3_128bits(source.data(), source.size());
+  const SPIRVCacheKey key = {source_hash.low64,
+                             source_hash.high64,
+                             static_cast<u32>(stage),
+                             static_cast<u32>(api_type),
+                             static_cast<u32>(language_version),
+                             g_ActiveConfig.bEnableValidationLayer};
+  if (auto code = s_spirv_cache.Lookup(key))
+    return code;
+
+  std::optional<SPIRV::CodeVector> code;
+  {
+    StageTimers::ScopedStageTimer timer(StageTimers::Stage::SPIRVCompilation);
+    code = CompileShaderToSPV(stage, api_type, language_version, stage_filename, source, nullptr);
+  }
+  if (code)
+    s_spirv_cache.Insert(key, *code);
+  return code;
+}
 }  // namespace
 
 namespace SPIRV
@@ -280,31 +525,41 @@ std::optional<CodeVector> CompileVertexShader(std::string_view source_code, APIT
                                               glslang::EShTargetLanguageVersion language_version,
                                               glslang::TShader::Includer* shader_includer)
 {
-  return CompileShaderToSPV(EShLangVertex, api_type, language_version, "vs", source_code,
-                            shader_includer);
+  return CompileShaderToSPVCached(EShLangVertex, api_type, language_version, "vs", source_code,
+                                  shader_includer);
 }
 
 std::optional<CodeVector> CompileGeometryShader(std::string_view source_code, APIType api_type,
                                                 glslang::EShTargetLanguageVersion language_version,
                                                 glslang::TShader::Includer* shader_includer)
 {
-  return CompileShaderToSPV(EShLangGeometry, api_type, language_version, "gs", source_code,
-                            shader_includer);
+  return CompileShaderToSPVCached(EShLangGeometry, api_type, language_version, "gs", source_code,
+                                  shader_includer);
 }
 
 std::optional<CodeVector> CompileFragmentShader(std::string_view source_code, APIType api_type,
                                                 glslang::EShTargetLanguageVersion language_version,
                                                 glslang::TShader::Includer* shader_includer)
 {
-  return CompileShaderToSPV(EShLangFragment, api_type, language_version, "ps", source_code,
-                            shader_includer);
+  return CompileShaderToSPVCached(EShLangFragment, api_type, language_version, "ps", source_code,
+                                  shader_includer);
 }
 
 std::optional<CodeVector> CompileComputeShader(std::string_view source_code, APIType api_type,
                                                glslang::EShTargetLanguageVersion language_version,
                                                glslang::TShader::Includer* shader_includer)
 {
-  return CompileShaderToSPV(EShLangCompute, api_type, language_version, "cs", source_code,
-                            shader_includer);
+  return CompileShaderToSPVCached(EShLangCompute, api_type, language_version, "cs", source_code,
+                                  shader_includer);
+}
+
+CacheStats GetCacheStats()
+{
+  return s_spirv_cache.GetStats();
+}
+
+void ResetCacheStats()
+{
+  s_spirv_cache.ResetStats();
 }
 }  // namespace SPIRV
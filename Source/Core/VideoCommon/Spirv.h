@@ -19,6 +19,12 @@ namespace SPIRV
 using CodeType = u32;
 using CodeVector = std::vector<CodeType>;
 
+struct CacheStats
+{
+  u64 hits = 0;
+  u64 misses = 0;
+};
+
 // Compile a vertex shader to SPIR-V.
 std::optional<CodeVector> CompileVertexShader(std::string_view source_code, APIType api_type,
                                               glslang::EShTargetLanguageVersion language_version,
@@ -38,4 +44,9 @@ std::optional<CodeVector> CompileFragmentShader(std::string_view source_code, AP
 std::optional<CodeVector> CompileComputeShader(std::string_view source_code, APIType api_type,
                                                glslang::EShTargetLanguageVersion language_version,
                                                glslang::TShader::Includer* shader_includer);
+
+// Lookups in the cache of previously compiled shaders since the last reset. Shaders compiled with
+// an includer bypass the cache and are not counted.
+CacheStats GetCacheStats();
+void ResetCacheStats();
 }  // namespace SPIRV
@@ -0,0 +1,76 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/StageTimers.h"
+
+#include "Common/Assert.h"
+
+namespace StageTimers
+{
+namespace
+{
+struct AtomicTotals
+{
+  std::atomic<u64> calls{0};
+  std::atomic<DT::rep> ticks{0};
+};
+
+std::array<AtomicTotals, static_cast<size_t>(Stage::Count)> s_totals;
+}  // namespace
+
+std::atomic<bool> g_enabled{false};
+
+void SetEnabled(bool enabled)
+{
+  g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Reset()
+{
+  for (AtomicTotals& totals : s_totals)
+  {
+    totals.calls.store(0, std::memory_order_relaxed);
+    totals.ticks.store(0, std::memory_order_relaxed);
+  }
+}
+
+Totals GetTotals()
+{
+  Totals result;
+  for (size_t i = 0; i < result.size(); i++)
+  {
+    result[i].calls = s_totals[i].calls.load(std::memory_order_relaxed);
+    result[i].time = DT(s_totals[i].ticks.load(std::memory_order_relaxed));
+  }
+  return result;
+}
+
+const char* GetStageName(Stage stage)
+{
+  switch (stage)
+  {
+  case Stage::CommandProcessing:
+    return "command_processing";
+  case Stage::VertexLoading:
+    return "vertex_loading";
+  case Stage::TextureDecoding:
+    return "texture_decoding";
+  case Stage::ShaderUIDGeneration:
+    return "shader_uid_generation";
+  case Stage::Rasterization:
+    return "rasterization";
+  case Stage::SPIRVCompilation:
+    return "spirv_compilation";
+  default:
+    ASSERT(false);
+    return "";
+  }
+}
+
+void AddTime(Stage stage, DT time)
+{
+  AtomicTotals& totals = s_totals[static_cast<size_t>(stage)];
+  totals.calls.fetch_add(1, std::memory_order_relaxed);
+  totals.ticks.fetch_add(time.count(), std::memory_order_relaxed);
+}
+}  // namespace StageTimers
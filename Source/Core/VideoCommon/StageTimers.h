@@ -0,0 +1,76 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include "Common/CommonTypes.h"
+
+// Wall-clock time spent in the main stages of the GPU thread, for benchmarking FIFO logs.
+// Timing is disabled by default, in which case a ScopedStageTimer costs a single relaxed load.
+// Stages nest: command processing includes the time of every stage that runs while it decodes
+// the FIFO, and rasterization in the Software renderer includes its texture sampling. SPIR-V
+// compilation mostly happens on the shader compiler's worker threads, so its time is summed over
+// all of them and can exceed the wall-clock time of a replay.
+namespace StageTimers
+{
+enum class Stage
+{
+  CommandProcessing,
+  VertexLoading,
+  TextureDecoding,
+  ShaderUIDGeneration,
+  Rasterization,
+  SPIRVCompilation,
+  Count,
+};
+
+struct StageTotals
+{
+  u64 calls = 0;
+  DT time{};
+};
+
+using Totals = std::array<StageTotals, static_cast<size_t>(Stage::Count)>;
+
+extern std::atomic<bool> g_enabled;
+
+inline bool IsEnabled()
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+void SetEnabled(bool enabled);
+
+// Clears the accumulated totals. May be called from any thread.
+void Reset();
+Totals GetTotals();
+const char* GetStageName(Stage stage);
+
+void AddTime(Stage stage, DT time);
+
+class ScopedStageTimer
+{
+public:
+  explicit ScopedStageTimer(Stage stage) : m_stage(stage), m_enabled(IsEnabled())
+  {
+    if (m_enabled)
+      m_start = Clock::now();
+  }
+  ~ScopedStageTimer()
+  {
+    if (m_enabled)
+      AddTime(m_stage, Clock::now() - m_start);
+  }
+
+  ScopedStageTimer(const ScopedStageTimer&) = delete;
+  ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+
+private:
+  Stage m_stage;
+  bool m_enabled;
+  TimePoint m_start;
+};
+}  // namespace StageTimers
@@ -85,10 +85,13 @@ void Statistics::Display() const
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
   draw_statistic("vshaders alive", "%d", num_vertex_shaders_alive);
+  draw_statistic("Specialized pipelines", "%d", num_specialized_pipelines);
   draw_statistic("shaders changes", "%d", this_frame.num_shader_changes);
   draw_statistic("dlists called", "%d", this_frame.num_dlists_called);
   draw_statistic("Primitive joins", "%d", this_frame.num_primitive_joins);
   draw_statistic("Draw calls", "%d", this_frame.num_draw_calls);
+  draw_statistic("Draws merged", "%d", this_frame.num_draws_merged);
+  draw_statistic("Specialized draws", "%d", this_frame.num_specialized_draws);
   draw_statistic("Primitives", "%d", this_frame.num_prims);
   draw_statistic("Primitives (DL)", "%d", this_frame.num_dl_prims);
   draw_statistic("XF loads", "%d", this_frame.num_xf_loads);
@@ -100,9 +103,22 @@ void Statistics::Display() const
   draw_statistic("Vertex streamed", "%i kB", this_frame.bytes_vertex_streamed / 1024);
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
+  draw_statistic("Uniform changed", "%i kB", this_frame.bytes_uniform_changed / 1024);
+  draw_statistic("Uniform uploads skipped", "%d", this_frame.num_uniform_uploads_skipped);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
+  draw_statistic("EFB copies skipped:", "%d", this_frame.num_efb_copies_skipped);
+  draw_statistic("EFB peek cache misses:", "%d", this_frame.num_efb_peek_cache_misses);
+  draw_statistic("EFB prefetches (used/wasted):", "%d (%d/%d)", this_frame.num_efb_peek_prefetches,
+                 this_frame.num_efb_peek_prefetch_hits, this_frame.num_efb_peek_prefetches_wasted);
+  if (const int predictable_accesses =
+          this_frame.num_efb_peek_prefetch_hits + this_frame.num_efb_peek_cache_misses)
+  {
+    draw_statistic("EFB prefetch hit ratio:", "%.1f%%",
+                   100.0 * this_frame.num_efb_peek_prefetch_hits / predictable_accesses);
+  }
+  draw_statistic("EFB peek stall time:", "%.3f ms", this_frame.efb_peek_stall_ms);
   draw_statistic("Draw dones:", "%d", this_frame.num_draw_done);
   draw_statistic("Tokens:", "%d/%d", this_frame.num_token, this_frame.num_token_int);
 
@@ -14,6 +14,7 @@ struct Statistics
   int num_pixel_shaders_alive = 0;
   int num_vertex_shaders_created = 0;
   int num_vertex_shaders_alive = 0;
+  int num_specialized_pipelines = 0;
 
   int num_textures_created = 0;
   int num_textures_uploaded = 0;
@@ -55,12 +56,16 @@ struct Statistics
 
     int num_primitive_joins = 0;
     int num_draw_calls = 0;
+    int num_draws_merged = 0;
+    int num_specialized_draws = 0;
 
     int num_dlists_called = 0;
 
     int bytes_vertex_streamed = 0;
     int bytes_index_streamed = 0;
     int bytes_uniform_streamed = 0;
+    int bytes_uniform_changed = 0;
+    int num_uniform_uploads_skipped = 0;
 
     int num_triangles_clipped = 0;
     int num_triangles_in = 0;
@@ -75,6 +80,12 @@ struct Statistics
 
     int num_efb_peeks = 0;
     int num_efb_pokes = 0;
+    int num_efb_copies_skipped = 0;
+    int num_efb_peek_cache_misses = 0;
+    int num_efb_peek_prefetches = 0;
+    int num_efb_peek_prefetch_hits = 0;
+    int num_efb_peek_prefetches_wasted = 0;
+    float efb_peek_stall_ms = 0;
 
     int num_draw_done = 0;
     int num_token = 0;
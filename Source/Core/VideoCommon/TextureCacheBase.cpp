@@ -16,6 +16,7 @@
 #endif
 
 #include <fmt/format.h>
+#include <xxhash.h>
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
@@ -1086,6 +1087,42 @@ void TextureCacheBase::BindTextures(BitSet32 used_textures,
   TMEM::FinalizeBinds(used_textures);
 }
 
+std::optional<u64>
+TextureCacheBase::GetBoundTexturesHash(BitSet32 used_textures,
+                                       const std::array<SamplerState, 8>& samplers) const
+{
+  XXH3_state_t state;
+  XXH3_INITSTATE(&state);
+  XXH3_64bits_reset(&state);
+
+  for (u32 i = 0; i < m_bound_textures.size(); i++)
+  {
+    const RcTcacheEntry& tentry = m_bound_textures[i];
+    if (!used_textures[i] || !tentry)
+      continue;
+
+    // The hash of an EFB copy only covers whatever is in RAM, which is not necessarily what the
+    // texture contains. Textures with EFB copies stitched into them have the same problem.
+    u64 content_hash;
+    if (tentry->IsCopy())
+      content_hash = tentry->efb_copy_signature;
+    else if (tentry->references.empty())
+      content_hash = tentry->hash;
+    else
+      return std::nullopt;
+    if (content_hash == 0)
+      return std::nullopt;
+
+    const std::array<u64, 4> texture_state = {
+        content_hash, (u64{i} << 32) | static_cast<u32>(tentry->format.texfmt),
+        (u64{tentry->native_width} << 32) | tentry->native_height,
+        (u64{samplers[i].tm0.hex} << 32) | samplers[i].tm1.hex};
+    XXH3_64bits_update(&state, texture_state.data(), sizeof(texture_state));
+  }
+
+  return XXH3_64bits_digest(&state);
+}
+
 class ArbitraryMipmapDetector
 {
 private:
@@ -2124,6 +2161,83 @@ bool TextureCacheBase::CopyFilterCanOverflow(const std::array<u32, 3>& coefficie
   return coefficients[0] + coefficients[1] + coefficients[2] >= 128;
 }
 
+u64 TextureCacheBase::GetEFBCopySignature(
+    EFBCopyFormat dst_format, u32 dst_stride, u32 width, u32 height, bool is_depth_copy,
+    const MathUtil::Rectangle<int>& src_rect, bool is_intensity, bool scale_by_half, float y_scale,
+    float gamma, bool clamp_top, bool clamp_bottom,
+    const CopyFilterCoefficients::Values& filter_coefficients)
+{
+  struct
+  {
+    u64 efb_content_hash;
+    s32 src_rect[4];
+    u32 dst_format;
+    u32 dst_stride;
+    u32 width;
+    u32 height;
+    u32 efb_format;
+    u32 efb_scale;
+    float y_scale;
+    float gamma;
+    u32 flags;
+    CopyFilterCoefficients::Values filter_coefficients;
+  } signature;
+  // Padding is hashed too.
+  std::memset(&signature, 0, sizeof(signature));
+
+  signature.efb_content_hash = g_framebuffer_manager->GetEFBContentHash();
+  signature.src_rect[0] = src_rect.left;
+  signature.src_rect[1] = src_rect.top;
+  signature.src_rect[2] = src_rect.right;
+  signature.src_rect[3] = src_rect.bottom;
+  signature.dst_format = static_cast<u32>(dst_format);
+  signature.dst_stride = dst_stride;
+  signature.width = width;
+  signature.height = height;
+  signature.efb_format = static_cast<u32>(bpmem.zcontrol.pixel_format.Value());
+  signature.efb_scale = g_framebuffer_manager->GetEFBScale();
+  signature.y_scale = y_scale;
+  signature.gamma = gamma;
+  signature.flags = (is_depth_copy ? 1 : 0) | (is_intensity ? 2 : 0) | (scale_by_half ? 4 : 0) |
+                    (clamp_top ? 8 : 0) | (clamp_bottom ? 16 : 0);
+  signature.filter_coefficients = filter_coefficients;
+
+  // 0 is reserved for copies without a signature.
+  return std::max<u64>(XXH3_64bits(&signature, sizeof(signature)), 1);
+}
+
+bool TextureCacheBase::IsEFBCopyUpToDate(u32 dst_addr, u32 covered_range, u32 dst_stride,
+                                         u32 width, u32 height, u32 scaled_width,
+                                         u32 scaled_height, TextureFormat format, u64 signature)
+{
+  const TCacheEntry* previous_copy = nullptr;
+  auto iter = FindOverlappingTextures(dst_addr, covered_range);
+  for (; iter.first != iter.second; ++iter.first)
+  {
+    const TCacheEntry* overlapping_entry = iter.first->second.get();
+    if (!overlapping_entry->OverlapsMemoryRange(dst_addr, covered_range))
+      continue;
+
+    // Anything else in the range would have been invalidated or marked as partially updated by
+    // the copy, so it has to go through the normal path.
+    if (previous_copy)
+      return false;
+    previous_copy = overlapping_entry;
+  }
+
+  if (!previous_copy || previous_copy->efb_copy_signature != signature ||
+      !previous_copy->is_efb_copy || previous_copy->addr != dst_addr ||
+      previous_copy->memory_stride != dst_stride || previous_copy->native_width != width ||
+      previous_copy->native_height != height || previous_copy->format.texfmt != format ||
+      previous_copy->GetWidth() != scaled_width || previous_copy->GetHeight() != scaled_height)
+  {
+    return false;
+  }
+
+  // The CPU may have written to the copy since it was made.
+  return previous_copy->CalculateHash() == previous_copy->hash;
+}
+
 void TextureCacheBase::CopyRenderTargetToTexture(
     u32 dstAddr, EFBCopyFormat dstFormat, u32 width, u32 height, u32 dstStride, bool is_depth_copy,
     const MathUtil::Rectangle<int>& srcRect, bool isIntensity, bool scaleByHalf, float y_scale,
@@ -2291,6 +2405,23 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     copy_to_vram = false;
   }
 
+  // If the EFB hasn't changed since the last time this exact copy was made, the texture and the
+  // data in RAM are still up to date, and the copy can be skipped.
+  u64 efb_copy_signature = 0;
+  if (!is_xfb_copy && copy_to_vram && g_ActiveConfig.bEFBCopyDeduplication &&
+      !g_ActiveConfig.bDumpEFBTarget && !OpcodeDecoder::g_record_fifo_data)
+  {
+    efb_copy_signature = GetEFBCopySignature(dstFormat, dstStride, tex_w, tex_h, is_depth_copy,
+                                             srcRect, isIntensity, scaleByHalf, y_scale, gamma,
+                                             clamp_top, clamp_bottom, filter_coefficients);
+    if (IsEFBCopyUpToDate(dstAddr, covered_range, dstStride, tex_w, tex_h, scaled_tex_w,
+                          scaled_tex_h, baseFormat, efb_copy_signature))
+    {
+      INCSTAT(g_stats.this_frame.num_efb_copies_skipped);
+      return;
+    }
+  }
+
   // We also linear filtering for both box filtering and downsampling higher resolutions to 1x.
   // TODO: This only produces perfect downsampling for 2x IR, other resolutions will need more
   //       complex down filtering to average all pixels and produce the correct result.
@@ -2322,6 +2453,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
       }
       entry->may_have_overlapping_textures = false;
       entry->is_custom_tex = false;
+      entry->efb_copy_signature = efb_copy_signature;
 
       CopyEFBToCacheEntry(entry, is_depth_copy, srcRect, scaleByHalf, linear_filter, dstFormat,
                           isIntensity, gamma, clamp_top, clamp_bottom,
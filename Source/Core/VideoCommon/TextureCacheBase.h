@@ -144,6 +144,10 @@ struct TCacheEntry
 
   bool reference_changed = false;  // used by xfb to determine when a reference xfb changed
 
+  // Identifies the EFB contents and copy parameters this EFB copy was made from, or 0 if unknown.
+  // Only tracked when EFB copy deduplication is enabled.
+  u64 efb_copy_signature = 0;
+
   // Texture dimensions from the GameCube's point of view
   u32 native_width = 0;
   u32 native_height = 0;
@@ -284,6 +288,12 @@ public:
                               MathUtil::Rectangle<int>* display_rect);
 
   virtual void BindTextures(BitSet32 used_textures, const std::array<SamplerState, 8>& samplers);
+
+  // Hashes the contents and sampler states of the bound textures, for EFB copy deduplication.
+  // Returns std::nullopt if the contents of a texture can't be identified by a hash.
+  std::optional<u64> GetBoundTexturesHash(BitSet32 used_textures,
+                                          const std::array<SamplerState, 8>& samplers) const;
+
   void CopyRenderTargetToTexture(u32 dstAddr, EFBCopyFormat dstFormat, u32 width, u32 height,
                                  u32 dstStride, bool is_depth_copy,
                                  const MathUtil::Rectangle<int>& srcRect, bool isIntensity,
@@ -386,6 +396,18 @@ private:
   void UninitializeEFBMemory(u8* dst, u32 stride, u32 bytes_per_row, u32 num_blocks_y);
   void UninitializeXFBMemory(u8* dst, u32 stride, u32 bytes_per_row, u32 num_blocks_y);
 
+  // Identifies the current EFB contents together with the parameters of an EFB copy.
+  static u64 GetEFBCopySignature(EFBCopyFormat dst_format, u32 dst_stride, u32 width, u32 height,
+                                 bool is_depth_copy, const MathUtil::Rectangle<int>& src_rect,
+                                 bool is_intensity, bool scale_by_half, float y_scale, float gamma,
+                                 bool clamp_top, bool clamp_bottom,
+                                 const CopyFilterCoefficients::Values& filter_coefficients);
+
+  // Returns true if the destination of an EFB copy already holds an unmodified copy with the
+  // given signature, and is not shared with any other texture.
+  bool IsEFBCopyUpToDate(u32 dst_addr, u32 covered_range, u32 dst_stride, u32 width, u32 height,
+                         u32 scaled_width, u32 scaled_height, TextureFormat format, u64 signature);
+
   // Precomputing the coefficients for the previous, current, and next lines for the copy filter.
   static std::array<u32, 3>
   GetRAMCopyFilterCoefficients(const CopyFilterCoefficients::Values& coefficients);
@@ -0,0 +1,69 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstring>
+
+#include "Common/CommonTypes.h"
+
+// A byte range within a uniform block.
+struct UniformRange
+{
+  u32 offset = 0;
+  u32 size = 0;
+
+  bool IsEmpty() const { return size == 0; }
+};
+
+// Remembers the contents of a uniform block as they were last uploaded, so that uploads of
+// unchanged blocks can be skipped, and backends that support it can upload only the part of a
+// block that changed.
+template <typename T>
+class UniformUploadTracker
+{
+public:
+  // Ranges are tracked in vec4 units, which is also the granularity D3D11 requires for partial
+  // constant buffer updates.
+  static constexpr u32 CHUNK_SIZE = 16;
+  static_assert(sizeof(T) % CHUNK_SIZE == 0, "Uniform blocks must be a multiple of a vec4");
+
+  // Reports the whole block as changed on the next update, e.g. because its binding was lost.
+  void Invalidate() { m_valid = false; }
+
+  // Returns the part of the block that differs from the last upload, and records the new contents
+  // as uploaded.
+  UniformRange Update(const T& data)
+  {
+    const u8* const new_data = reinterpret_cast<const u8*>(&data);
+    if (!m_valid)
+    {
+      std::memcpy(m_uploaded.data(), new_data, sizeof(T));
+      m_valid = true;
+      return {0, sizeof(T)};
+    }
+
+    u32 begin = 0;
+    while (begin < sizeof(T) && ChunkEquals(new_data, begin))
+      begin += CHUNK_SIZE;
+    if (begin == sizeof(T))
+      return {};
+
+    u32 end = sizeof(T);
+    while (ChunkEquals(new_data, end - CHUNK_SIZE))
+      end -= CHUNK_SIZE;
+
+    std::memcpy(m_uploaded.data() + begin, new_data + begin, end - begin);
+    return {begin, end - begin};
+  }
+
+private:
+  bool ChunkEquals(const u8* data, u32 offset) const
+  {
+    return std::memcmp(data + offset, m_uploaded.data() + offset, CHUNK_SIZE) == 0;
+  }
+
+  std::array<u8, sizeof(T)> m_uploaded{};
+  bool m_valid = false;
+};
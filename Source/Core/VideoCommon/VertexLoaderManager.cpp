@@ -4,6 +4,7 @@
 #include "VideoCommon/VertexLoaderManager.h"
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <mutex>
@@ -26,6 +27,7 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/NativeVertexFormat.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -445,7 +447,18 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
       DataReader dst = g_vertex_manager->PrepareForAdditionalData(primitive, run, stride,
                                                                   cullall || can_cpu_cull);
 
-      const int num_loaded = loader->RunVertices(src, dst.GetPointer(), run);
+      // Vertices which go straight to the stream buffer are loaded into CPU memory first if they
+      // have to be hashed. Those which are checked for culling are already in CPU memory.
+      const bool hash_vertices = g_ActiveConfig.bEFBCopyDeduplication && !cullall;
+      u8* const load_ptr = hash_vertices && !can_cpu_cull ?
+                               g_vertex_manager->GetVertexHashBuffer(run * stride) :
+                               dst.GetPointer();
+
+      int num_loaded;
+      {
+        StageTimers::ScopedStageTimer timer(StageTimers::Stage::VertexLoading);
+        num_loaded = loader->RunVertices(src, load_ptr, run);
+      }
       src += loader->m_vertex_size * max_vertices;
 
       if (can_cpu_cull && !cullall)
@@ -457,8 +470,15 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
           DataReader new_dst = g_vertex_manager->DisableCullAll(stride);
           memmove(new_dst.GetPointer(), dst.GetPointer(), num_loaded * stride);
           can_cpu_cull = false;
+          if (hash_vertices)
+            g_vertex_manager->AddVerticesToEFBContentHash(dst.GetPointer(), num_loaded * stride);
         }
       }
+      else if (load_ptr != dst.GetPointer())
+      {
+        std::memcpy(dst.GetPointer(), load_ptr, num_loaded * stride);
+        g_vertex_manager->AddVerticesToEFBContentHash(load_ptr, num_loaded * stride);
+      }
 
       g_vertex_manager->AddIndices(primitive, num_loaded);
       g_vertex_manager->FlushData(num_loaded, stride);
@@ -6,6 +6,9 @@
 #include <array>
 #include <cmath>
 #include <memory>
+#include <optional>
+
+#include <xxhash.h>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -34,6 +37,7 @@
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelShaderGen.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/StageTimers.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -137,6 +141,28 @@ u32 VertexManagerBase::GetRemainingSize() const
 void VertexManagerBase::AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices)
 {
   m_index_generator.AddIndices(primitive, num_vertices);
+
+  // The indices only depend on the primitives they were generated for, so there is no need to
+  // read them back for the EFB content hash.
+  if (g_ActiveConfig.bEFBCopyDeduplication)
+  {
+    const std::array<u32, 2> primitives = {static_cast<u32>(primitive), num_vertices};
+    m_batch_geometry_hash =
+        XXH3_64bits_withSeed(primitives.data(), sizeof(primitives), m_batch_geometry_hash);
+  }
+}
+
+u8* VertexManagerBase::GetVertexHashBuffer(u32 size)
+{
+  // The SSE vertex loader can write up to 4 bytes past the end
+  if (m_vertex_hash_buffer.size() < size + 4)
+    m_vertex_hash_buffer.resize(size + 4);
+  return m_vertex_hash_buffer.data();
+}
+
+void VertexManagerBase::AddVerticesToEFBContentHash(const u8* vertices, u32 size)
+{
+  m_batch_geometry_hash = XXH3_64bits_withSeed(vertices, size, m_batch_geometry_hash);
 }
 
 bool VertexManagerBase::AreAllVerticesCulled(VertexLoaderBase* loader,
@@ -194,6 +220,7 @@ DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive
     {
       ResetBuffer(stride);
     }
+    m_batch_geometry_hash = 0;
 
     remaining_index_generator_indices = m_index_generator.GetRemainingIndices(primitive);
     remaining_indices = GetRemainingIndices(primitive);
@@ -226,6 +253,7 @@ DataReader VertexManagerBase::DisableCullAll(u32 stride)
   {
     m_cull_all = false;
     ResetBuffer(stride);
+    m_batch_geometry_hash = 0;
   }
   return DataReader(m_cur_buffer_pointer, m_end_buffer_pointer);
 }
@@ -369,6 +397,42 @@ void VertexManagerBase::InvalidateConstants()
   vertex_shader_manager.dirty = true;
   geometry_shader_manager.dirty = true;
   pixel_shader_manager.dirty = true;
+  m_vertex_constants_tracker.Invalidate();
+  m_geometry_constants_tracker.Invalidate();
+  m_pixel_constants_tracker.Invalidate();
+}
+
+VertexManagerBase::ChangedUniforms VertexManagerBase::UpdateUniformTrackers()
+{
+  auto& system = Core::System::GetInstance();
+  auto& vertex_shader_manager = system.GetVertexShaderManager();
+  auto& geometry_shader_manager = system.GetGeometryShaderManager();
+  auto& pixel_shader_manager = system.GetPixelShaderManager();
+
+  // The managers set their dirty flag whenever a register that feeds a constant is written, even
+  // if the value ends up the same, so many "dirty" blocks are identical to what the GPU has.
+  const auto update = [](auto& tracker, bool& dirty, const auto& constants) -> UniformRange {
+    if (!dirty)
+      return {};
+
+    const UniformRange range = tracker.Update(constants);
+    if (range.IsEmpty())
+    {
+      dirty = false;
+      INCSTAT(g_stats.this_frame.num_uniform_uploads_skipped);
+    }
+    ADDSTAT(g_stats.this_frame.bytes_uniform_changed, range.size);
+    return range;
+  };
+
+  ChangedUniforms changed;
+  changed.vertex = update(m_vertex_constants_tracker, vertex_shader_manager.dirty,
+                          vertex_shader_manager.constants);
+  changed.geometry = update(m_geometry_constants_tracker, geometry_shader_manager.dirty,
+                            geometry_shader_manager.constants);
+  changed.pixel = update(m_pixel_constants_tracker, pixel_shader_manager.dirty,
+                         pixel_shader_manager.constants);
+  return changed;
 }
 
 void VertexManagerBase::UploadUtilityUniforms(const void* uniforms, u32 uniforms_size)
@@ -660,6 +724,17 @@ void VertexManagerBase::Flush()
         }
         RenderDrawCall(pixel_shader_manager, geometry_shader_manager, custom_pixel_shader_contents,
                        custom_pixel_shader_uniforms, m_current_primitive_type, pipeline_object);
+
+        if (g_ActiveConfig.bEFBCopyDeduplication)
+        {
+          // Custom shaders can read state that isn't part of the hash.
+          const std::optional<u64> textures_hash =
+              custom_pixel_shader_contents.shaders.empty() ?
+                  g_texture_cache->GetBoundTexturesHash(used_textures, samplers) :
+                  std::nullopt;
+          AddDrawToEFBContentHash(pixel_shader_manager, geometry_shader_manager,
+                                  vertex_shader_manager, textures_hash);
+        }
       }
     }
 
@@ -797,6 +872,8 @@ void VertexManagerBase::CalculateNormals(NativeVertexFormat* format)
 
 void VertexManagerBase::UpdatePipelineConfig()
 {
+  StageTimers::ScopedStageTimer timer(StageTimers::Stage::ShaderUIDGeneration);
+
   NativeVertexFormat* vertex_format = VertexLoaderManager::GetCurrentVertexFormat();
   if (vertex_format != m_current_pipeline_config.vertex_format)
   {
@@ -879,6 +956,7 @@ void VertexManagerBase::UpdatePipelineObject()
     return;
 
   m_current_pipeline_object = nullptr;
+  m_current_pipeline_is_uber = false;
   m_pipeline_config_changed = false;
 
   switch (g_ActiveConfig.iShaderCompilationMode)
@@ -895,6 +973,7 @@ void VertexManagerBase::UpdatePipelineObject()
     // Exclusive ubershader mode, always use ubershaders.
     m_current_pipeline_object =
         g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+    m_current_pipeline_is_uber = true;
   }
   break;
 
@@ -915,6 +994,7 @@ void VertexManagerBase::UpdatePipelineObject()
       // Specialized shaders not ready, use the ubershaders.
       m_current_pipeline_object =
           g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+      m_current_pipeline_is_uber = true;
     }
     else
     {
@@ -1071,6 +1151,18 @@ void VertexManagerBase::RenderDrawCall(
   pixel_shader_manager.custom_constants = custom_pixel_shader_uniforms;
   UploadUniforms();
 
+  // The constants are final now, so a variant of the pipeline with them folded in can be used.
+  if (g_ActiveConfig.bSpecializeHotShaders && current_pipeline == m_current_pipeline_object &&
+      !m_current_pipeline_is_uber)
+  {
+    if (const AbstractPipeline* specialized_pipeline = g_shader_cache->GetSpecializedPipeline(
+            m_current_pipeline_config, pixel_shader_manager.constants))
+    {
+      current_pipeline = specialized_pipeline;
+      INCSTAT(g_stats.this_frame.num_specialized_draws);
+    }
+  }
+
   g_gfx->SetPipeline(current_pipeline);
 
   u32 base_vertex, base_index;
@@ -1099,6 +1191,40 @@ void VertexManagerBase::RenderDrawCall(
     g_perf_query->DisableQuery(bpmem.zcontrol.early_ztest ? PQG_ZCOMP_ZCOMPLOC : PQG_ZCOMP);
 }
 
+void VertexManagerBase::AddDrawToEFBContentHash(
+    const PixelShaderManager& pixel_shader_manager,
+    const GeometryShaderManager& geometry_shader_manager,
+    const VertexShaderManager& vertex_shader_manager, std::optional<u64> textures_hash) const
+{
+  if (!textures_hash)
+  {
+    g_framebuffer_manager->InvalidateEFBContentHash();
+    return;
+  }
+
+  XXH3_state_t state;
+  XXH3_INITSTATE(&state);
+  XXH3_64bits_reset(&state);
+
+  const std::array<u32, 5> registers = {bpmem.scissorTL.hex, bpmem.scissorBR.hex,
+                                        bpmem.scissorOffset.hex, bpmem.zcontrol.hex,
+                                        static_cast<u32>(m_current_primitive_type)};
+  XXH3_64bits_update(&state, &*textures_hash, sizeof(u64));
+  XXH3_64bits_update(&state, registers.data(), sizeof(registers));
+  XXH3_64bits_update(&state, &xfmem.viewport, sizeof(xfmem.viewport));
+  XXH3_64bits_update(&state, &m_current_pipeline_config, sizeof(m_current_pipeline_config));
+  XXH3_64bits_update(&state, &vertex_shader_manager.constants,
+                     sizeof(vertex_shader_manager.constants));
+  XXH3_64bits_update(&state, &geometry_shader_manager.constants,
+                     sizeof(geometry_shader_manager.constants));
+  XXH3_64bits_update(&state, &pixel_shader_manager.constants,
+                     sizeof(pixel_shader_manager.constants));
+
+  XXH3_64bits_update(&state, &m_batch_geometry_hash, sizeof(m_batch_geometry_hash));
+
+  g_framebuffer_manager->AddDrawToEFBContentHash(XXH3_64bits_digest(&state));
+}
+
 const AbstractPipeline* VertexManagerBase::GetCustomPipeline(
     const CustomPixelShaderContents& custom_pixel_shader_contents,
     const VideoCommon::GXPipelineUid& current_pipeline_config,
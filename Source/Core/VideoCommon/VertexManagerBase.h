@@ -4,15 +4,18 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
 #include "VideoCommon/CPUCull.h"
+#include "VideoCommon/ConstantManager.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/RenderState.h"
 #include "VideoCommon/ShaderCache.h"
+#include "VideoCommon/UniformUploadTracker.h"
 #include "VideoCommon/VideoEvents.h"
 
 struct CustomPixelShaderContents;
@@ -22,6 +25,7 @@ class GeometryShaderManager;
 class NativeVertexFormat;
 class PixelShaderManager;
 class PointerWrap;
+class VertexShaderManager;
 struct PortableVertexDeclaration;
 
 struct Slope
@@ -118,6 +122,12 @@ public:
   DataReader DisableCullAll(u32 stride);
   void FlushData(u32 count, u32 stride);
 
+  // The vertices of a batch are part of the EFB content hash used by EFB copy deduplication.
+  // Reading them back from the stream buffer would be slow, and invalid once it has been unmapped,
+  // so they are loaded into this buffer in CPU memory first and copied over after being hashed.
+  u8* GetVertexHashBuffer(u32 size);
+  void AddVerticesToEFBContentHash(const u8* vertices, u32 size);
+
   void Flush();
   bool HasSendableVertices() const { return !m_is_flushed && !m_cull_all; }
 
@@ -172,8 +182,20 @@ public:
   void OnEndFrame();
 
 protected:
+  // The parts of each GX uniform block that changed since they were last uploaded.
+  struct ChangedUniforms
+  {
+    UniformRange vertex;
+    UniformRange geometry;
+    UniformRange pixel;
+  };
+
   // When utility uniforms are used, the GX uniforms need to be re-written afterwards.
-  static void InvalidateConstants();
+  void InvalidateConstants();
+
+  // Compares the dirty GX uniform blocks against what was last uploaded. Blocks whose contents did
+  // not actually change are marked clean, so backends only need to upload the remaining ones.
+  ChangedUniforms UpdateUniformTrackers();
 
   // Prepares the buffer for the next batch of vertices.
   virtual void ResetBuffer(u32 vertex_stride);
@@ -204,11 +226,16 @@ protected:
   std::vector<u8> m_cpu_vertex_buffer;
   std::vector<u16> m_cpu_index_buffer;
 
+  std::vector<u8> m_vertex_hash_buffer;
+  // Hash of the vertices and primitives added to the current batch
+  u64 m_batch_geometry_hash = 0;
+
   Slope m_zslope = {};
 
   VideoCommon::GXPipelineUid m_current_pipeline_config;
   VideoCommon::GXUberPipelineUid m_current_uber_pipeline_config;
   const AbstractPipeline* m_current_pipeline_object = nullptr;
+  bool m_current_pipeline_is_uber = false;
   PrimitiveType m_current_primitive_type = PrimitiveType::Points;
   bool m_pipeline_config_changed = true;
   bool m_rasterization_state_changed = true;
@@ -219,6 +246,10 @@ protected:
   IndexGenerator m_index_generator;
   CPUCull m_cpu_cull;
 
+  UniformUploadTracker<VertexShaderConstants> m_vertex_constants_tracker;
+  UniformUploadTracker<GeometryShaderConstants> m_geometry_constants_tracker;
+  UniformUploadTracker<PixelShaderConstants> m_pixel_constants_tracker;
+
 private:
   // Minimum number of draws per command buffer when attempting to preempt a readback operation.
   static constexpr u32 MINIMUM_DRAW_CALLS_PER_COMMAND_BUFFER_FOR_READBACK = 10;
@@ -230,6 +261,12 @@ private:
                       const AbstractPipeline* current_pipeline);
   void UpdatePipelineConfig();
   void UpdatePipelineObject();
+  // Folds everything that determines what the current draw writes to the EFB into the EFB
+  // content hash, for EFB copy deduplication.
+  void AddDrawToEFBContentHash(const PixelShaderManager& pixel_shader_manager,
+                               const GeometryShaderManager& geometry_shader_manager,
+                               const VertexShaderManager& vertex_shader_manager,
+                               std::optional<u64> textures_hash) const;
 
   const AbstractPipeline*
   GetCustomPipeline(const CustomPixelShaderContents& custom_pixel_shader_contents,
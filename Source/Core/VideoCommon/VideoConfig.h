@@ -208,6 +208,7 @@ struct VideoConfig final
   float widescreen_heuristic_widescreen_ratio = 0.f;
   bool bCrop = false;  // Aspect ratio controls.
   bool bShaderCache = false;
+  bool bSharedShaderCache = false;
 
   // Enhancements
   u32 iMultisamples = 0;
@@ -289,6 +290,7 @@ struct VideoConfig final
   bool bSkipXFBCopyToRam = false;
   bool bDisableCopyToVRAM = false;
   bool bDeferEFBCopies = false;
+  bool bEFBCopyDeduplication = false;
   bool bImmediateXFB = false;
   bool bSkipPresentingDuplicateXFBs = false;
   bool bCopyEFBScaled = false;
@@ -334,6 +336,7 @@ struct VideoConfig final
 
   // Shader compilation settings.
   bool bWaitForShadersBeforeStarting = false;
+  bool bSpecializeHotShaders = false;
   ShaderCompilationMode iShaderCompilationMode{};
 
   // Number of shader compiler threads.
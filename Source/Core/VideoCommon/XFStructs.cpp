@@ -16,18 +16,75 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/GeometryShaderManager.h"
+#include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/XFMemory.h"
 #include "VideoCommon/XFStateManager.h"
 
+static bool RangesOverlap(u32 start, u32 end, u32 other_start, u32 other_size)
+{
+  return start < other_start + other_size && other_start < end;
+}
+
+// Returns true if the vertices which are currently batched may read XF memory in [start, end).
+// Vertices without per-vertex matrix indices only use the matrices selected by the CP matrix
+// index registers, which are copied into dedicated constants when the batch is flushed. Writes to
+// any other matrix slot can therefore be merged into the current batch without splitting the draw.
+static bool IsXFRangeUsedByBatch(u32 start, u32 end)
+{
+  if (VertexLoaderManager::g_current_components & (VB_HAS_POSMTXIDX | VB_HAS_TEXMTXIDXALL))
+    return true;
+
+  // Post-transform matrices and lights are indexed by XF registers rather than the CP state, and
+  // the batch is conservatively assumed to use all of them.
+  if (end > XFMEM_NORMALMATRICES_END || RangesOverlap(start, end, XFMEM_POSMATRICES_END, 0x300))
+    return true;
+
+  const TMatrixIndexA& index_a = g_main_cp_state.matrix_index_a;
+  const TMatrixIndexB& index_b = g_main_cp_state.matrix_index_b;
+  if (RangesOverlap(start, end, index_a.PosNormalMtxIdx * 4, 12) ||
+      RangesOverlap(start, end, XFMEM_NORMALMATRICES + (index_a.PosNormalMtxIdx & 31) * 3, 9))
+  {
+    return true;
+  }
+
+  for (const u32 index : {index_a.Tex0MtxIdx.Value(), index_a.Tex1MtxIdx.Value(),
+                          index_a.Tex2MtxIdx.Value(), index_a.Tex3MtxIdx.Value(),
+                          index_b.Tex4MtxIdx.Value(), index_b.Tex5MtxIdx.Value(),
+                          index_b.Tex6MtxIdx.Value(), index_b.Tex7MtxIdx.Value()})
+  {
+    if (RangesOverlap(start, end, index * 4, 12))
+      return true;
+  }
+
+  return false;
+}
+
 static void XFMemWritten(XFStateManager& xf_state_manager, u32 transferSize, u32 baseAddress)
 {
-  g_vertex_manager->Flush();
+  if (IsXFRangeUsedByBatch(baseAddress, baseAddress + transferSize))
+    g_vertex_manager->Flush();
+  else if (g_vertex_manager->HasSendableVertices())
+    INCSTAT(g_stats.this_frame.num_draws_merged);
+
   xf_state_manager.InvalidateXFRange(baseAddress, baseAddress + transferSize);
 }
 
+// Writes which leave a register unchanged don't affect the batched vertices, so they shouldn't
+// split the draw either.
+static bool IsXFRegUnchanged(u32 address, u32 value)
+{
+  if (((u32*)&xfmem)[address] != value)
+    return false;
+
+  if (g_vertex_manager->HasSendableVertices())
+    INCSTAT(g_stats.this_frame.num_draws_merged);
+  return true;
+}
+
 static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager, u32 address,
                          u32 value)
 {
@@ -120,6 +177,8 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETVIEWPORT + 3:
     case XFMEM_SETVIEWPORT + 4:
     case XFMEM_SETVIEWPORT + 5:
+      if (IsXFRegUnchanged(address, value))
+        break;
       g_vertex_manager->Flush();
       xf_state_manager.SetViewportChanged();
       system.GetPixelShaderManager().SetViewportChanged();
@@ -133,6 +192,8 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETPROJECTION + 4:
     case XFMEM_SETPROJECTION + 5:
     case XFMEM_SETPROJECTION + 6:
+      if (IsXFRegUnchanged(address, value))
+        break;
       g_vertex_manager->Flush();
       xf_state_manager.SetProjectionChanged();
       system.GetGeometryShaderManager().SetProjectionChanged();
@@ -151,6 +212,8 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETTEXMTXINFO + 5:
     case XFMEM_SETTEXMTXINFO + 6:
     case XFMEM_SETTEXMTXINFO + 7:
+      if (IsXFRegUnchanged(address, value))
+        break;
       g_vertex_manager->Flush();
       xf_state_manager.SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
       break;
@@ -163,6 +226,8 @@ static void XFRegWritten(Core::System& system, XFStateManager& xf_state_manager,
     case XFMEM_SETPOSTMTXINFO + 5:
     case XFMEM_SETPOSTMTXINFO + 6:
     case XFMEM_SETPOSTMTXINFO + 7:
+      if (IsXFRegUnchanged(address, value))
+        break;
       g_vertex_manager->Flush();
       xf_state_manager.SetTexMatrixInfoChanged(address - XFMEM_SETPOSTMTXINFO);
       break;
@@ -232,12 +297,29 @@ void LoadXFReg(u16 base_address, u8 transfer_size, const u8* data)
       base_address = XFMEM_REGISTERS_START;
     }
 
-    XFMemWritten(xf_state_manager, xf_mem_transfer_size, xf_mem_base);
+    u32* current_data = reinterpret_cast<u32*>(&xfmem) + xf_mem_base;
+    bool changed = false;
     for (u32 i = 0; i < xf_mem_transfer_size; i++)
     {
-      ((u32*)&xfmem)[xf_mem_base + i] = Common::swap32(data);
-      data += 4;
+      if (current_data[i] != Common::swap32(data + i * sizeof(u32)))
+      {
+        changed = true;
+        break;
+      }
+    }
+
+    // Games frequently reload identical matrices between draws; skip the flush in that case.
+    if (changed)
+    {
+      XFMemWritten(xf_state_manager, xf_mem_transfer_size, xf_mem_base);
+      for (u32 i = 0; i < xf_mem_transfer_size; i++)
+        current_data[i] = Common::swap32(data + i * sizeof(u32));
+    }
+    else if (g_vertex_manager->HasSendableVertices())
+    {
+      INCSTAT(g_stats.this_frame.num_draws_merged);
     }
+    data += xf_mem_transfer_size * sizeof(u32);
   }
 
   // write to XF regs
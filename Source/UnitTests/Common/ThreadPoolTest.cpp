@@ -0,0 +1,129 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/Thread.h"
+#include "Common/ThreadPool.h"
+
+namespace
+{
+// Statistics of a task are recorded after it has finished, so they can lag behind
+// TaskGroup::Wait returning.
+Common::ThreadPool::Stats WaitForStats(const Common::ThreadPool& pool, u64 tasks_completed)
+{
+  Common::ThreadPool::Stats stats = pool.GetStats();
+  while (stats.tasks_completed < tasks_completed)
+  {
+    Common::YieldCPU();
+    stats = pool.GetStats();
+  }
+  return stats;
+}
+}  // namespace
+
+TEST(ThreadPool, RunsAllTasks)
+{
+  Common::ThreadPool pool("test pool", 4);
+  std::atomic<int> sum = 0;
+
+  {
+    Common::TaskGroup group(pool);
+    for (int i = 1; i <= 1000; ++i)
+      group.Run([&sum, i] { sum += i; });
+    group.Wait();
+    EXPECT_EQ(sum, 500500);
+  }
+
+  const Common::ThreadPool::Stats stats = WaitForStats(pool, 1000);
+  EXPECT_EQ(stats.tasks_completed, 1000u);
+  EXPECT_LE(stats.max_queue_latency, stats.total_queue_latency);
+}
+
+TEST(ThreadPool, TasksCanWaitForTasks)
+{
+  // Every worker waits for tasks that can only run once the waiting workers help out.
+  Common::ThreadPool pool("test pool", 2);
+  std::array<std::atomic<int>, 8> counts{};
+
+  Common::TaskGroup outer_group(pool);
+  for (std::atomic<int>& count : counts)
+  {
+    outer_group.Run([&pool, &count] {
+      Common::TaskGroup inner_group(pool);
+      for (int i = 0; i < 16; ++i)
+        inner_group.Run([&count] { ++count; });
+      inner_group.Wait();
+    });
+  }
+  outer_group.Wait();
+
+  for (const std::atomic<int>& count : counts)
+    EXPECT_EQ(count, 16);
+}
+
+TEST(ThreadPool, DestructorRunsQueuedTasks)
+{
+  std::atomic<int> count = 0;
+  {
+    Common::ThreadPool pool("test pool", 1);
+    for (int i = 0; i < 100; ++i)
+      pool.Submit([&count] { ++count; });
+  }
+  EXPECT_EQ(count, 100);
+}
+
+TEST(ThreadPool, ResetStats)
+{
+  Common::ThreadPool pool("test pool", 1);
+  {
+    Common::TaskGroup group(pool);
+    group.Run([] {});
+  }
+  EXPECT_EQ(WaitForStats(pool, 1).tasks_completed, 1u);
+
+  pool.ResetStats();
+  const Common::ThreadPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(stats.tasks_completed, 0u);
+  EXPECT_EQ(stats.total_run_time.count(), 0);
+}
+
+TEST(ThreadPool, TaskSequenceKeepsOrder)
+{
+  Common::ThreadPool pool("test pool", 4);
+  Common::TaskSequence sequence;
+  std::vector<int> order(1000);
+  size_t next = 0;
+  std::atomic<int> completed = 0;
+
+  {
+    // Like a pipeline that starts a new group for every step and retires the oldest one first.
+    std::deque<std::unique_ptr<Common::TaskGroup>> groups;
+    for (int i = 0; i < 1000; ++i)
+    {
+      groups.push_back(std::make_unique<Common::TaskGroup>(pool));
+      sequence.Run(*groups.back(), [&, i] {
+        order[next++] = i;
+        ++completed;
+      });
+
+      if (groups.size() > 4)
+      {
+        groups.front()->Wait();
+        groups.pop_front();
+        // Everything added with the retired groups has run by now.
+        EXPECT_GE(completed, i - 3);
+      }
+    }
+  }
+
+  ASSERT_EQ(completed, 1000);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(order[i], i);
+}
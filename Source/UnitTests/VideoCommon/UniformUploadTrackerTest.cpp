@@ -0,0 +1,62 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/UniformUploadTracker.h"
+
+namespace
+{
+struct Block
+{
+  std::array<u32, 16> values{};
+};
+}  // namespace
+
+TEST(UniformUploadTracker, FirstUpdateUploadsEverything)
+{
+  UniformUploadTracker<Block> tracker;
+  const UniformRange range = tracker.Update(Block{});
+  EXPECT_EQ(range.offset, 0u);
+  EXPECT_EQ(range.size, sizeof(Block));
+}
+
+TEST(UniformUploadTracker, UnchangedBlockIsEmpty)
+{
+  UniformUploadTracker<Block> tracker;
+  Block block;
+  block.values[5] = 1;
+  tracker.Update(block);
+  EXPECT_TRUE(tracker.Update(block).IsEmpty());
+}
+
+TEST(UniformUploadTracker, ChangedRangeCoversFirstAndLastChangedChunk)
+{
+  UniformUploadTracker<Block> tracker;
+  Block block;
+  tracker.Update(block);
+
+  // Chunks are 4 values wide, so these touch chunks 1 and 2.
+  block.values[5] = 1;
+  block.values[10] = 2;
+  UniformRange range = tracker.Update(block);
+  EXPECT_EQ(range.offset, 16u);
+  EXPECT_EQ(range.size, 32u);
+
+  block.values[15] = 3;
+  range = tracker.Update(block);
+  EXPECT_EQ(range.offset, 48u);
+  EXPECT_EQ(range.size, 16u);
+}
+
+TEST(UniformUploadTracker, InvalidateUploadsEverything)
+{
+  UniformUploadTracker<Block> tracker;
+  const Block block;
+  tracker.Update(block);
+  tracker.Invalidate();
+  EXPECT_EQ(tracker.Update(block).size, sizeof(Block));
+}